@@ -0,0 +1,23 @@
+-- Scena testowa planera RRT-Connect: pobieranie części z jednej strony
+-- sztalugi i odkładanie po drugiej. Sztaluga blokuje prostą drogę.
+-- Tryb bez okna (czasy planowania w sekcji "motionPlanning" raportu):
+--   robolab --headless --scene assets/scenes/bin_picking.scn --script assets/scripts/bin_picking.lua
+
+local picks = {{-1.9, 2.0, 1.9}, {-1.5, 2.0, 2.0}}
+local place = {-2.0, 2.0, -1.9}
+
+-- Planuje ruch i czeka na jego wykonanie
+local function moveTo(target)
+    local plan = planMotion(target)
+    if plan.success then
+        wait(plan.duration)
+    end
+    return plan.success
+end
+
+for cycle = 1, 3 do
+    for i, pick in ipairs(picks) do
+        moveTo(pick)
+        moveTo(place)
+    end
+end
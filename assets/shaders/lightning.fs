@@ -5,6 +5,7 @@ in vec3 fragPosition;
 in vec2 fragTexCoord;
 in vec4 fragColor;
 in vec3 fragNormal;
+in vec4 fragTint; // kolor instancji, (1,1,1,1) bez instancingu
 
 // Input uniform values
 uniform sampler2D texture0;
@@ -61,8 +62,9 @@ void main()
         }
     }
 
-finalColor = (texelColor*((colDiffuse + vec4(specular, 1.0))*vec4(lightDot, 1.0)));
-finalColor *= materialColor;  // Pomnóż przez kolor materiału
+vec4 diffuse = colDiffuse*fragTint;
+finalColor = (texelColor*((diffuse + vec4(specular, 1.0))*vec4(lightDot, 1.0)));
+finalColor *= materialColor*fragTint;  // Pomnóż przez kolor materiału
 finalColor += texelColor*(ambient/10.0);
 
     // Gamma correction
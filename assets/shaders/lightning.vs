@@ -1,30 +1,60 @@
 #version 330
 
+#define MAX_LINKS 32
+
 // Input vertex attributes
 in vec3 vertexPosition;
 in vec2 vertexTexCoord;
 in vec3 vertexNormal;
 in vec4 vertexColor;
+// Dane instancji (InstancedRenderer), używane gdy instancing == 1
+in mat4 instanceTransform;
+in vec4 instanceColor;
+// Indeks ogniwa robota (SkinnedModel), używany gdy skinning == 1
+in float vertexLink;
 
 // Input uniform values
 uniform mat4 mvp;
 uniform mat4 matModel;
 uniform vec4 colDiffuse;
+uniform int instancing;
+uniform int skinning;
+uniform vec4 linkMatrices[3*MAX_LINKS]; // trzy wiersze macierzy ogniwa
 
 // Output vertex attributes (to fragment shader)
 out vec3 fragPosition;
 out vec2 fragTexCoord;
 out vec4 fragColor;
 out vec3 fragNormal;
+out vec4 fragTint;
 
 void main()
 {
+    // Przy instancjach i skinningu mvp to widok*projekcja, a macierz modelu przychodzi z bufora instancji
+    // albo z macierzy ogniwa
+    mat4 model = matModel;
+    mat4 modelViewProjection = mvp;
+    fragTint = vec4(1.0);
+    if (instancing == 1)
+    {
+        model = instanceTransform;
+        modelViewProjection = mvp*instanceTransform;
+        fragTint = instanceColor;
+    }
+    else if (skinning == 1)
+    {
+        // Jedna kość na wierzchołek: macierz ogniwa złożona z wierszy
+        int link = 3*int(vertexLink + 0.5);
+        model = transpose(mat4(linkMatrices[link], linkMatrices[link + 1], linkMatrices[link + 2], vec4(0.0, 0.0, 0.0, 1.0)));
+        modelViewProjection = mvp*model;
+    }
+
     // Send vertex attributes to fragment shader
-    fragPosition = vec3(matModel*vec4(vertexPosition, 1.0));
+    fragPosition = vec3(model*vec4(vertexPosition, 1.0));
     fragTexCoord = vertexTexCoord;
     fragColor = vertexColor*colDiffuse;
-    fragNormal = normalize(vec3(matModel*vec4(vertexNormal, 0.0)));
+    fragNormal = normalize(vec3(model*vec4(vertexNormal, 0.0)));
 
     // Calculate final vertex position
-    gl_Position = mvp*vec4(vertexPosition, 1.0);
+    gl_Position = modelViewProjection*vec4(vertexPosition, 1.0);
 }
\ No newline at end of file
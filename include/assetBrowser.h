@@ -10,6 +10,7 @@
 #include <fstream>
 #include <iomanip>
 #include "modelConfig.h"
+#include "modelCache.h"
 #include <functional>
 
 using json = nlohmann::json;
@@ -18,7 +19,7 @@ namespace fs = std::filesystem;
 struct AssetItem {
     std::string name;
     std::string path;
-    Model model;
+    const ModelAsset *asset; // wspólny z obiektami sceny przez ModelCache
     RenderTexture2D thumbnail;
     ModelConfig config;
 };
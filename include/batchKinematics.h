@@ -0,0 +1,39 @@
+#pragma once
+#include "raylib.h"
+#include "raymath.h"
+#include <vector>
+
+struct ArmRotation;
+class RobotDescription;
+
+// Wsadowa kinematyka prosta dla wielu konfiguracji przegubów naraz.
+// Kąty w układzie SoA: angles[joint * stride + config], w stopniach.
+// Geometria (pivoty, osie) jest kopiowana przy tworzeniu - obiekt jest
+// niezależny od stanu RobotArm i można go używać z wielu wątków.
+class BatchKinematics
+{
+public:
+    BatchKinematics(const RobotDescription &description, const ArmRotation *meshRotations, float scale);
+
+    // Pozycje końcówki (w jednostkach świata) do outX/outY/outZ[config].
+    // linkFrames (opcjonalnie): count * meshCount macierzy w przestrzeni modelu,
+    // [config * meshCount + link], zgodnych z RobotKinematics::GetJointTransform.
+    void Evaluate(const float *angles, int stride, int count,
+                  float *outX, float *outY, float *outZ, Matrix *linkFrames = nullptr) const;
+    void EvaluateScalar(const float *angles, int stride, int count,
+                        float *outX, float *outY, float *outZ, Matrix *linkFrames = nullptr) const;
+
+    int GetMeshCount() const { return meshCount; }
+    static int GetLaneWidth();
+    static const char *GetInstructionSet();
+
+private:
+    template <typename Lanes>
+    void EvaluateLanes(const float *angles, int stride, int first,
+                       float *outX, float *outY, float *outZ, Matrix *linkFrames) const;
+
+    int meshCount;
+    float scale;
+    std::vector<Vector3> pivots; // meshCount + 1 (ostatni to punkt końcówki)
+    std::vector<Vector3> axes;   // znormalizowane osie w układzie lokalnym
+};
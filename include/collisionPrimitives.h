@@ -0,0 +1,115 @@
+#pragma once
+#include "raylib.h"
+#include "raymath.h"
+#include <cmath>
+
+// Testy odległości na prymitywach (Ericson, Real-Time Collision Detection, rozdz. 5)
+// wspólne dla BVH modeli i kapsuł ogniw robota.
+
+// Najbliższy punkt trójkąta (5.1.5)
+inline Vector3 ClosestPointOnTriangle(Vector3 p, Vector3 a, Vector3 b, Vector3 c)
+{
+    Vector3 ab = Vector3Subtract(b, a), ac = Vector3Subtract(c, a), ap = Vector3Subtract(p, a);
+    float d1 = Vector3DotProduct(ab, ap), d2 = Vector3DotProduct(ac, ap);
+    if (d1 <= 0.0f && d2 <= 0.0f)
+        return a;
+
+    Vector3 bp = Vector3Subtract(p, b);
+    float d3 = Vector3DotProduct(ab, bp), d4 = Vector3DotProduct(ac, bp);
+    if (d3 >= 0.0f && d4 <= d3)
+        return b;
+
+    float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+        return Vector3Add(a, Vector3Scale(ab, d1 / (d1 - d3)));
+
+    Vector3 cp = Vector3Subtract(p, c);
+    float d5 = Vector3DotProduct(ab, cp), d6 = Vector3DotProduct(ac, cp);
+    if (d6 >= 0.0f && d5 <= d6)
+        return c;
+
+    float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+        return Vector3Add(a, Vector3Scale(ac, d2 / (d2 - d6)));
+
+    float va = d3 * d6 - d5 * d4;
+    if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f)
+        return Vector3Add(b, Vector3Scale(Vector3Subtract(c, b), (d4 - d3) / ((d4 - d3) + (d5 - d6))));
+
+    float denom = 1.0f / (va + vb + vc);
+    return Vector3Add(a, Vector3Add(Vector3Scale(ab, vb * denom), Vector3Scale(ac, vc * denom)));
+}
+
+// Najbliższe punkty dwóch odcinków (5.1.9), zwraca kwadrat odległości.
+// Wersja bez rozgałęzień na przypadki brzegowe - ta sama co w kernelu SIMD kapsuł:
+// s z rozwiązania nieograniczonego, t najlepsze dla s, s ponownie najlepsze dla t.
+inline float ClosestPointsSegmentSegment(Vector3 p1, Vector3 q1, Vector3 p2, Vector3 q2, Vector3 &c1, Vector3 &c2)
+{
+    const float EPSILON = 1e-12f;
+    Vector3 d1 = Vector3Subtract(q1, p1), d2 = Vector3Subtract(q2, p2), r = Vector3Subtract(p1, p2);
+    float a = fmaxf(Vector3DotProduct(d1, d1), EPSILON);
+    float e = fmaxf(Vector3DotProduct(d2, d2), EPSILON);
+    float b = Vector3DotProduct(d1, d2), c = Vector3DotProduct(d1, r), f = Vector3DotProduct(d2, r);
+    float denom = fmaxf(a * e - b * b, EPSILON);
+
+    float s = Clamp((b * f - c * e) / denom, 0.0f, 1.0f);
+    float t = Clamp((b * s + f) / e, 0.0f, 1.0f);
+    s = Clamp((b * t - c) / a, 0.0f, 1.0f);
+
+    c1 = Vector3Add(p1, Vector3Scale(d1, s));
+    c2 = Vector3Add(p2, Vector3Scale(d2, t));
+    return Vector3DistanceSqr(c1, c2);
+}
+
+// Najbliższe punkty odcinka i trójkąta, zwraca kwadrat odległości (0 - odcinek przebija trójkąt)
+inline float ClosestPointsSegmentTriangle(Vector3 p, Vector3 q, Vector3 a, Vector3 b, Vector3 c,
+                                          Vector3 &onSegment, Vector3 &onTriangle)
+{
+    // Przebicie: Möller-Trumbore z parametrem ograniczonym do [0, 1]
+    Vector3 dir = Vector3Subtract(q, p);
+    Vector3 e1 = Vector3Subtract(b, a), e2 = Vector3Subtract(c, a);
+    Vector3 h = Vector3CrossProduct(dir, e2);
+    float det = Vector3DotProduct(e1, h);
+    if (fabsf(det) > 1e-12f)
+    {
+        float invDet = 1.0f / det;
+        Vector3 s = Vector3Subtract(p, a);
+        float u = Vector3DotProduct(s, h) * invDet;
+        Vector3 k = Vector3CrossProduct(s, e1);
+        float v = Vector3DotProduct(dir, k) * invDet;
+        float t = Vector3DotProduct(e2, k) * invDet;
+        if (u >= 0.0f && v >= 0.0f && u + v <= 1.0f && t >= 0.0f && t <= 1.0f)
+        {
+            onSegment = onTriangle = Vector3Add(p, Vector3Scale(dir, t));
+            return 0.0f;
+        }
+    }
+
+    // Bez przebicia minimum leży na krawędzi trójkąta albo w końcu odcinka
+    onSegment = p;
+    onTriangle = ClosestPointOnTriangle(p, a, b, c);
+    float best = Vector3DistanceSqr(onSegment, onTriangle);
+
+    Vector3 onQ = ClosestPointOnTriangle(q, a, b, c);
+    float distance = Vector3DistanceSqr(q, onQ);
+    if (distance < best)
+    {
+        best = distance;
+        onSegment = q;
+        onTriangle = onQ;
+    }
+
+    const Vector3 edges[3][2] = {{a, b}, {b, c}, {c, a}};
+    for (const auto &edge : edges)
+    {
+        Vector3 c1, c2;
+        distance = ClosestPointsSegmentSegment(p, q, edge[0], edge[1], c1, c2);
+        if (distance < best)
+        {
+            best = distance;
+            onSegment = c1;
+            onTriangle = c2;
+        }
+    }
+    return best;
+}
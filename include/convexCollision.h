@@ -0,0 +1,51 @@
+#pragma once
+#include "raylib.h"
+#include "raymath.h"
+#include <vector>
+
+// Kształt wypukły opisany funkcją podparcia. Kula i kapsuła to punkt/odcinek
+// (rdzeń) poszerzony o promień - GJK liczy odległość rdzeni, a EPA potrzebne
+// jest dopiero przy przenikaniu rdzeni. Prostopadłościan i otoczka wypukła
+// mają transformację afiniczną (dowolny obrót i skala) z układu lokalnego.
+struct ConvexShape
+{
+    enum class Type
+    {
+        SPHERE,
+        CAPSULE,
+        BOX,
+        HULL
+    };
+
+    Type type;
+    Vector3 a;          // SPHERE: środek, CAPSULE: pierwszy koniec, BOX: półwymiary
+    Vector3 b;          // CAPSULE: drugi koniec
+    float radius = 0.0f;
+    Matrix transform;   // BOX, HULL: lokalny -> świat
+    const std::vector<Vector3> *points = nullptr; // HULL: wierzchołki w układzie lokalnym
+
+    static ConvexShape Sphere(Vector3 center, float radius);
+    static ConvexShape Capsule(Vector3 a, Vector3 b, float radius);
+    static ConvexShape Box(Vector3 halfExtents, Matrix transform);
+    static ConvexShape Hull(const std::vector<Vector3> &points, Matrix transform);
+
+    // Najdalszy punkt w kierunku direction; withRadius = false - punkt rdzenia
+    Vector3 Support(Vector3 direction, bool withRadius) const;
+};
+
+struct ConvexContact
+{
+    bool intersecting = false;
+    float distance = 0.0f; // odstęp powierzchni; < 0 - głębokość przenikania
+    Vector3 pointA;        // punkty świadkowie na powierzchniach A i B
+    Vector3 pointB;
+    Vector3 normal;        // od A do B: przesunięcie B o -distance * normal rozdziela kształty
+    int iterations = 0;    // GJK + EPA
+};
+
+// GJK (odległość i punkty świadkowie), przy przenikaniu EPA (głębokość i normalna)
+ConvexContact ComputeConvexContact(const ConvexShape &shapeA, const ConvexShape &shapeB);
+
+// Wierzchołki otoczki wypukłej siatek modelu (quickhull) - punkty dla ConvexShape::Hull.
+// Dla siatki płaskiej lub zdegenerowanej - wszystkie unikalne wierzchołki.
+std::vector<Vector3> CollectHullPoints(const Mesh *meshes, int meshCount);
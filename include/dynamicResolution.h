@@ -0,0 +1,76 @@
+#pragma once
+#include "raylib.h"
+#include "imgui.h"
+#include <chrono>
+#include <vector>
+
+// Dynamiczna rozdzielczość widoku sceny. Scena rysowana jest do tekstury o rozmiarze
+// panelu Scene View przemnożonym przez skalę, a panel rozciąga ją wybranym filtrem.
+// Skala dobierana jest z wygładzonego czasu przejścia sceny (BeginScene - EndScene, bez
+// kroków symulacji i interfejsu, na które rozdzielczość nie wpływa): powyżej budżetu
+// maleje proporcjonalnie do liczby pikseli, przy zapasie rośnie o krok. Czas mierzony
+// jest na CPU - raylib nie udostępnia zapytań czasowych GL.
+// Tekstury pochodzą z puli - zmiana rozmiaru bierze wolną teksturę tego rozmiaru,
+// a nieużywane są zwalniane dopiero po POOL_KEEP_FRAMES klatkach. Mipmapy generowane
+// są tylko dla pomniejszanego obrazu (skala > 1) i tylko po narysowaniu nowej klatki.
+class DynamicResolution
+{
+public:
+    DynamicResolution(int width, int height);
+
+    // Rysowanie sceny: BeginTextureMode/EndTextureMode na bieżącej teksturze, z pomiarem czasu
+    void BeginScene();
+    void EndScene();
+    // W oknie Scene View: wybór rozmiaru na następną klatkę i obraz dopasowany do panelu
+    void Present(ImVec2 panelSize, TextureFilter filter);
+    // Przed EndDrawing: regulacja skali, sprzątanie puli
+    void EndFrame();
+    // Zwalnia wszystkie tekstury (przed CloseWindow)
+    void Unload();
+
+    float GetScale() const { return scale; }
+    void DrawImGuiControls();
+
+private:
+    struct PooledTarget
+    {
+        RenderTexture2D target = {0};
+        bool inUse = false;
+        long long lastUsedFrame = 0;
+    };
+
+    RenderTexture2D Acquire(int width, int height);
+    void Release(const RenderTexture2D &target);
+    void Trim();
+
+    std::vector<PooledTarget> pool;
+    RenderTexture2D current = {0}; // cel bieżącej klatki
+    int nextWidth = 0;             // rozmiar celu na następną klatkę
+    int nextHeight = 0;
+
+    // Stan tekstury wyświetlanej w panelu
+    long long contentVersion = 0; // rośnie z każdym EndScene
+    long long mipmapVersion = -1;
+    unsigned int filteredTexture = 0;
+    int appliedFilter = -1;
+
+    bool enabled = true;
+    float scale = 1.0f;
+    float minScale = 0.5f;
+    float maxScale = 1.0f;
+    float budgetMs = 8.0f; // połowa klatki przy 60 FPS
+    float smoothedMs = 0.0f;
+    float lastSceneMs = 0.0f;
+    int framesSinceChange = 0;
+    long long frame = 0;
+    int allocations = 0;
+    int poolHits = 0;
+    std::chrono::steady_clock::time_point sceneStart;
+
+    static constexpr float SCALE_STEP = 0.05f;
+    static constexpr float HEADROOM = 0.75f;  // skala rośnie poniżej tej części budżetu
+    static constexpr float SMOOTHING = 0.1f;  // waga nowej próbki w średniej wykładniczej
+    static constexpr int COOLDOWN_FRAMES = 20; // odstęp między zmianami skali
+    static constexpr int POOL_KEEP_FRAMES = 600;
+    static constexpr int MAX_POOL_SIZE = 6;
+};
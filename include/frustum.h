@@ -0,0 +1,21 @@
+#pragma once
+#include "raylib.h"
+#include "raymath.h"
+#include <vector>
+
+// Ostrosłup widzenia kamery: sześć płaszczyzn (normalna do środka, odległość)
+// wyciętych z macierzy widok*projekcja (Gribb, Hartmann). Domyślny obejmuje całą przestrzeń.
+struct Frustum
+{
+    Vector4 planes[6] = {{0.0f, 0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 0.0f, 1.0f},
+                         {0.0f, 0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 0.0f, 1.0f}};
+
+    // viewProjection = MatrixMultiply(view, projection), jak mvp w rlgl
+    static Frustum FromMatrix(Matrix viewProjection);
+
+    bool IntersectsSphere(Vector3 center, float radius) const;
+    // Kule w układzie SoA; visible - indeksy kul przecinających frustum, rosnąco.
+    // Pasy SIMD z simd.h, ogon skalarnie
+    void CullSpheres(const float *x, const float *y, const float *z, const float *radius, int count,
+                     std::vector<int> &visible) const;
+};
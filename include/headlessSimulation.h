@@ -0,0 +1,33 @@
+#pragma once
+#include <string>
+#include "simulationClock.h"
+
+struct HeadlessOptions
+{
+    std::string robotPath = "assets/robots/robot.glb";
+    std::string scenePath;             // plik .scn (opcjonalny)
+    std::string scriptPath;            // program Lua
+    std::string reportPath;            // pusty - raport JSON na stdout
+    float timeStep = 1.0f / SimulationClock::DEFAULT_RATE; // krok symulacji [s], jak w trybie okienkowym
+    float maxSimTime = 600.0f;         // limit czasu symulacji [s]
+    bool verbose = false;
+};
+
+// Symulacja bez okna i kontekstu GL: Lua, ruch robota, chwytanie i kolizje
+// liczone ze stałym wirtualnym krokiem tak szybko, jak pozwala procesor.
+//   robolab --headless --scene x.scn --script y.lua [--dt s] [--max-time s] [--report plik] [--verbose]
+class HeadlessSimulation
+{
+public:
+    static bool IsRequested(int argc, char **argv);
+    // false przy błędnych argumentach (opis trafia na stderr)
+    static bool ParseArguments(int argc, char **argv, HeadlessOptions &options);
+
+    explicit HeadlessSimulation(const HeadlessOptions &options) : options(options) {}
+
+    // Kod wyjścia procesu: 0 - program zakończony, 1 - błąd skryptu lub przekroczony limit, 2 - błędne wejście
+    int Run();
+
+private:
+    HeadlessOptions options;
+};
@@ -0,0 +1,49 @@
+#pragma once
+#include "raylib.h"
+#include "raymath.h"
+#include <cstdint>
+#include <vector>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+class RobotKinematics;
+
+// Baza punktów startowych dla iteracyjnego IK: próbki (pozycja i orientacja końcówki
+// -> kąty przegubów) z losowego FK, zorganizowane w niejawne drzewo k-d po pozycji.
+// Drzewo to same tablice w kolejności mediany, więc zapis/odczyt to kopia pamięci.
+class IKSeedDatabase
+{
+public:
+    // Wczytuje bazę z katalogu konfiguracji robota lub buduje ją i zapisuje,
+    // jeśli plik nie istnieje albo hash konfiguracji się nie zgadza
+    bool LoadOrBuild(const fs::path &configDir, const RobotKinematics &kinematics);
+    void Build(const RobotKinematics &kinematics, int sampleCount = 100000);
+    bool Load(const fs::path &path, uint64_t expectedHash);
+    bool Save(const fs::path &path) const;
+
+    // Najbliższa próbka do pozycji w przestrzeni modelu. Z orientacją (targetRotation != nullptr)
+    // spośród kilku najbliższych pozycyjnie wybiera tę o najmniejszym błędzie orientacji.
+    // positionWeight przelicza radiany błędu orientacji na jednostki modelu.
+    bool FindSeed(const Vector3 &modelPosition, const Matrix *targetRotation, float *outAngles,
+                  float positionWeight = 100.0f) const;
+
+    bool IsLoaded() const { return !positions.empty(); }
+    int GetSampleCount() const { return (int)positions.size(); }
+    uint64_t GetConfigHash() const { return configHash; }
+    float GetBuildTime() const { return buildTime; }
+
+private:
+    static constexpr int MAX_CANDIDATES = 16;
+
+    void BuildTree(int begin, int end, int depth, std::vector<int> &order);
+    void Search(int begin, int end, int depth, const Vector3 &point,
+                int *best, float *bestDistance, int &found, int maxFound) const;
+
+    uint64_t configHash = 0;
+    int jointCount = 0;
+    float buildTime = 0.0f;
+    std::vector<Vector3> positions;  // w kolejności drzewa k-d
+    std::vector<Quaternion> rotations;
+    std::vector<float> angles;       // [sample * jointCount + joint]
+};
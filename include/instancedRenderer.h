@@ -0,0 +1,91 @@
+#pragma once
+#include "raylib.h"
+#include "raymath.h"
+#include "renderQueue.h"
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+struct ModelAsset;
+
+// Rysowanie obiektów sceny instancjami: obiekty z tym samym modelem (ModelCache)
+// i shaderem tworzą grupę rysowaną jednym wywołaniem na siatkę (element
+// instancyjny RenderQueue). Macierz i kolor każdej instancji leżą w trwałym
+// buforze wierzchołków grupy; po zmianie obiektu przesyłany jest tylko zakres
+// zmienionych slotów. Przed zgłoszeniem instancje są testowane z frustum kamery
+// (kule otaczające w układzie SoA, test SIMD); gdy widać mniej niż
+// COMPACT_FRACTION grupy, widoczne instancje trafiają do osobnego bufora
+// strumieniowego, inaczej rysowany jest cały trwały bufor. Widoczne instancje dostają
+// poziom szczegółowości (ModelLod); przy kilku poziomach każdy ma własny bufor
+// strumieniowy i własne wywołania rysowania. Object3D rejestruje się sam
+// (jak w SceneBroadphase) i zgłasza zmiany transformacji i koloru.
+// Bez kontekstu GL (headless) prowadzona jest tylko księgowość po stronie CPU.
+class InstancedRenderer
+{
+public:
+    static InstancedRenderer &GetInstance()
+    {
+        static InstancedRenderer instance;
+        return instance;
+    }
+
+    // bounds - kula otaczająca w świecie: (środek, promień)
+    int CreateInstance(const ModelAsset *asset, Shader shader, Matrix transform, Color color, Vector4 bounds);
+    void DestroyInstance(int instanceId);
+    void UpdateInstance(int instanceId, Matrix transform, Color color, Vector4 bounds);
+
+    // Przesyła zmienione sloty i zgłasza grupy do RenderQueue (bez kontekstu GL nie wywoływać)
+    void Submit();
+
+    int GetGroupCount() const { return (int)groups.size(); }
+    int GetInstanceCount() const { return instanceCount; }
+    int GetUploadedBytes() const { return uploadedBytes; } // ostatnia klatka
+    int GetVisibleCount() const { return visibleCount; }   // ostatnia klatka
+
+private:
+    InstancedRenderer() = default;
+    InstancedRenderer(const InstancedRenderer &) = delete;
+    InstancedRenderer &operator=(const InstancedRenderer &) = delete;
+
+    struct Group
+    {
+        const ModelAsset *asset = nullptr;
+        Shader shader = {0};
+        std::vector<RenderInstance> data;
+        std::vector<int> owners; // slot -> instanceId
+        std::vector<float> boundsX, boundsY, boundsZ, boundsRadius; // kule slotów (SoA)
+        std::vector<uint8_t> lodLevel; // poziom z ostatniej klatki, w której slot był widoczny
+        unsigned int vboId = 0;
+        int capacity = 0;        // liczba instancji mieszczących się w VBO
+        int dirtyBegin = 0;      // zakres slotów do przesłania [dirtyBegin, dirtyEnd)
+        int dirtyEnd = 0;
+        unsigned int visibleVboId[ModelLod::MAX_LEVELS] = {0}; // widoczne instancje poziomu
+        int visibleCapacity[ModelLod::MAX_LEVELS] = {0};
+    };
+
+    struct Instance
+    {
+        Group *group = nullptr; // nullptr - wolny wpis, slot to następny wolny
+        int slot = -1;
+    };
+
+    void MarkDirty(Group &group, int slot);
+    void Upload(Group &group);
+    void UploadVisible(Group &group, int level, const std::vector<int> &slots);
+    void ReleaseBuffers(Group &group);
+
+    std::map<std::pair<const ModelAsset *, unsigned int>, Group> groups; // (model, shader.id)
+    std::vector<Instance> instances;
+    int freeInstance = -1;
+    int instanceCount = 0;
+    int uploadedBytes = 0;
+    int visibleCount = 0;
+    std::vector<int> visible;             // indeksy slotów widocznych w bieżącej grupie
+    std::vector<int> levelSlots[ModelLod::MAX_LEVELS]; // widoczne sloty według poziomu
+    std::vector<RenderInstance> visibleData;
+
+    static constexpr int MIN_CAPACITY = 64;
+    static constexpr float COMPACT_FRACTION = 0.75f;
+    static constexpr uint8_t NO_LEVEL = 0xFF;
+};
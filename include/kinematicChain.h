@@ -0,0 +1,89 @@
+#pragma once
+#include "robotKinematics.h"
+#include <utility>
+
+// Łańcuch kinematyczny specjalizowany w czasie kompilacji. Osie przegubów są
+// znacznikami constexpr, więc obrót wokół X/Y/Z to aktualizacja dwóch kolumn
+// macierzy obrotu (2x2 sin/cos) zamiast ogólnego MatrixRotate, a pętla po
+// przegubach jest w pełni rozwinięta przez kompilator.
+enum class ChainAxis
+{
+    X,
+    Y,
+    Z
+};
+
+template <int N, ChainAxis... Axes>
+struct KinematicChain
+{
+    static_assert(sizeof...(Axes) == N, "Liczba osi musi być równa długości łańcucha");
+    static constexpr ChainAxis AXES[N] = {Axes...};
+
+    // Przelicza ramki przegubów first..N-1 (w przestrzeni modelu, zgodne z
+    // RobotKinematics::GetJointTransform). Dla first > 0 frames[first - 1] musi być aktualna.
+    static void Forward(const JointDesc *joints, const ArmRotation *rotations, int first, Matrix *frames)
+    {
+        float r[9] = {1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f};
+        float t[3] = {0.0f, 0.0f, 0.0f};
+        if (first > 0)
+        {
+            const Matrix &m = frames[first - 1];
+            r[0] = m.m0; r[1] = m.m4; r[2] = m.m8; t[0] = m.m12;
+            r[3] = m.m1; r[4] = m.m5; r[5] = m.m9; t[1] = m.m13;
+            r[6] = m.m2; r[7] = m.m6; r[8] = m.m10; t[2] = m.m14;
+        }
+        Unroll(joints, rotations, first, frames, r, t, std::make_integer_sequence<int, N>{});
+    }
+
+private:
+    template <int... I>
+    static void Unroll(const JointDesc *joints, const ArmRotation *rotations, int first, Matrix *frames,
+                       float *r, float *t, std::integer_sequence<int, I...>)
+    {
+        (Step<I>(joints, rotations, first, frames, r, t), ...);
+    }
+
+    // Prawa strona R * Ra dla obrotu wokół osi lokalnej zmienia tylko dwie kolumny R
+    template <ChainAxis A>
+    static void RotateColumns(float *r, float s, float c)
+    {
+        constexpr int a = (A == ChainAxis::X) ? 1 : (A == ChainAxis::Y ? 2 : 0);
+        constexpr int b = (A == ChainAxis::X) ? 2 : (A == ChainAxis::Y ? 0 : 1);
+        for (int row = 0; row < 3; row++)
+        {
+            float ca = r[row * 3 + a];
+            float cb = r[row * 3 + b];
+            r[row * 3 + a] = ca * c + cb * s;
+            r[row * 3 + b] = cb * c - ca * s;
+        }
+    }
+
+    template <int I>
+    static void Step(const JointDesc *joints, const ArmRotation *rotations, int first, Matrix *frames,
+                     float *r, float *t)
+    {
+        if (I < first)
+            return;
+
+        // Obrót wokół pivota: t_i = t_{i-1} + R_{i-1} p - R_i p
+        const Vector3 p = joints[I].pivot;
+        for (int row = 0; row < 3; row++)
+            t[row] += r[row * 3] * p.x + r[row * 3 + 1] * p.y + r[row * 3 + 2] * p.z;
+
+        const float angle = rotations[I].angle * DEG2RAD;
+        RotateColumns<AXES[I]>(r, sinf(angle), cosf(angle));
+
+        for (int row = 0; row < 3; row++)
+            t[row] -= r[row * 3] * p.x + r[row * 3 + 1] * p.y + r[row * 3 + 2] * p.z;
+
+        Matrix &m = frames[I];
+        m.m0 = r[0]; m.m4 = r[1]; m.m8 = r[2]; m.m12 = t[0];
+        m.m1 = r[3]; m.m5 = r[4]; m.m9 = r[5]; m.m13 = t[1];
+        m.m2 = r[6]; m.m6 = r[7]; m.m10 = r[8]; m.m14 = t[2];
+        m.m3 = 0.0f; m.m7 = 0.0f; m.m11 = 0.0f; m.m15 = 1.0f;
+    }
+};
+
+// Wybiera specjalizację pasującą do osi przegubów robota (osie muszą być
+// dodatnimi osiami układu). nullptr oznacza powrót do ogólnej ścieżki.
+const KinematicChainSpec *SelectKinematicChain(const ArmRotation *rotations, int meshCount);
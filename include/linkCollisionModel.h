@@ -0,0 +1,84 @@
+#pragma once
+#include "raylib.h"
+#include "raymath.h"
+#include <vector>
+
+class Object3D;
+
+// Kapsuła: odcinek a-b poszerzony o promień
+struct Capsule
+{
+    Vector3 a;
+    Vector3 b;
+    float radius;
+    int link; // indeks ogniwa (siatki) robota
+};
+
+enum class LinkContactType
+{
+    SELF,  // dwa ogniwa tego samego robota
+    ROBOT, // ogniwo innego robota
+    SCENE  // obiekt sceny (BVH modelu)
+};
+
+struct LinkContact
+{
+    LinkContactType type;
+    int link;
+    int otherLink;                    // -1 dla obiektu sceny
+    const Object3D *object = nullptr; // tylko SCENE
+    float distance;                   // odległość powierzchni, < 0 - przenikanie
+    Vector3 point;                    // najbliższy punkt na ogniwie
+    Vector3 otherPoint;
+};
+
+// Model kolizji ogniw robota złożony z kapsuł dopasowanych do siatek przy
+// wczytaniu (PCA wierzchołków, do dwóch kapsuł na ogniwo). Kapsuły leżą w
+// przestrzeni modelu i są ustawiane co krok z ramek FK; odległości par
+// kapsuła-kapsuła liczone są wsadowo w pasach SIMD (simd.h), kapsuła-scena
+// przez SceneBroadphase i BVH obiektu.
+class LinkCollisionModel
+{
+public:
+    void Fit(const Mesh *meshes, int meshCount);
+    // Ramki jak RobotKinematics::GetJointTransform (przestrzeń modelu), skala robota
+    void UpdatePose(const Matrix *jointTransforms, float scale);
+    // Pary do testu własnego: ogniwa niesąsiadujące, rozłączne w bieżącej pozie.
+    // Wołane w pozycji zerowej - pary stykające się w niej są wyłączane.
+    void BuildSelfPairs();
+
+    // Kontakty bliższe niż margin dopisywane do out, jeden wpis (minimum) na parę ogniw lub ogniwo-obiekt
+    void CheckSelf(float margin, std::vector<LinkContact> &out);
+    void CheckRobot(const LinkCollisionModel &other, float margin, std::vector<LinkContact> &out);
+    // attached - obiekt trzymany przez attachedLink (chwytak), pomijany dla tego ogniwa;
+    // attachedLink = -1 pomija go dla wszystkich ogniw
+    void CheckScene(float margin, const Object3D *attached, int attachedLink, std::vector<LinkContact> &out) const;
+    // Test tak/nie dla planera: czy któraś kapsuła jest bliżej sceny niż margin (bez szukania minimum)
+    bool IntersectsScene(float margin, const Object3D *attached, int attachedLink) const;
+
+    void Draw(const std::vector<LinkContact> &contacts) const;
+
+    const std::vector<Capsule> &GetCapsules() const { return worldCapsules; }
+    // Kapsuły w przestrzeni modelu (poza zerowa, bez skali)
+    const std::vector<Capsule> &GetLocalCapsules() const { return localCapsules; }
+    int GetSelfPairCount() const { return (int)selfPairs.size(); }
+    void SetUseSimd(bool enabled) { useSimd = enabled; }
+
+private:
+    void PackPair(int slot, int stride, const Capsule &first, const Capsule &second);
+    void EvaluatePairs(int count, int stride);
+    static void AddContact(std::vector<LinkContact> &out, const LinkContact &contact);
+    static LinkContact MakeContact(LinkContactType type, const Capsule &first, const Capsule &second);
+
+    std::vector<Capsule> localCapsules;
+    std::vector<Capsule> worldCapsules;
+    std::vector<std::pair<int, int>> selfPairs; // indeksy kapsuł
+    bool useSimd = true;
+
+    // Bufor par w układzie SoA: [składowa * stride + para], 13 składowych
+    std::vector<float> pairBuffer;
+    std::vector<float> pairDistances;
+
+    static constexpr int MAX_CAPSULES_PER_LINK = 2;
+    static constexpr float SPLIT_GAIN = 0.7f; // podział, gdy dwie kapsuły mają < 70% objętości jednej
+};
@@ -25,10 +25,14 @@ public:
     void Draw(const char* title, const ImVec2& position, const ImVec2& size);
     void AddLog(const char* message, LogLevel level = LogLevel::Info);
     void Clear();
+    // Kopia komunikatów na stderr (tryb headless); min - najniższy wypisywany poziom
+    void SetConsoleEcho(bool enabled, LogLevel min = LogLevel::Warning);
 
 private:
     std::vector<LogMessage> logs;
     bool autoScroll;
+    bool consoleEcho = false;
+    LogLevel consoleLevel = LogLevel::Warning;
     ImGuiTextFilter filter;
     
     ImVec4 GetColorForLevel(LogLevel level) const;
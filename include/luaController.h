@@ -13,10 +13,15 @@ private:
     int currentLine;
     float waitTime;                        // Czas oczekiwania dla wait()
     float executeTimer;                    // Timer dla ciągłego wykonywania
+    std::string lastError;                 // Ostatni błąd ładowania lub wykonania skryptu
     const float EXECUTION_INTERVAL = 0.0f; // Interwał między krokami
     void RegisterFunctions();
     static int lua_setJointRotation(lua_State *L);
     static int lua_wait(lua_State *L);
+    static int lua_solveIKMany(lua_State *L);
+    static int lua_planMotion(lua_State *L);
+    static int lua_grip(lua_State *L);
+    static int lua_release(lua_State *L);
     static int last_joint;
     static float last_angle;
     static float last_wait;
@@ -25,12 +30,13 @@ public:
     LuaController(RobotArm &robot, LogWindow &log);
     ~LuaController();
 
-    void LoadScript(const std::string &code);
+    bool LoadScript(const std::string &code);
     void Step();
     void Run();
     void Stop();
     void SetStepMode(bool enabled);
     int GetCurrentLine() const { return currentLine; }
     bool IsRunning() const { return isRunning; }
+    const std::string &GetLastError() const { return lastError; }
     void Update(float deltaTime);
 };
\ No newline at end of file
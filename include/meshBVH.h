@@ -0,0 +1,53 @@
+#pragma once
+#include "raylib.h"
+#include "raymath.h"
+#include <vector>
+
+// Hierarchia brył otaczających (BVH) nad trójkątami wszystkich siatek modelu,
+// budowana raz po wczytaniu metodą SAH z kubełkowaniem centroidów. Zapytania
+// działają w przestrzeni lokalnej modelu - transformację obiektu nakłada
+// wywołujący (Object3D).
+class MeshBVH
+{
+public:
+    void Build(const Mesh *meshes, int meshCount);
+
+    bool IsEmpty() const { return nodes.empty(); }
+    BoundingBox GetBounds() const;
+    int GetTriangleCount() const { return (int)triangles.size(); }
+    int GetNodeCount() const { return (int)nodes.size(); }
+    float GetBuildTime() const { return buildTime; }
+
+    // Najbliższe trafienie promienia (direction znormalizowany lub nie - distance w jego jednostkach)
+    RayCollision Raycast(Vector3 origin, Vector3 direction, float maxDistance) const;
+    // Czy kula przecina powierzchnię dowolnego trójkąta
+    bool IntersectsSphere(Vector3 center, float radius) const;
+    // Odległość odcinka od powierzchni (0 - przebicie), maxDistance gdy nic nie jest bliżej.
+    // closestPoint - najbliższy punkt siatki, ustawiany tylko przy wyniku < maxDistance
+    float SegmentDistance(Vector3 a, Vector3 b, float maxDistance, Vector3 *closestPoint = nullptr) const;
+    // Czy odcinek jest bliżej niż distance od powierzchni - kończy na pierwszym takim trójkącie
+    bool SegmentWithin(Vector3 a, Vector3 b, float distance) const;
+
+private:
+    struct Triangle
+    {
+        Vector3 a, b, c;
+    };
+
+    // 32 bajty: liść ma count > 0 i first = pierwszy trójkąt, węzeł wewnętrzny - indeks lewego dziecka
+    struct Node
+    {
+        Vector3 min;
+        int first;
+        Vector3 max;
+        int count;
+    };
+
+    std::vector<Triangle> triangles;
+    std::vector<Node> nodes;
+    float buildTime = 0.0f;
+
+    static constexpr int BIN_COUNT = 16;
+    static constexpr int MAX_LEAF_SIZE = 8;
+    static constexpr int STACK_SIZE = 64;
+};
@@ -0,0 +1,19 @@
+#pragma once
+#include "raylib.h"
+#include "raymath.h"
+
+// Upraszczanie siatek metodą kolapsu krawędzi z metryką kwadryk (Garland, Heckbert 1997)
+// w wariancie z rosnącym progiem błędu zamiast kolejki priorytetowej. Wierzchołki są
+// najpierw sklejane po pozycji (eksporty CAD dzielą je na krawędziach i szwach UV),
+// a normalne po uproszczeniu liczone ponownie z progiem kąta, więc ostre krawędzie
+// zostają ostre. Wynik ma tylko pozycje, normalne i indeksy (dane CPU, MemAlloc).
+struct SimplifyResult
+{
+    Mesh mesh = {0};
+    int sourceTriangles = 0;
+    float maxError = 0.0f; // największy błąd kwadryki zaakceptowanego kolapsu
+};
+
+// targetRatio - docelowy ułamek trójkątów (0..1]; minTriangles - dolna granica
+bool SimplifyMesh(const Mesh &source, float targetRatio, int minTriangles, SimplifyResult &result);
+void FreeSimplifiedMesh(Mesh &mesh);
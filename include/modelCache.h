@@ -0,0 +1,73 @@
+#pragma once
+#include "raylib.h"
+#include "meshBVH.h"
+#include "modelLod.h"
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Wspólne dane siatki jednego pliku modelu: geometria (bufory GPU lub tylko CPU
+// w trybie headless) oraz struktury kolizji. Tylko do odczytu - materiał i
+// transformacja należą do instancji (Object3D, RobotArm, miniatura w AssetBrowser).
+struct ModelAsset
+{
+    Model model = {0};
+    MeshBVH bvh;                     // budowane przy pierwszym żądaniu kolizji
+    std::vector<Vector3> hullPoints; // wierzchołki otoczki wypukłej w układzie lokalnym
+    bool hasCollision = false;
+    ModelLod lod;                    // budowane przy pierwszym żądaniu, nie w trybie headless
+    bool hasLod = false;
+
+    std::string path; // plik, z którego wczytano model po raz pierwszy
+    uint64_t hash = 0;
+    int references = 0;
+    float loadTime = 0.0f; // [s] wczytanie + budowa BVH
+};
+
+// Pamięć podręczna modeli z licznikiem referencji, kluczowana skrótem zawartości
+// pliku (FNV-1a), więc kopie tego samego pliku pod różnymi ścieżkami też dzielą
+// siatkę. Skrót ścieżki jest pamiętany razem z rozmiarem i czasem modyfikacji -
+// plik czytany jest ponownie tylko po zmianie. Model zwalniany jest przy ostatnim Release.
+class ModelCache
+{
+public:
+    static ModelCache &GetInstance()
+    {
+        static ModelCache instance;
+        return instance;
+    }
+
+    // collision - zbuduj BVH i punkty otoczki, lod - poziomy szczegółowości (raz na plik)
+    const ModelAsset *Acquire(const char *path, bool collision = false, bool lod = false);
+    void Release(const ModelAsset *asset);
+
+    int GetAssetCount() const { return (int)assets.size(); }
+    int GetReferenceCount() const;
+    int GetHitCount() const { return hits; }
+    int GetMissCount() const { return misses; }
+    float GetTotalLoadTime() const { return totalLoadTime; }
+    void DrawImGuiControls();
+
+private:
+    ModelCache() = default;
+    ModelCache(const ModelCache &) = delete;
+    ModelCache &operator=(const ModelCache &) = delete;
+
+    struct FileStamp
+    {
+        uint64_t hash = 0;
+        uintmax_t size = 0;
+        std::filesystem::file_time_type modified;
+    };
+
+    uint64_t HashFile(const std::string &path);
+
+    std::unordered_map<uint64_t, std::unique_ptr<ModelAsset>> assets;
+    std::unordered_map<std::string, FileStamp> stamps; // ścieżka kanoniczna -> skrót
+    int hits = 0;
+    int misses = 0;
+    float totalLoadTime = 0.0f;
+};
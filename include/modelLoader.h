@@ -0,0 +1,23 @@
+#pragma once
+#include "raylib.h"
+#include "raymath.h"
+
+// Wczytywanie modeli zależne od trybu pracy. W trybie okienkowym to zwykłe
+// LoadModel z raylib; w trybie headless (bez okna i kontekstu GL) siatki z
+// plików .glb trafiają tylko do pamięci CPU - wystarczają do kolizji i
+// raycastów, ale nie da się ich narysować.
+class ModelLoader
+{
+public:
+    static void SetHeadless(bool enabled) { headless = enabled; }
+    static bool IsHeadless() { return headless; }
+
+    static Model Load(const char *path);
+    static void Unload(Model &model);
+
+private:
+    // Pozycje, normalne i indeksy z binarnego glTF, transformacje węzłów wpieczone w wierzchołki
+    static Model LoadGLBGeometry(const char *path);
+
+    static bool headless;
+};
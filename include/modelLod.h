@@ -0,0 +1,53 @@
+#pragma once
+#include "raylib.h"
+#include "raymath.h"
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// Poziomy szczegółowości modelu: poziom 0 to siatki z pliku, kolejne powstają
+// przez upraszczanie (meshSimplifier.h) do ułamków LEVEL_RATIOS trójkątów. Poziom
+// jest zachowywany tylko, gdy realnie zmniejsza liczbę trójkątów, a siatka, której
+// nie dało się uprościć, używa poprzedniego poziomu. Wynik trafia do katalogu
+// konfiguracji modelu (.<nazwa>/lod.bin) razem ze skrótem pliku źródłowego.
+class ModelLod
+{
+public:
+    static constexpr int MAX_LEVELS = 4;
+    static constexpr float LEVEL_RATIOS[MAX_LEVELS] = {1.0f, 0.5f, 0.2f, 0.06f};
+    // Wielkość na ekranie (średnica kuli / wysokość widoku), poniżej której wybierany jest poziom i+1
+    static constexpr float SCREEN_THRESHOLDS[MAX_LEVELS - 1] = {0.25f, 0.1f, 0.04f};
+    static constexpr float HYSTERESIS = 0.2f; // względna szerokość pasa bez zmiany poziomu
+
+    // Wczytuje poziomy z katalogu konfiguracji modelu lub buduje je i zapisuje,
+    // jeśli plik nie istnieje albo skrót modelu się nie zgadza
+    bool LoadOrBuild(const fs::path &configDir, const Model &model, uint64_t sourceHash);
+    void Build(const Model &model, uint64_t sourceHash);
+    bool Load(const fs::path &path, const Model &model, uint64_t expectedHash);
+    bool Save(const fs::path &path) const;
+    // Bufory GPU uproszczonych siatek (tylko z kontekstem GL)
+    void Upload();
+    void Unload();
+
+    int GetLevelCount() const { return levelCount; }
+    int GetTriangleCount(int level) const { return level < (int)triangleCounts.size() ? triangleCounts[level] : 0; }
+    float GetBuildTime() const { return buildTime; }
+    // Siatka meshIndex na danym poziomie; poziom 0 i siatki bez uproszczenia - z modelu
+    const Mesh &GetMesh(const Model &model, int level, int meshIndex) const;
+
+    // Poziom dla wielkości na ekranie. current - poziom z poprzedniej klatki (-1 - brak);
+    // zmiana następuje dopiero po wyjściu poza pas HYSTERESIS wokół progu, więc
+    // obiekt na granicy nie przełącza się co klatkę
+    static int SelectLevel(float screenSize, int current, int levelCount);
+
+private:
+    uint64_t sourceHash = 0;
+    int meshCount = 0;
+    int levelCount = 1;
+    float buildTime = 0.0f;
+    bool uploaded = false;
+    std::vector<std::vector<Mesh>> levels; // poziomy 1.. ; vertexCount == 0 - poziom niżej
+    std::vector<int> triangleCounts;       // suma trójkątów na poziom, razem z poziomem 0
+};
@@ -0,0 +1,108 @@
+#pragma once
+#include "linkCollisionModel.h"
+#include "robotKinematics.h"
+#include <chrono>
+#include <random>
+#include <vector>
+
+struct MotionPlannerSettings
+{
+    float stepSize = 15.0f;      // [deg] maks. zmiana przegubu przy rozszerzaniu drzewa
+    float edgeResolution = 2.0f; // [deg] odstęp sprawdzanych stanów na krawędzi
+    float clearance = 0.01f;     // [jednostki świata] minimalny odstęp ogniw od przeszkód
+    float timeLimit = 0.5f;      // [s]
+    int shortcutIterations = 64;
+    unsigned seed = 1;
+};
+
+enum class MotionPlanStatus
+{
+    SUCCESS,
+    START_IN_COLLISION,
+    GOAL_IN_COLLISION,
+    TIMEOUT
+};
+
+struct MotionPlan
+{
+    MotionPlanStatus status = MotionPlanStatus::TIMEOUT;
+    std::vector<float> waypoints; // [waypoint * jointCount + joint], zagęszczone co stepSize / 3
+    int segments = 0;             // odcinki ścieżki po skracaniu
+    int iterations = 0;
+    int treeNodes = 0;
+    int stateChecks = 0;
+    float planningMs = 0.0f;
+
+    bool Succeeded() const { return status == MotionPlanStatus::SUCCESS; }
+};
+
+// Planer RRT-Connect w przestrzeni przegubów z detektorem kolizji ogniw
+// (kapsuły LinkCollisionModel: test własny i scena przez SceneBroadphase).
+// Długie krawędzie - łączenie drzew i skracanie ścieżki - są sprawdzane
+// równolegle na puli wątków, krótkie kroki rozszerzania na wątku wywołującym.
+// Scena nie może się zmieniać w trakcie Plan.
+class MotionPlanner
+{
+public:
+    // attached - obiekt trzymany przez chwytak, porusza się z ramieniem i jest pomijany
+    MotionPlanner(const RobotKinematics &kinematics, const LinkCollisionModel &collision, const Object3D *attached);
+
+    MotionPlan Plan(const float *start, const float *goal, const MotionPlannerSettings &settings = {});
+    bool IsStateValid(const float *angles);
+
+    static const char *GetStatusName(MotionPlanStatus status);
+
+private:
+    // Bufory detekcji kolizji - po jednym na wątek sprawdzający
+    struct Scratch
+    {
+        LinkCollisionModel probe;
+        std::vector<ArmRotation> rotations;
+        std::vector<Matrix> frames;
+        std::vector<LinkContact> contacts;
+    };
+
+    struct Tree
+    {
+        std::vector<float> nodes; // [node * jointCount + joint]
+        std::vector<int> parents;
+    };
+
+    enum class ExtendResult
+    {
+        TRAPPED,
+        ADVANCED,
+        REACHED
+    };
+
+    Scratch CreateScratch() const;
+    bool CheckState(Scratch &scratch, const float *angles) const;
+    // Liczba kolejnych poprawnych stanów krawędzi a -> b (bez a), ostatni to b
+    int ValidPrefix(const float *a, const float *b, int stateCount);
+    int StateCount(const float *a, const float *b) const;
+
+    int Nearest(const Tree &tree, const float *q) const;
+    int AddNode(Tree &tree, const float *q, int parent) const;
+    // node - ostatni dodany węzeł (lub najbliższy, gdy cel już jest w drzewie)
+    ExtendResult Extend(Tree &tree, const float *target, int &node);
+    ExtendResult Connect(Tree &tree, const float *target, int &node);
+    // Ścieżka start -> cel przez węzły o tej samej konfiguracji w obu drzewach
+    void BuildPath(const Tree &startTree, int startNode, const Tree &goalTree, int goalNode, std::vector<float> &path) const;
+    void Shortcut(std::vector<float> &path, std::mt19937 &rng);
+    void Densify(const std::vector<float> &path, std::vector<float> &out) const;
+
+    const RobotKinematics &kinematics;
+    const LinkCollisionModel &collision;
+    const Object3D *attached;
+    int jointCount;
+    std::vector<float> lowerLimits;
+    std::vector<float> upperLimits;
+
+    MotionPlannerSettings settings;
+    std::chrono::steady_clock::time_point deadline;
+    Scratch mainScratch;
+    std::vector<float> scratchConfig;
+    int stateChecks = 0;
+
+    static constexpr int PARALLEL_MIN_STATES = 16; // krótsze krawędzie bez puli wątków
+};
@@ -2,6 +2,9 @@
 #include "raylib.h"
 #include "raymath.h"
 #include "imgui.h"
+#include "meshBVH.h"
+#include "modelCache.h"
+#include "convexCollision.h"
 #include <string>
 #include <filesystem>
 #include <vector>
@@ -12,7 +15,10 @@ class Object3D
 public:
     Object3D(const char *modelPath, Shader shader);
     ~Object3D();
+    Object3D(const Object3D &) = delete;
+    Object3D &operator=(const Object3D &) = delete;
 
+    // Pojedynczy obiekt poza InstancedRenderer (scena rysuje instancjami)
     void Draw();
     void DrawImGuiControls();
     static Object3D *Create(const char *modelPath, Shader shader);
@@ -34,7 +40,7 @@ public:
         scale = scl;
         UpdateTransformMatrix();
     }
-    void SetColor(Color col) { color = col; }
+    void SetColor(Color col);
 
     // Gettery
     int GetId() const { return id; }
@@ -42,7 +48,7 @@ public:
     Vector3 GetRotation() const { return rotation; }
     float GetScale() const { return scale; }
     Color GetColor() const { return color; }
-    const Model &GetModel() const { return model; }
+    const Model &GetModel() const { return asset->model; }
     static void Delete(Object3D *obj);
     bool markedForDeletion = false;
     static std::vector<Object3D *> deleteQueue;
@@ -50,8 +56,20 @@ public:
     const std::string &GetModelPath() const { return modelPath; }
     Matrix GetTransform() const { return transformMatrix; }
 
+    // Zapytania w przestrzeni świata przez BVH modelu, z pełną transformacją obiektu
+    BoundingBox GetWorldBounds() const { return worldBounds; }
+    Vector4 GetWorldSphere() const { return worldSphere; } // środek xyz, promień w
+    const MeshBVH &GetBVH() const { return asset->bvh; }
+    RayCollision Raycast(Ray ray, float maxDistance) const;
+    bool IntersectsSphere(Vector3 center, float radius) const;
+    // Odległość odcinka od powierzchni modelu, maxDistance gdy nic nie jest bliżej
+    float SegmentDistance(Vector3 a, Vector3 b, float maxDistance, Vector3 *closestPoint = nullptr) const;
+    bool IsSegmentWithin(Vector3 a, Vector3 b, float distance) const;
+    // Otoczka wypukła modelu w bieżącej transformacji (GJK/EPA); ważna, dopóki obiekt istnieje
+    ConvexShape GetConvexShape() const { return ConvexShape::Hull(asset->hullPoints, transformMatrix); }
+
 private:
-    Model model;
+    const ModelAsset *asset; // z ModelCache, wspólny dla instancji tego samego pliku
     Shader shader;
     Material defaultMaterial;
     Material material;
@@ -72,9 +90,15 @@ private:
     float scale;
     Color color;
 
-    int colorLoc;
     std::string modelPath;
 
     void UpdateTransformMatrix();
     Matrix transformMatrix;
+    Matrix inverseTransform;
+    BoundingBox worldBounds;
+    Vector4 worldSphere;       // kula otaczająca w świecie, jak worldBounds liczona w UpdateTransformMatrix
+    int proxyId = -1;          // liść w SceneBroadphase
+    Vector3 proxyPosition;     // pozycja przy ostatniej aktualizacji proxy
+    int instanceId = -1;       // slot w InstancedRenderer
+    int lodLevel = -1;         // poziom szczegółowości z poprzedniego Draw
 };
\ No newline at end of file
@@ -0,0 +1,42 @@
+#pragma once
+#include "raylib.h"
+#include "raymath.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+class RobotKinematics;
+
+// Wokselowa mapa osiągalnych pozycji końcówki w przestrzeni modelu (bez skali).
+// Każdy woksel przechowuje jakość 0-255 (0 = nieosiągalny), proporcjonalną do
+// logarytmu liczby próbek FK, które w nim wylądowały.
+class ReachabilityMap
+{
+public:
+    static constexpr int RESOLUTION = 96;
+
+    // Wczytuje mapę z katalogu konfiguracji robota lub buduje ją i zapisuje,
+    // jeśli plik nie istnieje albo hash konfiguracji się nie zgadza
+    bool LoadOrBuild(const fs::path &configDir, const RobotKinematics &kinematics);
+    void Build(const RobotKinematics &kinematics, int sampleCount = 2000000);
+    bool Load(const fs::path &path, uint64_t expectedHash);
+    bool Save(const fs::path &path) const;
+
+    uint8_t GetQuality(const Vector3 &modelPosition) const;
+    bool IsReachable(const Vector3 &modelPosition) const { return GetQuality(modelPosition) > 0; }
+    bool IsLoaded() const { return !voxels.empty(); }
+    uint64_t GetConfigHash() const { return configHash; }
+    float GetBuildTime() const { return buildTime; }
+
+private:
+    int Index(int x, int y, int z) const { return (z * RESOLUTION + y) * RESOLUTION + x; }
+
+    uint64_t configHash = 0;
+    Vector3 origin = {0.0f, 0.0f, 0.0f};
+    float voxelSize = 1.0f;
+    float buildTime = 0.0f;
+    std::vector<uint8_t> voxels;
+};
@@ -0,0 +1,120 @@
+#pragma once
+#include "raylib.h"
+#include "raymath.h"
+#include "frustum.h"
+#include "modelLod.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Dane jednej instancji w buforze wierzchołków: atrybuty instanceTransform
+// (mat4, kolumnami) i instanceColor shadera sceny
+struct RenderInstance
+{
+    float16 transform;
+    Vector4 color;
+};
+
+// Kolejka renderowania klatki. Obiekty zgłaszają elementy (siatka, materiał,
+// transformacja, kolor) zamiast rysować od razu; Flush sortuje je po shaderze,
+// materiale (instancing, tekstura, kolor rozproszenia) i siatce, a przy rysowaniu
+// pomija niezmienione stany - shader, tekstura, VAO i uniformy koloru ustawiane są
+// tylko przy zmianie. Z materiału używana jest mapa rozproszenia. BeginFrame zapamiętuje
+// frustum kamery - zgłaszający odrzucają niewidoczne obiekty przed Submit - oraz
+// macierze do wyboru poziomu szczegółowości z wielkości kuli otaczającej na ekranie.
+class RenderQueue
+{
+public:
+    static RenderQueue &GetInstance()
+    {
+        static RenderQueue instance;
+        return instance;
+    }
+
+    struct FrameStats
+    {
+        int items = 0;
+        int drawCalls = 0;
+        int instances = 0;      // obiekty narysowane wywołaniami instancyjnymi
+        int shaderChanges = 0;
+        int textureChanges = 0;
+        int meshChanges = 0;    // wiązania VAO
+        int uniformChanges = 0; // kolory, przełączniki instancing/skinning i macierze ogniw
+        int culled = 0;         // obiekty i siatki odrzucone testem frustum
+        int lodObjects[ModelLod::MAX_LEVELS] = {0}; // wybory poziomu szczegółowości
+    };
+
+    // Wewnątrz BeginMode3D, przed zgłoszeniami: frustum z bieżących macierzy rlgl, zerowanie statystyk
+    void BeginFrame();
+    const Frustum &GetFrustum() const { return frustum; }
+    // Test kuli z liczeniem odrzuconych
+    bool IsVisible(Vector3 center, float radius);
+    void AddCulled(int count) { stats.culled += count; }
+    // Średnica kuli na ekranie jako ułamek wysokości widoku (INFINITY - kamera w kuli)
+    float ProjectedSize(Vector3 center, float radius) const;
+    // Poziom szczegółowości kuli; current - poziom z poprzedniej klatki (-1 - brak)
+    int SelectLod(const ModelLod &lod, Vector3 center, float radius, int current);
+
+    // tint - uniform materialColor shadera sceny (mnożony po oświetleniu)
+    void Submit(const Mesh &mesh, const Material &material, Matrix transform, Color tint);
+    // instanceBuffer - VBO z instanceCount elementami RenderInstance
+    void SubmitInstanced(const Mesh &mesh, Shader shader, unsigned int instanceBuffer, int instanceCount);
+    // Siatka z indeksem ogniwa na wierzchołek (SkinnedModel); linkRows - po trzy wiersze
+    // macierzy na ogniwo, ważne do Flush
+    void SubmitSkinned(const Mesh &mesh, const Material &material, Color tint, const Vector4 *linkRows, int linkCount);
+
+    // Rysuje i czyści kolejkę
+    void Flush();
+
+    const FrameStats &GetStats() const { return stats; }
+    void DrawImGuiControls();
+
+private:
+    RenderQueue() = default;
+    RenderQueue(const RenderQueue &) = delete;
+    RenderQueue &operator=(const RenderQueue &) = delete;
+
+    struct Item
+    {
+        const Mesh *mesh;
+        Shader shader;
+        unsigned int texture;
+        uint32_t diffuse; // kolory spakowane RGBA - porównania przy sortowaniu i filtrowaniu stanów
+        uint32_t tint;
+        Matrix transform;
+        unsigned int instanceBuffer; // 0 - zwykłe rysowanie
+        int instanceCount;
+        const Vector4 *linkRows = nullptr; // skinning, gdy linkCount > 0
+        int linkCount = 0;
+    };
+
+    // Lokacje spoza standardowego zestawu raylib, raz na shader
+    struct ShaderLocations
+    {
+        int materialColor = -1;
+        int instancing = -1;
+        int instanceTransform = -1;
+        int instanceColor = -1;
+        int skinning = -1;
+        int linkMatrices = -1;
+    };
+
+    // 0 - zwykłe rysowanie, 1 - instancje, 2 - skinning
+    static int DrawMode(const Item &item) { return item.instanceBuffer != 0 ? 1 : (item.linkCount > 0 ? 2 : 0); }
+    // Kolejność: shader, tryb rysowania, tekstura, kolor rozproszenia, siatka, tint
+    static bool DrawsBefore(const Item &a, const Item &b);
+    // Przełączniki instancing i skinning shadera sceny
+    void SetModeUniforms(const ShaderLocations &locations, int mode, int &current);
+    const ShaderLocations &GetLocations(Shader shader);
+    void DrawInstanced(const Item &item, const ShaderLocations &locations);
+
+    std::vector<Item> items;
+    std::vector<uint32_t> order;
+    std::unordered_map<unsigned int, ShaderLocations> locations;
+    Frustum frustum;
+    Matrix view = MatrixIdentity();
+    Matrix projection = MatrixIdentity();
+    bool lodEnabled = true;
+    float lodBias = 1.0f; // mnożnik wielkości na ekranie; > 1 - dokładniejsze poziomy dalej od kamery
+    FrameStats stats;     // od ostatniego BeginFrame
+};
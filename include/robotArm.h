@@ -8,27 +8,67 @@
 #include "lua.hpp"
 #include "vector"
 #include "robotKinematics.h"
+#include "reachabilityMap.h"
+#include "ikSeedDatabase.h"
 #include "object3D.h"
+#include "linkCollisionModel.h"
+#include "trajectoryValidation.h"
+#include "motionPlanner.h"
+#include "skinnedModel.h"
 
 class RobotArm {
 private:
-    Model model;
+    const ModelAsset *modelAsset; // z ModelCache; siatki tylko do odczytu
+    const Model &model;
     bool* meshVisibility;
-    ArmRotation* meshRotations;
+    std::vector<ArmRotation> meshRotations;
+    RobotDescription description;
     float scale;
     Color color;
     Shader shader;
-    int colorLoc;
     Material defaultMaterial;
-    Vector3* pivotPoints;
-    float* armLengths;
     bool showPivotPoints;
     bool showTrajectory;
     bool isAnimating;
     float animationTime;
-    const float ANIMATION_DURATION = 2.0f;
+    MotionProfile motionProfile = MotionProfile::PATH_TOPP;
+    std::vector<float> playbackAngles;
+
+    // Walidacja zaplanowanej trajektorii; podgląd planowany osobno, żeby nie
+    // nadpisywać trajektorii odtwarzanej w trakcie animacji
+    TimedTrajectory previewTrajectory;
+    TrajectoryValidation trajectoryValidation;
+    bool hasTrajectoryValidation = false;
+    bool autoValidateTrajectory = true;
+    bool trajectoryDirty = false;
+
+    // Planer RRT-Connect: ustawienia, ścieżka TCP ostatniego planu i statystyki
+    MotionPlannerSettings plannerSettings;
+    MotionPlan lastMotionPlan;
+    std::vector<Vector3> plannedPath;
+    int motionPlanCount = 0;
+    int motionPlanFailures = 0;
+    float totalPlanningMs = 0.0f;
+    float maxPlanningMs = 0.0f;
+
+    // Stan po dwóch ostatnich krokach symulacji i ramki interpolowane do rysowania
+    std::vector<float> previousStepAngles;
+    std::vector<float> currentStepAngles;
+    std::vector<ArmRotation> renderRotations;
+    std::vector<Matrix> renderTransforms;
+    std::vector<Vector4> meshBounds; // kule otaczające siatek w układzie modelu (środek xyz, promień w)
+    std::vector<int> meshLod;        // poziom szczegółowości siatek z poprzedniej klatki (-1 - brak)
+
+    // Ogniwa scalone w jedną siatkę rysowaną jednym wywołaniem (macierze ogniw w uniformie)
+    SkinnedModel skinnedModel;
+    std::vector<Vector4> linkRows; // trzy wiersze macierzy na ogniwo, ważne do końca klatki
+    int skinnedLod = -1;
+    bool useSkinning = true;
     
     RobotKinematics* kinematics;
+    ReachabilityMap reachabilityMap;
+    IKSeedDatabase seedDatabase;
+    std::string configDir;
     bool stepMode;
     int currentLine;
     lua_State* L;
@@ -36,20 +76,38 @@ private:
         Vector3 gripperPosition;    // Position of the gripper sphere
     float gripperRadius;        // Radius of the gripper sphere
     bool isColliding;          // Collision state
+    bool wasColliding = false; // stan z poprzedniego kroku - do logowania zmian
+    int collisionCount = 0;    // Liczba wejść chwytaka w kolizję
     Color gripperColor;
+    ConvexContact gripperContact; // GJK/EPA: kula chwytaka - otoczka obiektu, ważny gdy isColliding
+    std::vector<Object3D *> gripperCandidates; // wyniki fazy szerokiej dla chwytaka, pojemność między krokami
 
     Object3D* grippedObject = nullptr;
     bool isGripping = false;
     Vector3 gripOffset; // Offset między chwytakiem a obiektem
 
+    // Kolizje ogniw (kapsuły) z otoczeniem i między sobą, liczone co krok
+    LinkCollisionModel linkCollision;
+    std::vector<LinkContact> linkContacts;
+    std::vector<Matrix> stepTransforms;
+    float contactMargin = 0.05f; // [jednostki świata]
+    bool showCapsules = false;
+    int linkCollisionCount = 0;  // Liczba wejść ogniw w przenikanie
+    float minLinkDistance;       // Minimum od startu, FLT_MAX - brak kontaktu w marginesie
+    void CheckLinkCollisions();
+    // Ścieżka modelu obiektu sceny albo nazwa drugiego ogniwa
+    const char *ContactTargetName(const LinkContact &contact) const;
+
         LogWindow& logWindow;
-    const std::vector<Object3D*>* sceneObjects = nullptr;
 public:
     RobotArm(const char* modelPath, Shader shader);
     ~RobotArm();
 
     void Draw();
-    void Update();
+    // Jeden krok symulacji o stałej długości
+    void Update(float deltaTime);
+    // Interpolacja między dwoma ostatnimi krokami (alpha z SimulationClock), raz na klatkę przed Draw
+    void PrepareRender(float alpha);
     void UpdateRotation(int meshIndex, float angle);
     void SetMeshVisibility(int meshIndex, bool visible);
     void SetScale(float newScale);
@@ -60,21 +118,50 @@ public:
     float GetMeshRotation(int index) const { return meshRotations[index].angle; }
     Vector3 GetRotationAxis(int index) const { return meshRotations[index].axis; }
     void DrawPivotPoints();
-    Vector3* GetPivotPoints() { return pivotPoints; }
+    const RobotDescription &GetDescription() const { return description; }
     void SetPivotPoint(int index, Vector3 position);
     void DrawTrajectory();
     void DrawImGuiControls();
     
     void MoveToPosition(const Vector3& position);
     void RotateJoint(int jointIndex, float angle);
+    void CompareIKSolvers();
+    void BenchmarkBatchFK();
+    void BenchmarkIKSeeds();
+    void BenchmarkBatchIK();
+    void BenchmarkKinematicChain();
+    void BenchmarkLinkCollisions();
+    void BenchmarkMotionPlanner();
+    RobotKinematics *GetKinematics() { return kinematics; }
+    void RebuildReachabilityMap();
+    void StartAnimation();
+    // Planuje trajektorię do bieżącego celu i sprawdza ją ciągle pod kątem kolizji ogniw
+    const TrajectoryValidation &ValidatePlannedTrajectory();
+    const TrajectoryValidation &GetTrajectoryValidation() const { return trajectoryValidation; }
+    // Plan bezkolizyjnego ruchu do celu (IK + RRT-Connect) i start animacji; false - brak planu
+    bool PlanMotion(const IKTarget &target);
+    const MotionPlan &GetLastMotionPlan() const { return lastMotionPlan; }
+    int GetMotionPlanCount() const { return motionPlanCount; }
+    int GetMotionPlanFailures() const { return motionPlanFailures; }
+    float GetAveragePlanningMs() const { return motionPlanCount > 0 ? totalPlanningMs / motionPlanCount : 0.0f; }
+    float GetMaxPlanningMs() const { return maxPlanningMs; }
 
-        void CheckCollisions(const std::vector<Object3D*>& objects);
+    // Kolizje ogniw oraz chwytaka z obiektami sceny (SceneBroadphase + BVH obiektu)
+    void CheckCollisions();
     void DrawGripper();
 
         void GripObject();
     void ReleaseObject();
     bool CanGrip() const { return isColliding && !isGripping; }
     bool IsGripping() const { return isGripping; }
-    void SetSceneObjects(const std::vector<Object3D*>& objects) { sceneObjects = &objects; }
+    bool IsAnimating() const { return isAnimating; }
+    int GetCollisionCount() const { return collisionCount; }
+    const ConvexContact &GetGripperContact() const { return gripperContact; }
+    const std::vector<LinkContact> &GetLinkContacts() const { return linkContacts; }
+    int GetLinkCollisionCount() const { return linkCollisionCount; }
+    float GetMinLinkDistance() const { return minLinkDistance; }
+    LinkCollisionModel &GetLinkCollisionModel() { return linkCollision; }
+    // Wywoływane przed usunięciem obiektu ze sceny
+    void DetachObject(const Object3D* object);
     // void Reset();
 };
\ No newline at end of file
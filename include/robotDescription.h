@@ -0,0 +1,44 @@
+#pragma once
+#include "raylib.h"
+#include "raymath.h"
+#include <string>
+#include <vector>
+#include <filesystem>
+
+struct JointLimit
+{
+    float min;
+    float max;
+    float maxVelocity = 90.0f;      // [deg/s]
+    float maxAcceleration = 360.0f; // [deg/s^2]
+};
+
+// Statyczne dane przegubu spakowane razem - pętle kinematyki czytają jeden ciągły blok
+struct JointDesc
+{
+    Vector3 pivot;    // punkt obrotu w przestrzeni modelu
+    Vector3 axis;     // oś obrotu w układzie lokalnym
+    JointLimit limit;
+    float length;     // odległość do pivota następnego przegubu (lub TCP)
+};
+
+// Opis kinematyki robota wczytywany z .<model>/config.json (sekcje "joints"
+// i "tool"; "armLengths" jest ignorowane, długości liczone są z pivotów). joints
+// ma jointCount + 1 elementów: ostatni to punkt narzędzia (TCP), dla którego
+// znaczenie ma tylko pivot.
+class RobotDescription
+{
+public:
+    std::vector<JointDesc> joints;
+    std::vector<std::string> names;
+
+    // Wczytuje opis z pliku; false, jeśli plik nie istnieje lub nie ma sekcji "joints"
+    bool LoadFromFile(const std::filesystem::path &configPath);
+    // Geometria dołączonego ramienia 6-osiowego, uzupełniona do jointCount przegubów
+    static RobotDescription CreateDefault(int jointCount);
+
+    int GetJointCount() const { return (int)joints.size() - 1; }
+    std::vector<JointLimit> GetLimits() const;
+    // Długości ramion z odległości między kolejnymi pivotami
+    void UpdateLengths();
+};
@@ -2,6 +2,13 @@
 #include "raylib.h"
 #include "raymath.h"
 #include <vector>
+#include <cstdint>
+#include "robotDescription.h"
+#include "batchKinematics.h"
+#include "timedTrajectory.h"
+
+class ReachabilityMap;
+class IKSeedDatabase;
 
 struct ArmRotation
 {
@@ -16,11 +23,48 @@ enum class InterpolationType
     SPLINE
 };
 
+enum class IKSolverType
+{
+    CCD,
+    JACOBIAN_DLS,
+    ANALYTICAL
+};
+
+enum class MotionProfile
+{
+    PATH_TOPP, // ścieżka kartezjańska z optymalną czasowo parametryzacją
+    PTP        // ruch punkt-punkt, trapez prędkości w przestrzeni przegubów
+};
+
+// Wynik ostatniego wywołania solvera IK
+struct IKResult
+{
+    int iterations = 0;
+    float positionError = 0.0f;    // [jednostki świata]
+    float orientationError = 0.0f; // [rad]
+    bool converged = false;
+    bool reachable = true;
+};
+
+// Specjalizacja łańcucha kinematycznego dla konkretnych osi (kinematicChain.h)
+struct KinematicChainSpec
+{
+    const char *name;
+    void (*forward)(const JointDesc *joints, const ArmRotation *rotations, int first, Matrix *frames);
+};
+
+// Cel dla wsadowego IK
+struct IKTarget
+{
+    Vector3 position;
+    Vector3 orientation = {0.0f, 0.0f, 0.0f}; // kąty Eulera XYZ [deg]
+    bool useOrientation = false;
+};
+
 class RobotKinematics
 {
 private:
-    Vector3 *pivotPoints;
-    float *armLengths;
+    RobotDescription *description;
     ArmRotation *meshRotations;
     int meshCount;
     float scale;
@@ -30,18 +74,72 @@ private:
     std::vector<Vector3> trajectoryPoints;
     std::vector<Vector3> controlPoints;
     InterpolationType interpolationType;
+    IKSolverType solverType;
+    IKResult lastIKResult;
+    Vector3 targetOrientation; // kąty Eulera XYZ [deg]
+    Matrix targetRotation;
+    bool useTargetOrientation;
+    const ReachabilityMap *reachabilityMap;
+    TimedTrajectory timedTrajectory;
+    const IKSeedDatabase *seedDatabase;
+    bool useSeedDatabase;
+
+    // Cache transformacji świata dla kolejnych przegubów
+    std::vector<Matrix> jointTransforms;
+    std::vector<ArmRotation> cachedRotations;
+    std::vector<Vector3> cachedPivots;
+    int dirtyFrom;
+    const KinematicChainSpec *chainSpec;
+    bool useSpecializedChain;
 
+    Vector3 &Pivot(int index) const { return description->joints[index].pivot; }
+    const JointLimit &Limit(int index) const { return description->joints[index].limit; }
+    float Length(int index) const { return description->joints[index].length; }
     float ClampAngle(float angle, float min, float max);
     bool IsPositionReachable(const Vector3 &position);
+    void SyncJointState();
+    void InvalidateFrom(int jointIndex);
+    void UpdateTransformCache();
+    const Matrix &CachedTransform(int meshIndex);
+    Vector3 CachedEndEffectorPosition();
+    void SolveCCD();
+    void SolveDLS();
+    bool SolveAnalytical();
+    bool IsAnalyticalGeometry() const;
+    float OrientationError(const Matrix &current, Vector3 &errorAxis) const;
+    float SeedCost();
+    bool ApplySeed();
 
 public:
-    RobotKinematics(Vector3 *pivotPoints, float *armLengths, ArmRotation *meshRotations,
-                    int meshCount, float scale);
+    // Opis robota i tablica kątów należą do wywołującego (RobotArm) i muszą go przeżyć
+    RobotKinematics(RobotDescription *description, ArmRotation *meshRotations, float scale);
+    // Kopia geometrii i ustawień solvera pracująca na własnym buforze kątów,
+    // dzięki czemu wiele instancji może liczyć IK równolegle
+    RobotKinematics(const RobotKinematics &settings, ArmRotation *scratchRotations);
 
     void SolveIK();
+    // Rozwiązuje niezależne cele równolegle na puli wątków; każdy startuje z bieżącej pozy.
+    // outAngles: [target * meshCount + joint]. Stan ramienia pozostaje niezmieniony.
+    void SolveIKBatch(const std::vector<IKTarget> &targets, std::vector<float> &outAngles,
+                      std::vector<IKResult> &outResults) const;
     Vector3 CalculateEndEffectorPosition();
+    Matrix GetJointTransform(int meshIndex);
+    // Ramki przegubów first..meshCount-1 dla podanych kątów, bez ruszania cache
+    // (np. stan interpolowany do rysowania). Dla first > 0 frames[first - 1] musi być aktualna.
+    void ComputeJointTransforms(const ArmRotation *rotations, int first, Matrix *frames) const;
+    BatchKinematics CreateBatchKinematics() const;
+    Vector3 GetJointPosition(int pivotIndex);
     void CalculateTrajectory();
     const std::vector<Vector3> &GetTrajectoryPoints() const { return trajectoryPoints; }
+    // Parametryzacja czasowa ruchu do celu; IK liczone na kopii stanu,
+    // pozycja ramienia po powrocie jest niezmieniona. Zwraca liczbę punktów,
+    // w których IK nie osiągnęło zbieżności.
+    int PlanTimedTrajectory(MotionProfile profile);
+    // To samo planowanie do zewnętrznego bufora - np. podgląd do walidacji w trakcie animacji
+    int PlanTimedTrajectory(MotionProfile profile, TimedTrajectory &out);
+    const TimedTrajectory &GetTimedTrajectory() const { return timedTrajectory; }
+    // Parametryzacja czasowa gotowej ścieżki w przestrzeni przegubów (np. z planera RRT)
+    bool BuildTimedTrajectory(const std::vector<float> &waypoints);
     void SetTargetPosition(const Vector3 &position) { targetPosition = position; }
     Vector3 GetTargetPosition() const { return targetPosition; }
     void SetScale(float newScale) { scale = newScale; }
@@ -50,6 +148,32 @@ public:
     void SetControlPoints(const std::vector<Vector3> &points) { controlPoints = points; }
     bool IsTargetReachable() const { return isTargetReachable; }
     static Vector3 TransformAxis(Vector3 axis, Matrix transform);
-    static Matrix GetHierarchicalTransform(int meshIndex, ArmRotation *rotations, Vector3 *pivots);
+    static Matrix GetHierarchicalTransform(int meshIndex, ArmRotation *rotations, const JointDesc *joints);
     InterpolationType GetInterpolationType() const { return interpolationType; }
+
+    void SetSolverType(IKSolverType type) { solverType = type; }
+    IKSolverType GetSolverType() const { return solverType; }
+    const IKResult &GetLastIKResult() const { return lastIKResult; }
+    void SetTargetOrientation(const Vector3 &eulerDegrees);
+    Vector3 GetTargetOrientation() const { return targetOrientation; }
+    void SetUseTargetOrientation(bool enabled) { useTargetOrientation = enabled; }
+    bool IsUsingTargetOrientation() const { return useTargetOrientation; }
+    const JointLimit &GetJointLimit(int index) const { return Limit(index); }
+
+    int GetMeshCount() const { return meshCount; }
+    float GetScale() const { return scale; }
+    Vector3 GetPivotPoint(int index) const { return Pivot(index); }
+    const RobotDescription &GetDescription() const { return *description; }
+    float GetTotalLength() const;
+    uint64_t GetConfigHash() const;
+    void SetReachabilityMap(const ReachabilityMap *map) { reachabilityMap = map; }
+    bool HasValidReachabilityMap() const;
+    int GetReachabilityQuality(const Vector3 &position) const;
+    void SetUseSpecializedChain(bool enabled) { useSpecializedChain = enabled; InvalidateFrom(0); }
+    bool IsUsingSpecializedChain() const { return useSpecializedChain; }
+    const char *GetChainName() const { return chainSpec ? chainSpec->name : nullptr; }
+    void SetSeedDatabase(const IKSeedDatabase *database) { seedDatabase = database; }
+    bool HasValidSeedDatabase() const;
+    void SetUseSeedDatabase(bool enabled) { useSeedDatabase = enabled; }
+    bool IsUsingSeedDatabase() const { return useSeedDatabase; }
 };
\ No newline at end of file
@@ -0,0 +1,101 @@
+#pragma once
+#include "raylib.h"
+#include "raymath.h"
+#include <vector>
+
+class Object3D;
+
+// Faza szeroka kolizji dla obiektów sceny: dynamiczne drzewo AABB.
+// Liście przechowują "grube" AABB (z zapasem), więc drobne ruchy nie
+// przebudowują drzewa; po wyjściu poza zapas liść jest usuwany i wstawiany
+// ponownie, a ścieżka do korzenia jest dopasowywana i równoważona rotacjami.
+// Object3D rejestruje się sam i aktualizuje proxy przy każdej zmianie transformacji.
+class SceneBroadphase
+{
+public:
+    static SceneBroadphase &GetInstance()
+    {
+        static SceneBroadphase instance;
+        return instance;
+    }
+
+    int CreateProxy(const BoundingBox &aabb, Object3D *object);
+    void DestroyProxy(int proxyId);
+    // displacement wydłuża gruby AABB w kierunku ruchu (chwytane obiekty). true - liść wstawiony ponownie
+    bool MoveProxy(int proxyId, const BoundingBox &aabb, Vector3 displacement);
+    BoundingBox GetFatAABB(int proxyId) const { return nodes[proxyId].aabb; }
+
+    // callback(Object3D*) -> false przerywa zapytanie
+    template <typename Callback>
+    void Query(const BoundingBox &aabb, Callback &&callback) const;
+    void QuerySphere(Vector3 center, float radius, std::vector<Object3D *> &out) const;
+
+    // Najbliższy obiekt trafiony promieniem (test dokładny przez BVH obiektu); nullptr - brak trafienia
+    Object3D *Raycast(Ray ray, float maxDistance, RayCollision *hit = nullptr) const;
+
+    int GetProxyCount() const { return proxyCount; }
+    int GetHeight() const { return root < 0 ? 0 : nodes[root].height; }
+
+private:
+    SceneBroadphase() = default;
+    SceneBroadphase(const SceneBroadphase &) = delete;
+    SceneBroadphase &operator=(const SceneBroadphase &) = delete;
+
+    struct TreeNode
+    {
+        BoundingBox aabb;
+        Object3D *object = nullptr;
+        int parent = -1; // dla wolnych węzłów: następny wolny
+        int child1 = -1;
+        int child2 = -1;
+        int height = -1; // liść 0, wolny -1
+
+        bool IsLeaf() const { return child1 < 0; }
+    };
+
+    int AllocateNode();
+    void FreeNode(int index);
+    void InsertLeaf(int leaf);
+    void RemoveLeaf(int leaf);
+    int Balance(int index);
+    void Refit(int index);
+
+    static BoundingBox Fatten(const BoundingBox &aabb, float factor);
+
+    std::vector<TreeNode> nodes;
+    int root = -1;
+    int freeList = -1;
+    int proxyCount = 0;
+
+    static constexpr float FAT_MARGIN = 0.1f;        // zapas jako ułamek rozmiaru obiektu
+    static constexpr float DISPLACEMENT_FACTOR = 4.0f;
+};
+
+template <typename Callback>
+void SceneBroadphase::Query(const BoundingBox &aabb, Callback &&callback) const
+{
+    if (root < 0)
+        return;
+
+    std::vector<int> stack;
+    stack.reserve(64);
+    stack.push_back(root);
+    while (!stack.empty())
+    {
+        const TreeNode &node = nodes[stack.back()];
+        stack.pop_back();
+        if (!CheckCollisionBoxes(node.aabb, aabb))
+            continue;
+
+        if (node.IsLeaf())
+        {
+            if (!callback(node.object))
+                return;
+        }
+        else
+        {
+            stack.push_back(node.child1);
+            stack.push_back(node.child2);
+        }
+    }
+}
@@ -32,13 +32,15 @@ public:
     void ScanDirectory();
     bool SaveScene(const std::string& filename, const std::vector<Object3D*>& objects);
     bool LoadScene(const std::string& filename, std::vector<Object3D*>& objects, Shader& shader);
+    // Scena spoza katalogu scen - pełna ścieżka do pliku .scn
+    bool LoadSceneFromPath(const std::string& filepath, std::vector<Object3D*>& objects, Shader& shader);
 
     std::function<void(const std::string&)> onSaveScene;
     std::function<void(const std::string&)> onLoadScene;
 
 private:
 
-    bool LoadSceneFile(const std::string& filename);
+    bool LoadSceneFile(const std::string& filepath);
     void UpdateObjects(std::vector<Object3D*>& objects, Shader& shader);
     std::vector<std::string> sceneFiles;
     const std::string scenesPath = "assets/scenes";
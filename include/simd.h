@@ -0,0 +1,113 @@
+#pragma once
+#include <cmath>
+
+// Minimalna abstrakcja pasów SIMD dla kerneli wsadowych.
+// FloatLanes ma szerokość 8 (AVX), 4 (SSE2) lub 1 (fallback skalarny),
+// ScalarLanes jest zawsze dostępny i używa tego samego API.
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define ROBOLAB_SIMD_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ROBOLAB_SIMD_SSE2 1
+#endif
+
+struct ScalarLanes
+{
+    static constexpr int WIDTH = 1;
+    float v;
+
+    static ScalarLanes Set(float x) { return {x}; }
+    static ScalarLanes Load(const float *p) { return {*p}; }
+    void Store(float *p) const { *p = v; }
+
+    friend ScalarLanes operator+(ScalarLanes a, ScalarLanes b) { return {a.v + b.v}; }
+    friend ScalarLanes operator-(ScalarLanes a, ScalarLanes b) { return {a.v - b.v}; }
+    friend ScalarLanes operator*(ScalarLanes a, ScalarLanes b) { return {a.v * b.v}; }
+    friend ScalarLanes operator/(ScalarLanes a, ScalarLanes b) { return {a.v / b.v}; }
+    friend ScalarLanes Min(ScalarLanes a, ScalarLanes b) { return {fminf(a.v, b.v)}; }
+    friend ScalarLanes Max(ScalarLanes a, ScalarLanes b) { return {fmaxf(a.v, b.v)}; }
+    friend ScalarLanes Sqrt(ScalarLanes a) { return {sqrtf(a.v)}; }
+    friend ScalarLanes Round(ScalarLanes a) { return {nearbyintf(a.v)}; }
+};
+
+#if defined(ROBOLAB_SIMD_AVX)
+struct FloatLanes
+{
+    static constexpr int WIDTH = 8;
+    __m256 v;
+
+    static FloatLanes Set(float x) { return {_mm256_set1_ps(x)}; }
+    static FloatLanes Load(const float *p) { return {_mm256_loadu_ps(p)}; }
+    void Store(float *p) const { _mm256_storeu_ps(p, v); }
+
+    friend FloatLanes operator+(FloatLanes a, FloatLanes b) { return {_mm256_add_ps(a.v, b.v)}; }
+    friend FloatLanes operator-(FloatLanes a, FloatLanes b) { return {_mm256_sub_ps(a.v, b.v)}; }
+    friend FloatLanes operator*(FloatLanes a, FloatLanes b) { return {_mm256_mul_ps(a.v, b.v)}; }
+    friend FloatLanes operator/(FloatLanes a, FloatLanes b) { return {_mm256_div_ps(a.v, b.v)}; }
+    friend FloatLanes Min(FloatLanes a, FloatLanes b) { return {_mm256_min_ps(a.v, b.v)}; }
+    friend FloatLanes Max(FloatLanes a, FloatLanes b) { return {_mm256_max_ps(a.v, b.v)}; }
+    friend FloatLanes Sqrt(FloatLanes a) { return {_mm256_sqrt_ps(a.v)}; }
+    friend FloatLanes Round(FloatLanes a) { return {_mm256_round_ps(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)}; }
+};
+#elif defined(ROBOLAB_SIMD_SSE2)
+struct FloatLanes
+{
+    static constexpr int WIDTH = 4;
+    __m128 v;
+
+    static FloatLanes Set(float x) { return {_mm_set1_ps(x)}; }
+    static FloatLanes Load(const float *p) { return {_mm_loadu_ps(p)}; }
+    void Store(float *p) const { _mm_storeu_ps(p, v); }
+
+    friend FloatLanes operator+(FloatLanes a, FloatLanes b) { return {_mm_add_ps(a.v, b.v)}; }
+    friend FloatLanes operator-(FloatLanes a, FloatLanes b) { return {_mm_sub_ps(a.v, b.v)}; }
+    friend FloatLanes operator*(FloatLanes a, FloatLanes b) { return {_mm_mul_ps(a.v, b.v)}; }
+    friend FloatLanes operator/(FloatLanes a, FloatLanes b) { return {_mm_div_ps(a.v, b.v)}; }
+    friend FloatLanes Min(FloatLanes a, FloatLanes b) { return {_mm_min_ps(a.v, b.v)}; }
+    friend FloatLanes Max(FloatLanes a, FloatLanes b) { return {_mm_max_ps(a.v, b.v)}; }
+    friend FloatLanes Sqrt(FloatLanes a) { return {_mm_sqrt_ps(a.v)}; }
+    // Konwersja z domyślnym trybem zaokrąglania (do najbliższej)
+    friend FloatLanes Round(FloatLanes a) { return {_mm_cvtepi32_ps(_mm_cvtps_epi32(a.v))}; }
+};
+#else
+using FloatLanes = ScalarLanes;
+#endif
+
+inline const char *SimdInstructionSet()
+{
+#if defined(ROBOLAB_SIMD_AVX)
+    return "AVX";
+#elif defined(ROBOLAB_SIMD_SSE2)
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
+
+// sin(2*pi*x) dla x w obrotach; błąd ~1e-7 w całym zakresie float
+template <typename Lanes>
+inline Lanes SinTurns(Lanes x)
+{
+    x = x - Round(x);                                  // [-0.5, 0.5]
+    x = Min(x, Lanes::Set(0.5f) - x);                  // sin(pi - y) = sin(y)
+    x = Max(x, Lanes::Set(-0.5f) - x);                 // [-0.25, 0.25]
+    Lanes y = x * Lanes::Set(6.28318530718f);          // [-pi/2, pi/2]
+    Lanes y2 = y * y;
+    Lanes p = Lanes::Set(-2.50521083854e-8f);          // -1/11!
+    p = p * y2 + Lanes::Set(2.75573192240e-6f);        //  1/9!
+    p = p * y2 + Lanes::Set(-1.98412698413e-4f);       // -1/7!
+    p = p * y2 + Lanes::Set(8.33333333333e-3f);        //  1/5!
+    p = p * y2 + Lanes::Set(-1.66666666667e-1f);       // -1/3!
+    return y + y * y2 * p;
+}
+
+// Sinus i cosinus kąta podanego w stopniach
+template <typename Lanes>
+inline void SinCosDegrees(Lanes degrees, Lanes &s, Lanes &c)
+{
+    Lanes turns = degrees * Lanes::Set(1.0f / 360.0f);
+    s = SinTurns(turns);
+    c = SinTurns(turns + Lanes::Set(0.25f));
+}
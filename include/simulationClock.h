@@ -0,0 +1,38 @@
+#pragma once
+#include "imgui.h"
+
+// Zegar symulacji o stałym kroku, niezależny od częstotliwości klatek.
+// Czas klatki trafia do akumulatora, z którego wyjmowane są pełne kroki;
+// reszta (alpha) służy do interpolacji stanu przy rysowaniu.
+class SimulationClock
+{
+public:
+    static constexpr float DEFAULT_RATE = 1000.0f; // [Hz]
+
+    explicit SimulationClock(float stepRate = DEFAULT_RATE);
+
+    // Dodaje czas klatki, zwraca liczbę kroków do wykonania w tej klatce.
+    // Zbyt długa klatka jest przycinana - symulacja zwalnia zamiast nadrabiać bez końca.
+    int Advance(float frameTime);
+
+    float GetStep() const { return step; }
+    float GetStepRate() const { return 1.0f / step; }
+    void SetStepRate(float rate);
+    // Ułamek kroku, o jaki czas rzeczywisty wyprzedza ostatni krok symulacji [0, 1)
+    float GetAlpha() const { return interpolate ? (float)(accumulator / step) : 1.0f; }
+    double GetSimTime() const { return simTime; }
+    long long GetStepCount() const { return stepCount; }
+
+    void DrawImGuiControls();
+
+private:
+    float step;
+    double accumulator = 0.0;
+    double simTime = 0.0;
+    double droppedTime = 0.0;
+    long long stepCount = 0;
+    int lastFrameSteps = 0;
+    bool interpolate = true;
+
+    static constexpr float MAX_FRAME_TIME = 0.25f; // [s]
+};
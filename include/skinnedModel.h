@@ -0,0 +1,37 @@
+#pragma once
+#include "raylib.h"
+#include "raymath.h"
+#include <vector>
+
+struct ModelAsset;
+
+// Siatki ogniw robota scalone w jeden bufor wierzchołków z indeksem ogniwa w atrybucie
+// vertexLink, rysowane jednym wywołaniem z macierzami ogniw w uniformie (skinning w
+// lightning.vs, jedna kość na wierzchołek). Osobna paczka na każdy poziom szczegółowości
+// modelu; gdy ogniwa nie mieszczą się w 16-bitowych indeksach, poziom dzieli się na
+// kilka paczek. Macierze przekazywane są jako trzy wiersze vec4 (część afiniczna).
+class SkinnedModel
+{
+public:
+    static constexpr int MAX_LINKS = 32; // jak MAX_LINKS w lightning.vs
+
+    struct Batch
+    {
+        Mesh mesh = {0};
+        unsigned int linkVboId = 0; // vertexLink, float na wierzchołek
+    };
+
+    // Wymaga kontekstu GL i atrybutu vertexLink w shaderze; false - rysowanie ogniwami
+    bool Build(const ModelAsset &asset, Shader shader);
+    void Unload();
+
+    bool IsReady() const { return !levels.empty(); }
+    int GetLevelCount() const { return (int)levels.size(); }
+    const std::vector<Batch> &GetBatches(int level) const { return levels[level]; }
+
+    // Wiersze macierzy ogniwa w kolejności uniformu linkMatrices
+    static void PackLinkMatrix(Matrix transform, Vector4 *rows);
+
+private:
+    std::vector<std::vector<Batch>> levels;
+};
@@ -0,0 +1,39 @@
+#pragma once
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// Pula wątków roboczych dla obliczeń wsadowych (IK, walidacja trajektorii).
+// Jedna instancja na aplikację, wątki tworzone przy pierwszym użyciu.
+class ThreadPool
+{
+public:
+    static ThreadPool &GetInstance()
+    {
+        static ThreadPool instance;
+        return instance;
+    }
+
+    // Dzieli zakres [0, count) na porcje i wykonuje body(begin, end) na wątkach puli.
+    // Wątek wywołujący też liczy porcje i wraca dopiero po zakończeniu wszystkich.
+    void ParallelFor(int count, const std::function<void(int begin, int end)> &body, int minChunk = 1);
+
+    int GetWorkerCount() const { return (int)workers.size(); }
+
+private:
+    ThreadPool();
+    ~ThreadPool();
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    void WorkerLoop();
+
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool stopping = false;
+};
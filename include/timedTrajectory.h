@@ -0,0 +1,43 @@
+#pragma once
+#include <vector>
+
+struct JointLimit;
+
+// Trajektoria w przestrzeni przegubów indeksowana czasem.
+// Profil jest wyliczany raz (PTP z trapezem prędkości albo TOPP wzdłuż ścieżki),
+// a następnie próbkowany do równomiernej tablicy LUT, więc odtwarzanie
+// kosztuje O(1) na klatkę niezależnie od długości ścieżki.
+class TimedTrajectory
+{
+public:
+    static constexpr float SAMPLE_RATE = 250.0f; // próbki LUT na sekundę
+
+    // Ruch punkt-punkt: trapez prędkości dla każdego przegubu,
+    // zsynchronizowany tak, by wszystkie przeguby kończyły jednocześnie
+    void BuildPointToPoint(const float *start, const float *goal, int jointCount,
+                           const std::vector<JointLimit> &limits);
+
+    // Parametryzacja czasowa ścieżki (TOPP): waypoints to kolejne konfiguracje
+    // [waypoint * jointCount + joint]. Prędkość wzdłuż ścieżki jest maksymalna
+    // przy zachowaniu limitów prędkości i przyspieszenia każdego przegubu.
+    bool BuildFromPath(const std::vector<float> &waypoints, int jointCount,
+                       const std::vector<JointLimit> &limits);
+
+    // Kąty przegubów w chwili time (przycinane do [0, duration])
+    void Sample(float time, float *outAngles) const;
+    // Największe |prędkości| przegubów [deg/s] w przedziale [from, to]. Między
+    // próbkami LUT ruch jest liniowy, więc to ścisłe ograniczenie ruchu przegubu.
+    void GetPeakVelocities(float from, float to, float *outVelocities) const;
+
+    float GetDuration() const { return duration; }
+    int GetJointCount() const { return jointCount; }
+    bool IsEmpty() const { return lut.empty(); }
+    void Clear();
+
+private:
+    void ResizeLUT(float newDuration, int joints);
+
+    int jointCount = 0;
+    float duration = 0.0f;
+    std::vector<float> lut; // [sample * jointCount + joint]
+};
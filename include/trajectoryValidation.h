@@ -0,0 +1,24 @@
+#pragma once
+#include "linkCollisionModel.h"
+#include "timedTrajectory.h"
+
+class RobotKinematics;
+
+struct TrajectoryValidation
+{
+    bool collisionFree = true;
+    float contactTime = 0.0f; // [s] pierwszy kontakt, ważne gdy !collisionFree
+    LinkContact contact{};    // ogniwo i przeszkoda w chwili contactTime
+    int steps = 0;            // zapytania odległości we wszystkich porcjach
+    float elapsedMs = 0.0f;
+};
+
+// Ciągła walidacja trajektorii przed wykonaniem (conservative advancement).
+// Trajektoria jest dzielona na porcje liczone równolegle na puli wątków.
+// W każdej porcji prędkość punktów ogniwa ograniczają szczytowe prędkości
+// przegubów (LUT TimedTrajectory) razy zasięg ogniwa od ich osi, więc krok
+// odstęp / prędkość nie może przeskoczyć przeszkody. Kontakt to odstęp kapsuł
+// ogniwa od obiektu sceny lub innego ogniwa poniżej tolerancji.
+// attached - obiekt trzymany przez chwytak; porusza się z ramieniem, więc jest pomijany.
+TrajectoryValidation ValidateTrajectory(const RobotKinematics &kinematics, const LinkCollisionModel &collision,
+                                        const TimedTrajectory &trajectory, const Object3D *attached);
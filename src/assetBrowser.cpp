@@ -41,7 +41,7 @@ void AssetBrowser::ScanDirectory(const std::string &path)
             AssetItem item;
             item.name = entry.path().filename().string();
             item.path = entry.path().string();
-            item.model = LoadModel(item.path.c_str());
+            item.asset = ModelCache::GetInstance().Acquire(item.path.c_str());
             item.config = ModelConfig::LoadFromFile(item.path);
 
             GenerateThumbnail(item);
@@ -113,11 +113,6 @@ void AssetBrowser::GenerateThumbnail(AssetItem &item, bool shouldUnloadOldTextur
         lightController->Update();
     }
 
-    for (int i = 0; i < item.model.materialCount; i++)
-    {
-        item.model.materials[i].shader = shader;
-    }
-
     // Użyj transformacji z konfiguracji
     Matrix transform = MatrixIdentity();
     transform = MatrixMultiply(transform,
@@ -137,8 +132,15 @@ void AssetBrowser::GenerateThumbnail(AssetItem &item, bool shouldUnloadOldTextur
                                    item.config.model.scale,
                                    item.config.model.scale));
 
-    item.model.transform = transform;
-    DrawModel(item.model, Vector3Zero(), 1.0f, WHITE);
+    // Model jest współdzielony - podmiana shadera tylko na kopii materiału
+    const Model &model = item.asset->model;
+    transform = MatrixMultiply(model.transform, transform);
+    for (int i = 0; i < model.meshCount; i++)
+    {
+        Material material = model.materials[model.meshMaterial[i]];
+        material.shader = shader;
+        DrawMesh(model.meshes[i], material, transform);
+    }
 
     EndMode3D();
     EndTextureMode();
@@ -260,7 +262,7 @@ AssetBrowser::~AssetBrowser()
 {
     for (auto &item : assets)
     {
-        UnloadModel(item.model);
+        ModelCache::GetInstance().Release(item.asset);
         UnloadRenderTexture(item.thumbnail);
     }
 
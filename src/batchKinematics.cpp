@@ -0,0 +1,131 @@
+#include "batchKinematics.h"
+#include "robotKinematics.h"
+#include "simd.h"
+
+BatchKinematics::BatchKinematics(const RobotDescription &description, const ArmRotation *meshRotations, float scale)
+    : meshCount(description.GetJointCount()), scale(scale), pivots(meshCount + 1), axes(meshCount)
+{
+    for (int i = 0; i <= meshCount; i++)
+    {
+        pivots[i] = description.joints[i].pivot;
+    }
+    for (int i = 0; i < meshCount; i++)
+    {
+        axes[i] = Vector3Normalize(meshRotations[i].axis);
+    }
+}
+
+int BatchKinematics::GetLaneWidth()
+{
+    return FloatLanes::WIDTH;
+}
+
+const char *BatchKinematics::GetInstructionSet()
+{
+    return SimdInstructionSet();
+}
+
+// Łańcuch to złożenie obrotów wokół lokalnych pivotów: T_i(x) = T_{i-1}(Ra (x - p) + p).
+// Dla transformacji (R, t): R_i = R_{i-1} Ra, t_i = t_{i-1} + R_{i-1} p - R_i p.
+template <typename Lanes>
+void BatchKinematics::EvaluateLanes(const float *angles, int stride, int first,
+                                    float *outX, float *outY, float *outZ, Matrix *linkFrames) const
+{
+    const Lanes one = Lanes::Set(1.0f);
+    const Lanes zero = Lanes::Set(0.0f);
+
+    Lanes r[3][3] = {{one, zero, zero}, {zero, one, zero}, {zero, zero, one}};
+    Lanes t[3] = {zero, zero, zero};
+
+    for (int j = 0; j < meshCount; j++)
+    {
+        Lanes s, c;
+        SinCosDegrees(Lanes::Load(angles + j * stride + first), s, c);
+
+        const Vector3 a = axes[j];
+        const Lanes k = one - c;
+        const Lanes ax = Lanes::Set(a.x), ay = Lanes::Set(a.y), az = Lanes::Set(a.z);
+
+        // Rodrigues: Ra = c I + s [a]x + (1 - c) a a^T
+        Lanes ra[3][3];
+        ra[0][0] = c + k * Lanes::Set(a.x * a.x);
+        ra[0][1] = k * Lanes::Set(a.x * a.y) - s * az;
+        ra[0][2] = k * Lanes::Set(a.x * a.z) + s * ay;
+        ra[1][0] = k * Lanes::Set(a.y * a.x) + s * az;
+        ra[1][1] = c + k * Lanes::Set(a.y * a.y);
+        ra[1][2] = k * Lanes::Set(a.y * a.z) - s * ax;
+        ra[2][0] = k * Lanes::Set(a.z * a.x) - s * ay;
+        ra[2][1] = k * Lanes::Set(a.z * a.y) + s * ax;
+        ra[2][2] = c + k * Lanes::Set(a.z * a.z);
+
+        const Lanes px = Lanes::Set(pivots[j].x), py = Lanes::Set(pivots[j].y), pz = Lanes::Set(pivots[j].z);
+
+        Lanes nr[3][3];
+        for (int row = 0; row < 3; row++)
+        {
+            // t += R p (stara rotacja)
+            t[row] = t[row] + r[row][0] * px + r[row][1] * py + r[row][2] * pz;
+            for (int col = 0; col < 3; col++)
+            {
+                nr[row][col] = r[row][0] * ra[0][col] + r[row][1] * ra[1][col] + r[row][2] * ra[2][col];
+            }
+        }
+        for (int row = 0; row < 3; row++)
+        {
+            // t -= R_new p
+            t[row] = t[row] - (nr[row][0] * px + nr[row][1] * py + nr[row][2] * pz);
+            for (int col = 0; col < 3; col++)
+                r[row][col] = nr[row][col];
+        }
+
+        if (linkFrames)
+        {
+            float lanes[12][Lanes::WIDTH];
+            for (int row = 0; row < 3; row++)
+            {
+                for (int col = 0; col < 3; col++)
+                    r[row][col].Store(lanes[row * 3 + col]);
+                t[row].Store(lanes[9 + row]);
+            }
+            for (int l = 0; l < Lanes::WIDTH; l++)
+            {
+                Matrix &m = linkFrames[(first + l) * meshCount + j];
+                m = MatrixIdentity();
+                m.m0 = lanes[0][l]; m.m4 = lanes[1][l]; m.m8 = lanes[2][l]; m.m12 = lanes[9][l];
+                m.m1 = lanes[3][l]; m.m5 = lanes[4][l]; m.m9 = lanes[5][l]; m.m13 = lanes[10][l];
+                m.m2 = lanes[6][l]; m.m6 = lanes[7][l]; m.m10 = lanes[8][l]; m.m14 = lanes[11][l];
+            }
+        }
+    }
+
+    const Vector3 tcp = pivots[meshCount];
+    const Lanes tx = Lanes::Set(tcp.x), ty = Lanes::Set(tcp.y), tz = Lanes::Set(tcp.z);
+    const Lanes sc = Lanes::Set(scale);
+    ((r[0][0] * tx + r[0][1] * ty + r[0][2] * tz + t[0]) * sc).Store(outX + first);
+    ((r[1][0] * tx + r[1][1] * ty + r[1][2] * tz + t[1]) * sc).Store(outY + first);
+    ((r[2][0] * tx + r[2][1] * ty + r[2][2] * tz + t[2]) * sc).Store(outZ + first);
+}
+
+void BatchKinematics::Evaluate(const float *angles, int stride, int count,
+                               float *outX, float *outY, float *outZ, Matrix *linkFrames) const
+{
+    int i = 0;
+    for (; i + FloatLanes::WIDTH <= count; i += FloatLanes::WIDTH)
+    {
+        EvaluateLanes<FloatLanes>(angles, stride, i, outX, outY, outZ, linkFrames);
+    }
+    // Ogon, który nie wypełnia pełnego rejestru
+    for (; i < count; i++)
+    {
+        EvaluateLanes<ScalarLanes>(angles, stride, i, outX, outY, outZ, linkFrames);
+    }
+}
+
+void BatchKinematics::EvaluateScalar(const float *angles, int stride, int count,
+                                     float *outX, float *outY, float *outZ, Matrix *linkFrames) const
+{
+    for (int i = 0; i < count; i++)
+    {
+        EvaluateLanes<ScalarLanes>(angles, stride, i, outX, outY, outZ, linkFrames);
+    }
+}
@@ -0,0 +1,731 @@
+#include "convexCollision.h"
+#include <algorithm>
+#include <cfloat>
+#include <cstdint>
+#include <initializer_list>
+#include <unordered_map>
+#include <utility>
+
+namespace
+{
+    constexpr int GJK_MAX_ITERATIONS = 64;
+    constexpr int EPA_MAX_ITERATIONS = 64;
+    constexpr int EPA_MAX_FACES = 256;
+    constexpr float GJK_RELATIVE_TOLERANCE = 1e-6f;
+    constexpr float EPA_TOLERANCE = 1e-4f;
+    constexpr float CONTAINS_ORIGIN_SQR = 1e-12f;
+    constexpr float HULL_TOLERANCE = 1e-5f; // względem rozmiaru modelu
+
+    // Punkt różnicy Minkowskiego A - B z punktami źródłowymi do odtworzenia świadków
+    struct SupportPoint
+    {
+        Vector3 w, a, b;
+    };
+
+    SupportPoint MinkowskiSupport(const ConvexShape &shapeA, const ConvexShape &shapeB, Vector3 direction, bool withRadius)
+    {
+        Vector3 a = shapeA.Support(direction, withRadius);
+        Vector3 b = shapeB.Support(Vector3Negate(direction), withRadius);
+        return {Vector3Subtract(a, b), a, b};
+    }
+
+    struct Simplex
+    {
+        SupportPoint points[4];
+        float lambda[4];
+        int count = 0;
+
+        void Keep(std::initializer_list<std::pair<int, float>> kept)
+        {
+            SupportPoint copy[4] = {points[0], points[1], points[2], points[3]};
+            count = 0;
+            for (auto [index, weight] : kept)
+            {
+                points[count] = copy[index];
+                lambda[count++] = weight;
+            }
+        }
+
+        Vector3 Combine(Vector3 SupportPoint::*member) const
+        {
+            Vector3 result = Vector3Zero();
+            for (int i = 0; i < count; i++)
+                result = Vector3Add(result, Vector3Scale(points[i].*member, lambda[i]));
+            return result;
+        }
+    };
+
+    // Najbliższy punkt odcinka/trójkąta do początku układu z redukcją do podzbioru nośnego
+    // (regiony Voronoia jak w ClosestPointOnTriangle, collisionPrimitives.h)
+    void SolveSegment(Simplex &s, int i0, int i1)
+    {
+        Vector3 a = s.points[i0].w, ab = Vector3Subtract(s.points[i1].w, a);
+        float t = -Vector3DotProduct(a, ab) / fmaxf(Vector3DotProduct(ab, ab), FLT_MIN);
+        if (t <= 0.0f)
+            s.Keep({{i0, 1.0f}});
+        else if (t >= 1.0f)
+            s.Keep({{i1, 1.0f}});
+        else
+            s.Keep({{i0, 1.0f - t}, {i1, t}});
+    }
+
+    void SolveTriangle(Simplex &s, int i0, int i1, int i2)
+    {
+        Vector3 a = s.points[i0].w, b = s.points[i1].w, c = s.points[i2].w;
+        Vector3 ab = Vector3Subtract(b, a), ac = Vector3Subtract(c, a);
+        Vector3 ap = Vector3Negate(a), bp = Vector3Negate(b), cp = Vector3Negate(c);
+
+        float d1 = Vector3DotProduct(ab, ap), d2 = Vector3DotProduct(ac, ap);
+        if (d1 <= 0.0f && d2 <= 0.0f)
+            return s.Keep({{i0, 1.0f}});
+
+        float d3 = Vector3DotProduct(ab, bp), d4 = Vector3DotProduct(ac, bp);
+        if (d3 >= 0.0f && d4 <= d3)
+            return s.Keep({{i1, 1.0f}});
+
+        float vc = d1 * d4 - d3 * d2;
+        if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+        {
+            float v = d1 / (d1 - d3);
+            return s.Keep({{i0, 1.0f - v}, {i1, v}});
+        }
+
+        float d5 = Vector3DotProduct(ab, cp), d6 = Vector3DotProduct(ac, cp);
+        if (d6 >= 0.0f && d5 <= d6)
+            return s.Keep({{i2, 1.0f}});
+
+        float vb = d5 * d2 - d1 * d6;
+        if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+        {
+            float w = d2 / (d2 - d6);
+            return s.Keep({{i0, 1.0f - w}, {i2, w}});
+        }
+
+        float va = d3 * d6 - d5 * d4;
+        if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f)
+        {
+            float w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+            return s.Keep({{i1, 1.0f - w}, {i2, w}});
+        }
+
+        float denom = 1.0f / (va + vb + vc);
+        float v = vb * denom, w = vc * denom;
+        s.Keep({{i0, 1.0f - v - w}, {i1, v}, {i2, w}});
+    }
+
+    // false - początek układu wewnątrz czworościanu (przenikanie)
+    bool SolveTetrahedron(Simplex &s)
+    {
+        static const int FACES[4][4] = {{0, 1, 2, 3}, {0, 3, 1, 2}, {0, 2, 3, 1}, {1, 3, 2, 0}};
+        Vector3 p[4] = {s.points[0].w, s.points[1].w, s.points[2].w, s.points[3].w};
+        float volume = Vector3DotProduct(Vector3Subtract(p[3], p[0]),
+                                         Vector3CrossProduct(Vector3Subtract(p[1], p[0]), Vector3Subtract(p[2], p[0])));
+        float size = 0.0f;
+        for (int i = 1; i < 4; i++)
+            size = fmaxf(size, Vector3DistanceSqr(p[i], p[0]));
+        // Prawie płaski czworościan: test stron ścian jest niewiarygodny, sprawdzane są wszystkie
+        bool degenerate = fabsf(volume) < 1e-6f * size * sqrtf(size);
+
+        Simplex best;
+        float bestDistance = FLT_MAX;
+        bool outside = false;
+        for (const auto &face : FACES)
+        {
+            Vector3 a = p[face[0]];
+            Vector3 n = Vector3CrossProduct(Vector3Subtract(p[face[1]], a), Vector3Subtract(p[face[2]], a));
+            float originSide = -Vector3DotProduct(n, a);
+            float oppositeSide = Vector3DotProduct(n, Vector3Subtract(p[face[3]], a));
+            if (!degenerate && originSide * oppositeSide >= 0.0f)
+                continue;
+
+            outside = true;
+            Simplex candidate = s;
+            SolveTriangle(candidate, face[0], face[1], face[2]);
+            Vector3 closest = candidate.Combine(&SupportPoint::w);
+            float distance = Vector3DotProduct(closest, closest);
+            if (distance < bestDistance)
+            {
+                bestDistance = distance;
+                best = candidate;
+            }
+        }
+        if (!outside)
+            return false;
+        s = best;
+        return true;
+    }
+
+    struct GJKResult
+    {
+        bool intersecting = false;
+        Simplex simplex;
+        Vector3 closest; // najbliższy początkowi punkt A - B
+        int iterations = 0;
+    };
+
+    GJKResult RunGJK(const ConvexShape &shapeA, const ConvexShape &shapeB, bool withRadius)
+    {
+        GJKResult result;
+        Simplex &s = result.simplex;
+        s.points[0] = MinkowskiSupport(shapeA, shapeB, {1.0f, 0.0f, 0.0f}, withRadius);
+        s.lambda[0] = 1.0f;
+        s.count = 1;
+        Vector3 v = s.points[0].w;
+
+        for (result.iterations = 1; result.iterations <= GJK_MAX_ITERATIONS; result.iterations++)
+        {
+            float vv = Vector3DotProduct(v, v);
+            if (vv < CONTAINS_ORIGIN_SQR)
+            {
+                result.intersecting = true;
+                break;
+            }
+
+            SupportPoint w = MinkowskiSupport(shapeA, shapeB, Vector3Negate(v), withRadius);
+            bool duplicate = false;
+            for (int i = 0; i < s.count; i++)
+                duplicate |= Vector3Equals(s.points[i].w, w.w);
+            // Brak postępu w kierunku początku - v jest najbliższym punktem
+            if (duplicate || vv - Vector3DotProduct(v, w.w) <= GJK_RELATIVE_TOLERANCE * vv)
+                break;
+
+            Simplex previous = s;
+            s.points[s.count] = w;
+            s.count++;
+            if (s.count == 2)
+                SolveSegment(s, 0, 1);
+            else if (s.count == 3)
+                SolveTriangle(s, 0, 1, 2);
+            else if (!SolveTetrahedron(s))
+            {
+                result.intersecting = true;
+                break;
+            }
+
+            // Brak zbliżenia (błędy zaokrągleń przy prawie płaskim simpleksie) - zostaje poprzedni,
+            // bo z niego liczone są punkty świadkowie
+            Vector3 next = s.Combine(&SupportPoint::w);
+            if (Vector3DotProduct(next, next) >= vv)
+            {
+                s = previous;
+                break;
+            }
+            v = next;
+        }
+        result.closest = v;
+        return result;
+    }
+
+    // Uzupełnia simpleks z GJK do czworościanu o niezerowej objętości (start EPA)
+    bool CompleteTetrahedron(const ConvexShape &shapeA, const ConvexShape &shapeB, Simplex &s)
+    {
+        static const Vector3 AXES[6] = {{1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}};
+        auto tryAdd = [&](Vector3 direction, auto accept)
+        {
+            SupportPoint candidate = MinkowskiSupport(shapeA, shapeB, direction, true);
+            if (!accept(candidate.w))
+                return false;
+            s.points[s.count++] = candidate;
+            return true;
+        };
+
+        if (s.count == 1)
+        {
+            for (const Vector3 &axis : AXES)
+            {
+                if (tryAdd(axis, [&](Vector3 w) { return Vector3DistanceSqr(w, s.points[0].w) > 1e-10f; }))
+                    break;
+            }
+        }
+        if (s.count == 2)
+        {
+            Vector3 edge = Vector3Subtract(s.points[1].w, s.points[0].w);
+            for (const Vector3 &axis : AXES)
+            {
+                Vector3 direction = Vector3CrossProduct(edge, axis);
+                if (Vector3LengthSqr(direction) < 1e-12f)
+                    continue;
+                if (tryAdd(direction, [&](Vector3 w)
+                           { return Vector3LengthSqr(Vector3CrossProduct(edge, Vector3Subtract(w, s.points[0].w))) > 1e-10f; }))
+                    break;
+            }
+        }
+        if (s.count == 3)
+        {
+            Vector3 normal = Vector3CrossProduct(Vector3Subtract(s.points[1].w, s.points[0].w), Vector3Subtract(s.points[2].w, s.points[0].w));
+            auto offPlane = [&](Vector3 w) { return fabsf(Vector3DotProduct(normal, Vector3Subtract(w, s.points[0].w))) > 1e-10f; };
+            if (!tryAdd(normal, offPlane))
+                tryAdd(Vector3Negate(normal), offPlane);
+        }
+        return s.count == 4;
+    }
+
+    struct Face
+    {
+        int index[3];
+        Vector3 normal;
+        float distance;
+    };
+
+    ConvexContact RunEPA(const ConvexShape &shapeA, const ConvexShape &shapeB, const Simplex &start)
+    {
+        std::vector<SupportPoint> vertices(start.points, start.points + 4);
+        std::vector<Face> faces;
+        faces.reserve(64);
+
+        // Orientacja ścian względem środka czworościanu startowego - leży wewnątrz przez całą ekspansję
+        Vector3 interior = Vector3Scale(Vector3Add(Vector3Add(vertices[0].w, vertices[1].w), Vector3Add(vertices[2].w, vertices[3].w)), 0.25f);
+        auto addFace = [&](int i0, int i1, int i2)
+        {
+            Vector3 a = vertices[i0].w;
+            Vector3 n = Vector3CrossProduct(Vector3Subtract(vertices[i1].w, a), Vector3Subtract(vertices[i2].w, a));
+            float length = Vector3Length(n);
+            if (length < 1e-12f)
+                return;
+            n = Vector3Scale(n, 1.0f / length);
+            if (Vector3DotProduct(n, Vector3Subtract(a, interior)) < 0.0f)
+            {
+                n = Vector3Negate(n);
+                std::swap(i1, i2);
+            }
+            faces.push_back({{i0, i1, i2}, n, Vector3DotProduct(n, a)});
+        };
+        addFace(0, 1, 2);
+        addFace(0, 3, 1);
+        addFace(0, 2, 3);
+        addFace(1, 3, 2);
+
+        ConvexContact contact;
+        contact.intersecting = true;
+        std::vector<std::pair<int, int>> horizon;
+        int closest = 0;
+        for (int iteration = 0; iteration < EPA_MAX_ITERATIONS && !faces.empty(); iteration++)
+        {
+            contact.iterations++;
+            closest = 0;
+            for (int i = 1; i < (int)faces.size(); i++)
+            {
+                if (faces[i].distance < faces[closest].distance)
+                    closest = i;
+            }
+            const Face face = faces[closest];
+            SupportPoint w = MinkowskiSupport(shapeA, shapeB, face.normal, true);
+            if (Vector3DotProduct(face.normal, w.w) - face.distance < EPA_TOLERANCE * fmaxf(1.0f, face.distance) ||
+                (int)faces.size() >= EPA_MAX_FACES)
+                break;
+            // Punkt już w wielościanie (płaskie ściany prostopadłościanów) - dalsza ekspansja by go zdegenerowała
+            bool duplicate = false;
+            for (const SupportPoint &vertex : vertices)
+                duplicate |= Vector3DistanceSqr(vertex.w, w.w) < 1e-10f;
+            if (duplicate)
+                break;
+
+            // Usunięcie ścian widocznych z w, brzeg dziury to krawędzie występujące raz.
+            // Ściany współpłaszczyznowe z w też znikają - inaczej w leżące na krawędzi
+            // dałoby zdegenerowany trójkąt i dziurę w wielościanie.
+            vertices.push_back(w);
+            int newIndex = (int)vertices.size() - 1;
+            horizon.clear();
+            for (int i = 0; i < (int)faces.size();)
+            {
+                const Face &f = faces[i];
+                if (Vector3DotProduct(f.normal, Vector3Subtract(w.w, vertices[f.index[0]].w)) <= -1e-6f * fmaxf(1.0f, f.distance))
+                {
+                    i++;
+                    continue;
+                }
+                for (int e = 0; e < 3; e++)
+                {
+                    std::pair<int, int> edge = {f.index[e], f.index[(e + 1) % 3]};
+                    auto shared = std::find(horizon.begin(), horizon.end(), std::make_pair(edge.second, edge.first));
+                    if (shared != horizon.end())
+                        horizon.erase(shared);
+                    else
+                        horizon.push_back(edge);
+                }
+                faces[i] = faces.back();
+                faces.pop_back();
+            }
+            for (auto [from, to] : horizon)
+                addFace(from, to, newIndex);
+            closest = -1;
+        }
+
+        if (closest < 0 || faces.empty())
+        {
+            // Przerwane w trakcie ekspansji - najbliższa z istniejących ścian
+            if (faces.empty())
+                return contact;
+            closest = 0;
+            for (int i = 1; i < (int)faces.size(); i++)
+            {
+                if (faces[i].distance < faces[closest].distance)
+                    closest = i;
+            }
+        }
+
+        const Face &face = faces[closest];
+        Vector3 projection = Vector3Scale(face.normal, face.distance);
+        const SupportPoint &p0 = vertices[face.index[0]], &p1 = vertices[face.index[1]], &p2 = vertices[face.index[2]];
+        Vector3 bary = Vector3Barycenter(projection, p0.w, p1.w, p2.w);
+        contact.pointA = Vector3Add(Vector3Add(Vector3Scale(p0.a, bary.x), Vector3Scale(p1.a, bary.y)), Vector3Scale(p2.a, bary.z));
+        contact.pointB = Vector3Add(Vector3Add(Vector3Scale(p0.b, bary.x), Vector3Scale(p1.b, bary.y)), Vector3Scale(p2.b, bary.z));
+        contact.normal = face.normal;
+        contact.distance = -face.distance;
+        return contact;
+    }
+
+    struct HullFace
+    {
+        int index[3];
+        Vector3 normal;
+        float offset;
+        std::vector<int> outside; // punkty ponad ścianą, jeszcze nie w otoczce
+        bool removed = false;
+    };
+
+    uint64_t EdgeKey(int from, int to) { return (uint64_t)(uint32_t)from << 32 | (uint32_t)to; }
+
+    // Wierzchołki otoczki wypukłej (quickhull). Punkty bliżej płaszczyzny ściany niż
+    // tolerance traktowane są jako wewnętrzne. Pusty wynik - zbiór płaski lub zdegenerowany.
+    std::vector<Vector3> BuildConvexHull(const std::vector<Vector3> &points, float tolerance)
+    {
+        const int count = (int)points.size();
+        if (count < 4)
+            return {};
+
+        // Czworościan startowy: skrajne punkty wzdłuż osi, najdalszy od prostej, najdalszy od płaszczyzny
+        int extreme[6] = {0, 0, 0, 0, 0, 0};
+        for (int i = 1; i < count; i++)
+        {
+            const Vector3 &p = points[i];
+            for (int axis = 0; axis < 3; axis++)
+            {
+                float value = (&p.x)[axis];
+                if (value < (&points[extreme[axis * 2]].x)[axis])
+                    extreme[axis * 2] = i;
+                if (value > (&points[extreme[axis * 2 + 1]].x)[axis])
+                    extreme[axis * 2 + 1] = i;
+            }
+        }
+        int i0 = extreme[0], i1 = extreme[1];
+        for (int axis = 1; axis < 3; axis++)
+        {
+            if (Vector3DistanceSqr(points[extreme[axis * 2]], points[extreme[axis * 2 + 1]]) > Vector3DistanceSqr(points[i0], points[i1]))
+            {
+                i0 = extreme[axis * 2];
+                i1 = extreme[axis * 2 + 1];
+            }
+        }
+        Vector3 axisDirection = Vector3Normalize(Vector3Subtract(points[i1], points[i0]));
+        int i2 = -1;
+        float best = tolerance * tolerance;
+        for (int i = 0; i < count; i++)
+        {
+            Vector3 offset = Vector3Subtract(points[i], points[i0]);
+            float distanceSqr = Vector3LengthSqr(Vector3Subtract(offset, Vector3Scale(axisDirection, Vector3DotProduct(offset, axisDirection))));
+            if (distanceSqr > best)
+            {
+                best = distanceSqr;
+                i2 = i;
+            }
+        }
+        if (i2 < 0)
+            return {};
+        Vector3 planeNormal = Vector3Normalize(Vector3CrossProduct(Vector3Subtract(points[i1], points[i0]), Vector3Subtract(points[i2], points[i0])));
+        int i3 = -1;
+        best = tolerance;
+        for (int i = 0; i < count; i++)
+        {
+            float distance = fabsf(Vector3DotProduct(planeNormal, Vector3Subtract(points[i], points[i0])));
+            if (distance > best)
+            {
+                best = distance;
+                i3 = i;
+            }
+        }
+        if (i3 < 0)
+            return {};
+
+        // Ściany z krawędziami skierowanymi; sąsiad przez krawędź (a, b) ma krawędź (b, a)
+        std::vector<HullFace> faces;
+        std::unordered_map<uint64_t, int> edgeFaces;
+        std::vector<int> pending; // ściany, które mogły dostać punkty zewnętrzne
+        auto addFace = [&](int a, int b, int c)
+        {
+            Vector3 n = Vector3Normalize(Vector3CrossProduct(Vector3Subtract(points[b], points[a]), Vector3Subtract(points[c], points[a])));
+            int face = (int)faces.size();
+            faces.push_back({{a, b, c}, n, Vector3DotProduct(n, points[a]), {}});
+            for (int e = 0; e < 3; e++)
+                edgeFaces[EdgeKey(faces[face].index[e], faces[face].index[(e + 1) % 3])] = face;
+            pending.push_back(face);
+        };
+        auto heightAbove = [&](const HullFace &face, int point)
+        { return Vector3DotProduct(face.normal, points[point]) - face.offset; };
+        // Przydział do pierwszej ściany, nad którą punkt leży; pozostałe są wewnątrz otoczki
+        auto assign = [&](int point, int firstFace)
+        {
+            for (int f = firstFace; f < (int)faces.size(); f++)
+            {
+                if (heightAbove(faces[f], point) > tolerance)
+                {
+                    faces[f].outside.push_back(point);
+                    return;
+                }
+            }
+        };
+
+        // Orientacja ścian czworościanu na zewnątrz - względem jego środka
+        Vector3 interior = Vector3Scale(Vector3Add(Vector3Add(points[i0], points[i1]), Vector3Add(points[i2], points[i3])), 0.25f);
+        bool flip = Vector3DotProduct(planeNormal, Vector3Subtract(points[i0], interior)) < 0.0f;
+        addFace(i0, flip ? i2 : i1, flip ? i1 : i2);
+        addFace(i3, flip ? i1 : i2, flip ? i2 : i1);
+        addFace(i3, flip ? i2 : i0, flip ? i0 : i2);
+        addFace(i3, flip ? i0 : i1, flip ? i1 : i0);
+        for (int i = 0; i < count; i++)
+        {
+            if (i != i0 && i != i1 && i != i2 && i != i3)
+                assign(i, 0);
+        }
+
+        std::vector<int> visible, stack, orphans;
+        std::vector<std::pair<int, int>> horizon;
+        while (!pending.empty())
+        {
+            int seed = pending.back();
+            if (faces[seed].removed || faces[seed].outside.empty())
+            {
+                pending.pop_back();
+                continue;
+            }
+
+            // Najdalszy punkt ponad ścianą jest wierzchołkiem otoczki
+            int apex = faces[seed].outside[0];
+            for (int point : faces[seed].outside)
+            {
+                if (heightAbove(faces[seed], point) > heightAbove(faces[seed], apex))
+                    apex = point;
+            }
+
+            // Spójny obszar ścian widocznych z wierzchołka; jego brzeg to krawędzie do ścian niewidocznych
+            visible.clear();
+            horizon.clear();
+            stack.assign(1, seed);
+            faces[seed].removed = true;
+            while (!stack.empty())
+            {
+                int f = stack.back();
+                stack.pop_back();
+                visible.push_back(f);
+                for (int e = 0; e < 3; e++)
+                {
+                    int from = faces[f].index[e], to = faces[f].index[(e + 1) % 3];
+                    auto shared = edgeFaces.find(EdgeKey(to, from));
+                    if (shared == edgeFaces.end() || faces[shared->second].removed)
+                        continue;
+                    int neighbor = shared->second;
+                    if (heightAbove(faces[neighbor], apex) > tolerance)
+                    {
+                        faces[neighbor].removed = true;
+                        stack.push_back(neighbor);
+                    }
+                    else
+                    {
+                        horizon.push_back({from, to});
+                    }
+                }
+            }
+
+            orphans.clear();
+            for (int f : visible)
+            {
+                for (int e = 0; e < 3; e++)
+                    edgeFaces.erase(EdgeKey(faces[f].index[e], faces[f].index[(e + 1) % 3]));
+                orphans.insert(orphans.end(), faces[f].outside.begin(), faces[f].outside.end());
+                faces[f].outside = {};
+            }
+
+            int firstNew = (int)faces.size();
+            for (auto [from, to] : horizon)
+                addFace(from, to, apex);
+            for (int point : orphans)
+            {
+                if (point != apex)
+                    assign(point, firstNew);
+            }
+        }
+
+        std::vector<char> used(count, 0);
+        for (const HullFace &face : faces)
+        {
+            if (face.removed)
+                continue;
+            for (int index : face.index)
+                used[index] = 1;
+        }
+        std::vector<Vector3> hull;
+        for (int i = 0; i < count; i++)
+        {
+            if (used[i])
+                hull.push_back(points[i]);
+        }
+        return hull;
+    }
+}
+
+ConvexShape ConvexShape::Sphere(Vector3 center, float radius)
+{
+    ConvexShape shape;
+    shape.type = Type::SPHERE;
+    shape.a = shape.b = center;
+    shape.radius = radius;
+    shape.transform = MatrixIdentity();
+    return shape;
+}
+
+ConvexShape ConvexShape::Capsule(Vector3 a, Vector3 b, float radius)
+{
+    ConvexShape shape;
+    shape.type = Type::CAPSULE;
+    shape.a = a;
+    shape.b = b;
+    shape.radius = radius;
+    shape.transform = MatrixIdentity();
+    return shape;
+}
+
+ConvexShape ConvexShape::Box(Vector3 halfExtents, Matrix transform)
+{
+    ConvexShape shape;
+    shape.type = Type::BOX;
+    shape.a = shape.b = halfExtents;
+    shape.transform = transform;
+    return shape;
+}
+
+ConvexShape ConvexShape::Hull(const std::vector<Vector3> &points, Matrix transform)
+{
+    ConvexShape shape;
+    shape.type = Type::HULL;
+    shape.a = shape.b = Vector3Zero();
+    shape.points = &points;
+    shape.transform = transform;
+    return shape;
+}
+
+Vector3 ConvexShape::Support(Vector3 direction, bool withRadius) const
+{
+    // Kierunek w układzie lokalnym: transponowana część liniowa transformacji
+    const Matrix &m = transform;
+    Vector3 local = {m.m0 * direction.x + m.m1 * direction.y + m.m2 * direction.z,
+                     m.m4 * direction.x + m.m5 * direction.y + m.m6 * direction.z,
+                     m.m8 * direction.x + m.m9 * direction.y + m.m10 * direction.z};
+
+    switch (type)
+    {
+    case Type::BOX:
+        return Vector3Transform({local.x >= 0.0f ? a.x : -a.x, local.y >= 0.0f ? a.y : -a.y, local.z >= 0.0f ? a.z : -a.z}, transform);
+
+    case Type::HULL:
+    {
+        if (points->empty())
+            return Vector3Transform(Vector3Zero(), transform);
+        const Vector3 *best = &(*points)[0];
+        float bestDot = -FLT_MAX;
+        for (const Vector3 &p : *points)
+        {
+            float dot = p.x * local.x + p.y * local.y + p.z * local.z;
+            if (dot > bestDot)
+            {
+                bestDot = dot;
+                best = &p;
+            }
+        }
+        return Vector3Transform(*best, transform);
+    }
+
+    default:
+    {
+        Vector3 core = (type == Type::CAPSULE && Vector3DotProduct(Vector3Subtract(b, a), direction) > 0.0f) ? b : a;
+        float length = Vector3Length(direction);
+        if (!withRadius || radius <= 0.0f || length < 1e-12f)
+            return core;
+        return Vector3Add(core, Vector3Scale(direction, radius / length));
+    }
+    }
+}
+
+ConvexContact ComputeConvexContact(const ConvexShape &shapeA, const ConvexShape &shapeB)
+{
+    // Rdzenie rozłączne: odległość z GJK, promienie kul/kapsuł odejmowane analitycznie
+    GJKResult core = RunGJK(shapeA, shapeB, false);
+    if (!core.intersecting)
+    {
+        ConvexContact contact;
+        contact.iterations = core.iterations;
+        float distance = Vector3Length(core.closest);
+        contact.normal = Vector3Scale(core.closest, -1.0f / distance);
+        contact.pointA = Vector3Add(core.simplex.Combine(&SupportPoint::a), Vector3Scale(contact.normal, shapeA.radius));
+        contact.pointB = Vector3Subtract(core.simplex.Combine(&SupportPoint::b), Vector3Scale(contact.normal, shapeB.radius));
+        contact.distance = distance - shapeA.radius - shapeB.radius;
+        contact.intersecting = contact.distance < 0.0f;
+        return contact;
+    }
+
+    // Głębokie przenikanie - EPA na pełnych kształtach, start z simpleksu GJK obejmującego początek
+    GJKResult full = RunGJK(shapeA, shapeB, true);
+    Simplex start = full.simplex;
+    if (!full.intersecting || (start.count < 4 && !CompleteTetrahedron(shapeA, shapeB, start)))
+    {
+        // Styk bez objętości (kształty płaskie lub dotykające się) - zerowa głębokość
+        ConvexContact contact;
+        contact.intersecting = true;
+        contact.iterations = core.iterations + full.iterations;
+        contact.pointA = full.simplex.Combine(&SupportPoint::a);
+        contact.pointB = full.simplex.Combine(&SupportPoint::b);
+        contact.normal = {0.0f, 1.0f, 0.0f};
+        return contact;
+    }
+
+    ConvexContact contact = RunEPA(shapeA, shapeB, start);
+    contact.iterations += core.iterations + full.iterations;
+    return contact;
+}
+
+std::vector<Vector3> CollectHullPoints(const Mesh *meshes, int meshCount)
+{
+    std::vector<Vector3> points;
+    for (int m = 0; m < meshCount; m++)
+    {
+        const Mesh &mesh = meshes[m];
+        if (!mesh.vertices)
+            continue;
+        for (int i = 0; i < mesh.vertexCount; i++)
+            points.push_back({mesh.vertices[i * 3], mesh.vertices[i * 3 + 1], mesh.vertices[i * 3 + 2]});
+    }
+
+    // Wierzchołki glTF są powielane na szwach normalnych/UV
+    auto less = [](const Vector3 &l, const Vector3 &r)
+    { return l.x != r.x ? l.x < r.x : (l.y != r.y ? l.y < r.y : l.z < r.z); };
+    auto equal = [](const Vector3 &l, const Vector3 &r)
+    { return l.x == r.x && l.y == r.y && l.z == r.z; };
+    std::sort(points.begin(), points.end(), less);
+    points.erase(std::unique(points.begin(), points.end(), equal), points.end());
+    if (points.empty())
+        return points;
+
+    // Funkcja podparcia przegląda punkty liniowo - zostają tylko wierzchołki otoczki
+    Vector3 min = points.front(), max = points.front();
+    for (const Vector3 &p : points)
+    {
+        min = Vector3Min(min, p);
+        max = Vector3Max(max, p);
+    }
+    std::vector<Vector3> hull = BuildConvexHull(points, HULL_TOLERANCE * Vector3Distance(min, max));
+    if (hull.empty())
+    {
+        points.shrink_to_fit();
+        return points;
+    }
+    return hull;
+}
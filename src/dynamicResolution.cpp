@@ -0,0 +1,187 @@
+#include "dynamicResolution.h"
+#include "rlImGui.h"
+#include <algorithm>
+#include <cmath>
+
+static float QuantizeScale(float value, float step)
+{
+    return roundf(value / step) * step;
+}
+
+DynamicResolution::DynamicResolution(int width, int height)
+{
+    current = Acquire(width, height);
+    nextWidth = width;
+    nextHeight = height;
+}
+
+void DynamicResolution::BeginScene()
+{
+    // Rozmiar wybrany w poprzedniej klatce; poprzednia tekstura została już wyświetlona i wraca do puli
+    if (current.texture.width != nextWidth || current.texture.height != nextHeight)
+    {
+        Release(current);
+        current = Acquire(nextWidth, nextHeight);
+    }
+    BeginTextureMode(current);
+    sceneStart = std::chrono::steady_clock::now();
+}
+
+void DynamicResolution::EndScene()
+{
+    // EndTextureMode wysyła resztę paczki rlgl, więc pomiar obejmuje całe przejście sceny
+    EndTextureMode();
+    lastSceneMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - sceneStart).count();
+    contentVersion++;
+}
+
+void DynamicResolution::Present(ImVec2 panelSize, TextureFilter filter)
+{
+    nextWidth = std::max(1, (int)(panelSize.x * scale));
+    nextHeight = std::max(1, (int)(panelSize.y * scale));
+
+    // Przy powiększaniu mipmapy nie są próbkowane - wystarczy filtr dwuliniowy
+    Texture2D &texture = current.texture;
+    int effectiveFilter = filter;
+    if (filter == TEXTURE_FILTER_TRILINEAR)
+    {
+        if (texture.width > (int)panelSize.x)
+        {
+            if (mipmapVersion != contentVersion)
+            {
+                GenTextureMipmaps(&texture);
+                mipmapVersion = contentVersion;
+            }
+        }
+        else
+        {
+            effectiveFilter = TEXTURE_FILTER_BILINEAR;
+        }
+    }
+    if (texture.id != filteredTexture || effectiveFilter != appliedFilter)
+    {
+        SetTextureFilter(texture, effectiveFilter);
+        filteredTexture = texture.id;
+        appliedFilter = effectiveFilter;
+    }
+
+    rlImGuiImageRenderTextureFit(&current, true);
+}
+
+void DynamicResolution::EndFrame()
+{
+    smoothedMs = smoothedMs <= 0.0f ? lastSceneMs : smoothedMs + SMOOTHING * (lastSceneMs - smoothedMs);
+    frame++;
+    Trim();
+
+    if (!enabled || ++framesSinceChange < COOLDOWN_FRAMES)
+        return;
+
+    // Koszt wypełniania rośnie z liczbą pikseli, czyli z kwadratem skali
+    float target = scale;
+    if (smoothedMs > budgetMs)
+        target = std::min(QuantizeScale(scale * sqrtf(budgetMs / smoothedMs), SCALE_STEP), scale - SCALE_STEP);
+    else if (smoothedMs < budgetMs * HEADROOM)
+        target = scale + SCALE_STEP;
+    target = std::clamp(QuantizeScale(target, SCALE_STEP), minScale, maxScale);
+    if (target != scale)
+    {
+        scale = target;
+        framesSinceChange = 0;
+    }
+}
+
+void DynamicResolution::Unload()
+{
+    for (PooledTarget &entry : pool)
+        UnloadRenderTexture(entry.target);
+    pool.clear();
+    current = {0};
+    filteredTexture = 0;
+}
+
+RenderTexture2D DynamicResolution::Acquire(int width, int height)
+{
+    for (PooledTarget &entry : pool)
+    {
+        if (!entry.inUse && entry.target.texture.width == width && entry.target.texture.height == height)
+        {
+            entry.inUse = true;
+            poolHits++;
+            return entry.target;
+        }
+    }
+
+    PooledTarget entry;
+    entry.target = LoadRenderTexture(width, height);
+    entry.inUse = true;
+    pool.push_back(entry);
+    allocations++;
+    return entry.target;
+}
+
+void DynamicResolution::Release(const RenderTexture2D &target)
+{
+    for (PooledTarget &entry : pool)
+    {
+        if (entry.target.id == target.id)
+        {
+            entry.target = target; // liczba mipmap mogła się zmienić
+            entry.inUse = false;
+            entry.lastUsedFrame = frame;
+            return;
+        }
+    }
+}
+
+void DynamicResolution::Trim()
+{
+    auto expired = [this](const PooledTarget &entry)
+    { return !entry.inUse && frame - entry.lastUsedFrame > POOL_KEEP_FRAMES; };
+    for (const PooledTarget &entry : pool)
+    {
+        if (expired(entry))
+            UnloadRenderTexture(entry.target);
+    }
+    pool.erase(std::remove_if(pool.begin(), pool.end(), expired), pool.end());
+
+    // Ponad limit - najdawniej używane wolne tekstury
+    while ((int)pool.size() > MAX_POOL_SIZE)
+    {
+        auto oldest = pool.end();
+        for (auto it = pool.begin(); it != pool.end(); ++it)
+        {
+            if (!it->inUse && (oldest == pool.end() || it->lastUsedFrame < oldest->lastUsedFrame))
+                oldest = it;
+        }
+        if (oldest == pool.end())
+            break;
+        UnloadRenderTexture(oldest->target);
+        pool.erase(oldest);
+    }
+}
+
+void DynamicResolution::DrawImGuiControls()
+{
+    if (ImGui::TreeNode("Rozdzielczość dynamiczna"))
+    {
+        ImGui::Checkbox("Automatyczna skala", &enabled);
+        ImGui::SliderFloat("Budżet sceny [ms]", &budgetMs, 1.0f, 30.0f, "%.1f");
+        if (ImGui::SliderFloat("Skala min.", &minScale, 0.25f, 1.0f, "%.2f"))
+            maxScale = std::max(maxScale, minScale);
+        // Skala > 1 to nadpróbkowanie - obraz pomniejszany, z mipmapami przy filtrze trójliniowym
+        if (ImGui::SliderFloat("Skala maks.", &maxScale, 0.25f, 2.0f, "%.2f"))
+            minScale = std::min(minScale, maxScale);
+        if (!enabled)
+            ImGui::SliderFloat("Skala", &scale, minScale, maxScale, "%.2f");
+        scale = std::clamp(QuantizeScale(scale, SCALE_STEP), minScale, maxScale);
+
+        ImGui::Text("Skala: %.2f, tekstura %dx%d", scale, current.texture.width, current.texture.height);
+        ImGui::Text("Czas przejścia sceny: %.2f ms (średnio %.2f ms)", lastSceneMs, smoothedMs);
+        int inUse = (int)std::count_if(pool.begin(), pool.end(), [](const PooledTarget &entry)
+                                       { return entry.inUse; });
+        ImGui::Text("Pula tekstur: %d (w użyciu %d), wczytania: %d, ponowne użycia: %d",
+                    (int)pool.size(), inUse, allocations, poolHits);
+        ImGui::TreePop();
+    }
+}
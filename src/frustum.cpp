@@ -0,0 +1,79 @@
+#include "frustum.h"
+#include "simd.h"
+
+Frustum Frustum::FromMatrix(Matrix m)
+{
+    // Wiersze macierzy przekształcającej wektory kolumnowe (Vector3Transform)
+    const Vector4 row0 = {m.m0, m.m4, m.m8, m.m12};
+    const Vector4 row1 = {m.m1, m.m5, m.m9, m.m13};
+    const Vector4 row2 = {m.m2, m.m6, m.m10, m.m14};
+    const Vector4 row3 = {m.m3, m.m7, m.m11, m.m15};
+
+    // Vector4Add/Subtract są dopiero w nowszym raymath
+    auto combine = [](Vector4 a, Vector4 b, float sign) -> Vector4
+    { return {a.x + sign * b.x, a.y + sign * b.y, a.z + sign * b.z, a.w + sign * b.w}; };
+
+    Frustum frustum;
+    frustum.planes[0] = combine(row3, row0, 1.0f);  // lewa
+    frustum.planes[1] = combine(row3, row0, -1.0f); // prawa
+    frustum.planes[2] = combine(row3, row1, 1.0f);  // dolna
+    frustum.planes[3] = combine(row3, row1, -1.0f); // górna
+    frustum.planes[4] = combine(row3, row2, 1.0f);  // bliska
+    frustum.planes[5] = combine(row3, row2, -1.0f); // daleka
+    for (Vector4 &plane : frustum.planes)
+    {
+        float length = sqrtf(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+        if (length > 0.0f)
+            plane = {plane.x / length, plane.y / length, plane.z / length, plane.w / length};
+    }
+    return frustum;
+}
+
+bool Frustum::IntersectsSphere(Vector3 center, float radius) const
+{
+    for (const Vector4 &plane : planes)
+    {
+        if (plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w < -radius)
+            return false;
+    }
+    return true;
+}
+
+// Najmniejszy po płaszczyznach odstęp środka od płaszczyzny powiększony o promień; < 0 - kula poza frustum
+template <typename Lanes>
+static Lanes SphereMargin(const Vector4 *planes, const float *x, const float *y, const float *z, const float *radius, int i)
+{
+    Lanes cx = Lanes::Load(x + i), cy = Lanes::Load(y + i), cz = Lanes::Load(z + i);
+    Lanes margin = Lanes::Set(INFINITY);
+    for (int p = 0; p < 6; p++)
+    {
+        Lanes distance = Lanes::Set(planes[p].x) * cx + Lanes::Set(planes[p].y) * cy + Lanes::Set(planes[p].z) * cz +
+                         Lanes::Set(planes[p].w);
+        margin = Min(margin, distance);
+    }
+    return margin + Lanes::Load(radius + i);
+}
+
+void Frustum::CullSpheres(const float *x, const float *y, const float *z, const float *radius, int count,
+                          std::vector<int> &visible) const
+{
+    visible.clear();
+    int i = 0;
+    float margins[FloatLanes::WIDTH];
+    for (; i + FloatLanes::WIDTH <= count; i += FloatLanes::WIDTH)
+    {
+        SphereMargin<FloatLanes>(planes, x, y, z, radius, i).Store(margins);
+        for (int lane = 0; lane < FloatLanes::WIDTH; lane++)
+        {
+            if (margins[lane] >= 0.0f)
+                visible.push_back(i + lane);
+        }
+    }
+    for (; i < count; i++)
+    {
+        float margin;
+        SphereMargin<ScalarLanes>(planes, x, y, z, radius, i).Store(&margin);
+        if (margin >= 0.0f)
+            visible.push_back(i);
+    }
+}
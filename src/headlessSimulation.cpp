@@ -0,0 +1,231 @@
+#include "headlessSimulation.h"
+#include "modelLoader.h"
+#include "modelCache.h"
+#include "robotArm.h"
+#include "luaController.h"
+#include "sceneLoader.h"
+#include "logWindow.h"
+#include <nlohmann/json.hpp>
+#include <cfloat>
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+using json = nlohmann::json;
+
+namespace
+{
+    // Komunikaty raylib na stderr - stdout zostaje dla raportu JSON
+    void StderrTraceLog(int logLevel, const char *text, va_list args)
+    {
+        static const char *LEVELS[] = {"", "TRACE", "DEBUG", "INFO", "WARNING", "ERROR", "FATAL", ""};
+        fprintf(stderr, "%s: ", LEVELS[logLevel >= 0 && logLevel < 8 ? logLevel : 0]);
+        vfprintf(stderr, text, args);
+        fprintf(stderr, "\n");
+    }
+
+    void PrintUsage()
+    {
+        fprintf(stderr, "Użycie: robolab --headless --script program.lua [--scene scena.scn] [--robot model.glb]\n"
+                        "                [--dt krok_s] [--max-time limit_s] [--report raport.json] [--verbose]\n");
+    }
+
+    int WriteReport(const json &report, const std::string &path)
+    {
+        if (path.empty())
+        {
+            printf("%s\n", report.dump(4).c_str());
+            return 0;
+        }
+        std::ofstream file(path);
+        if (!file.is_open())
+        {
+            fprintf(stderr, "Nie można zapisać raportu: %s\n", path.c_str());
+            return 2;
+        }
+        file << report.dump(4);
+        return 0;
+    }
+}
+
+bool HeadlessSimulation::IsRequested(int argc, char **argv)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--headless") == 0)
+            return true;
+    }
+    return false;
+}
+
+bool HeadlessSimulation::ParseArguments(int argc, char **argv, HeadlessOptions &options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--headless")
+            continue;
+        if (arg == "--verbose")
+        {
+            options.verbose = true;
+            continue;
+        }
+
+        if (i + 1 >= argc)
+        {
+            fprintf(stderr, "Brak wartości dla %s\n", arg.c_str());
+            PrintUsage();
+            return false;
+        }
+        std::string value = argv[++i];
+        if (arg == "--script")
+            options.scriptPath = value;
+        else if (arg == "--scene")
+            options.scenePath = value;
+        else if (arg == "--robot")
+            options.robotPath = value;
+        else if (arg == "--report")
+            options.reportPath = value;
+        else if (arg == "--dt")
+            options.timeStep = strtof(value.c_str(), nullptr);
+        else if (arg == "--max-time")
+            options.maxSimTime = strtof(value.c_str(), nullptr);
+        else
+        {
+            fprintf(stderr, "Nieznany argument: %s\n", arg.c_str());
+            PrintUsage();
+            return false;
+        }
+    }
+
+    if (options.scriptPath.empty() || options.timeStep <= 0.0f || options.maxSimTime <= 0.0f)
+    {
+        PrintUsage();
+        return false;
+    }
+    return true;
+}
+
+int HeadlessSimulation::Run()
+{
+    SetTraceLogCallback(StderrTraceLog);
+    SetTraceLogLevel(options.verbose ? LOG_INFO : LOG_WARNING);
+    ModelLoader::SetHeadless(true);
+
+    LogWindow &logWindow = LogWindow::GetInstance();
+    logWindow.SetConsoleEcho(true, options.verbose ? LogLevel::Info : LogLevel::Warning);
+
+    json report;
+    report["script"] = options.scriptPath;
+    report["scene"] = options.scenePath;
+    report["timeStep"] = options.timeStep;
+
+    std::ifstream scriptFile(options.scriptPath);
+    if (!scriptFile.is_open() || !fs::exists(options.robotPath))
+    {
+        report["status"] = "error";
+        report["error"] = scriptFile.is_open() ? "Brak modelu robota: " + options.robotPath
+                                               : "Nie można otworzyć skryptu: " + options.scriptPath;
+        WriteReport(report, options.reportPath);
+        return 2;
+    }
+    std::stringstream code;
+    code << scriptFile.rdbuf();
+
+    // Bez kontekstu GL shader jest pusty - obiekty i robot nie są rysowane
+    Shader shader = {0};
+    std::vector<Object3D *> sceneObjects;
+    if (!options.scenePath.empty())
+    {
+        SceneLoader sceneLoader;
+        if (!sceneLoader.LoadSceneFromPath(options.scenePath, sceneObjects, shader))
+        {
+            report["status"] = "error";
+            report["error"] = "Nie można wczytać sceny: " + options.scenePath;
+            WriteReport(report, options.reportPath);
+            return 2;
+        }
+    }
+
+    // Te same ustawienia robota co w trybie okienkowym
+    RobotArm robotArm(options.robotPath.c_str(), shader);
+    robotArm.SetScale(0.005f);
+
+    LuaController luaController(robotArm, logWindow);
+    std::string status = "completed";
+    long long steps = 0;
+    double simTime = 0.0;
+
+    auto wallStart = std::chrono::steady_clock::now();
+    if (luaController.LoadScript(code.str()))
+    {
+        luaController.SetStepMode(false);
+        luaController.Run();
+
+        // Kolejność jak w pętli okna: Lua, ruch robota, kolizje
+        while (luaController.IsRunning() || robotArm.IsAnimating())
+        {
+            if (simTime >= options.maxSimTime)
+            {
+                status = "timeout";
+                break;
+            }
+            luaController.Update(options.timeStep);
+            robotArm.Update(options.timeStep);
+            robotArm.CheckCollisions();
+            simTime += options.timeStep;
+            steps++;
+        }
+    }
+    double wallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+
+    if (!luaController.GetLastError().empty())
+    {
+        status = "error";
+        report["error"] = luaController.GetLastError();
+    }
+
+    report["status"] = status;
+    report["simTime"] = simTime;
+    report["wallTime"] = wallTime;
+    report["steps"] = steps;
+    report["stepsPerSecond"] = wallTime > 0.0 ? steps / wallTime : 0.0;
+    report["realTimeFactor"] = wallTime > 0.0 ? simTime / wallTime : 0.0;
+    report["collisions"] = robotArm.GetCollisionCount();
+    report["gripping"] = robotArm.IsGripping();
+    report["linkCollisions"] = robotArm.GetLinkCollisionCount();
+    if (robotArm.GetMinLinkDistance() < FLT_MAX)
+        report["minLinkDistance"] = robotArm.GetMinLinkDistance();
+    else
+        report["minLinkDistance"] = nullptr;
+    report["motionPlanning"] = {{"plans", robotArm.GetMotionPlanCount()},
+                                {"failures", robotArm.GetMotionPlanFailures()},
+                                {"avgPlanningMs", robotArm.GetAveragePlanningMs()},
+                                {"maxPlanningMs", robotArm.GetMaxPlanningMs()}};
+    ModelCache &modelCache = ModelCache::GetInstance();
+    report["models"] = {{"unique", modelCache.GetAssetCount()},
+                        {"instances", modelCache.GetReferenceCount()},
+                        {"loadMs", modelCache.GetTotalLoadTime() * 1000.0f}};
+
+    json joints = json::array();
+    for (int i = 0; i < robotArm.GetMeshCount(); i++)
+    {
+        joints.push_back({{"name", robotArm.GetDescription().names[i]}, {"angle", robotArm.GetMeshRotation(i)}});
+    }
+    report["joints"] = joints;
+    Vector3 tcp = robotArm.GetKinematics()->CalculateEndEffectorPosition();
+    report["endEffector"] = {tcp.x, tcp.y, tcp.z};
+
+    robotArm.ReleaseObject();
+    for (auto *obj : sceneObjects)
+    {
+        delete obj;
+    }
+
+    if (WriteReport(report, options.reportPath) != 0)
+        return 2;
+    return status == "completed" ? 0 : 1;
+}
@@ -0,0 +1,254 @@
+#include "ikSeedDatabase.h"
+#include "robotKinematics.h"
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <chrono>
+
+namespace
+{
+    const char MAGIC[4] = {'I', 'K', 'D', 'B'};
+    const uint32_t VERSION = 1;
+
+    struct FileHeader
+    {
+        char magic[4];
+        uint32_t version;
+        uint64_t configHash;
+        int32_t sampleCount;
+        int32_t jointCount;
+    };
+
+    float Axis(const Vector3 &v, int axis)
+    {
+        return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+    }
+}
+
+bool IKSeedDatabase::LoadOrBuild(const fs::path &configDir, const RobotKinematics &kinematics)
+{
+    fs::path path = configDir / "ikseeds.bin";
+    if (Load(path, kinematics.GetConfigHash()))
+    {
+        return true;
+    }
+
+    Build(kinematics);
+    fs::create_directories(configDir);
+    if (!Save(path))
+    {
+        TraceLog(LOG_WARNING, "Nie udało się zapisać bazy punktów startowych IK: %s", path.string().c_str());
+    }
+    return IsLoaded();
+}
+
+void IKSeedDatabase::Build(const RobotKinematics &kinematics, int sampleCount)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    jointCount = kinematics.GetMeshCount();
+    configHash = kinematics.GetConfigHash();
+
+    const int CHUNK = 8192;
+    BatchKinematics fk = kinematics.CreateBatchKinematics();
+    const float invScale = 1.0f / kinematics.GetScale();
+
+    std::mt19937 rng(4321);
+    std::vector<std::uniform_real_distribution<float>> distributions;
+    for (int j = 0; j < jointCount; j++)
+    {
+        const JointLimit &limit = kinematics.GetJointLimit(j);
+        distributions.emplace_back(limit.min, limit.max);
+    }
+
+    std::vector<Vector3> samplePositions(sampleCount);
+    std::vector<Quaternion> sampleRotations(sampleCount);
+    std::vector<float> sampleAngles(sampleCount * jointCount);
+
+    std::vector<float> chunkAngles(jointCount * CHUNK);
+    std::vector<float> x(CHUNK), y(CHUNK), z(CHUNK);
+    std::vector<Matrix> frames(CHUNK * jointCount);
+
+    for (int done = 0; done < sampleCount; done += CHUNK)
+    {
+        int count = std::min(CHUNK, sampleCount - done);
+        for (int j = 0; j < jointCount; j++)
+        {
+            for (int c = 0; c < count; c++)
+                chunkAngles[j * CHUNK + c] = distributions[j](rng);
+        }
+        fk.Evaluate(chunkAngles.data(), CHUNK, count, x.data(), y.data(), z.data(), frames.data());
+
+        for (int c = 0; c < count; c++)
+        {
+            int s = done + c;
+            samplePositions[s] = {x[c] * invScale, y[c] * invScale, z[c] * invScale};
+            sampleRotations[s] = QuaternionFromMatrix(frames[c * jointCount + jointCount - 1]);
+            for (int j = 0; j < jointCount; j++)
+                sampleAngles[s * jointCount + j] = chunkAngles[j * CHUNK + c];
+        }
+    }
+
+    // Budowa drzewa na indeksach, potem jednorazowe przestawienie danych
+    positions.swap(samplePositions);
+    std::vector<int> order(sampleCount);
+    std::iota(order.begin(), order.end(), 0);
+    BuildTree(0, sampleCount, 0, order);
+
+    std::vector<Vector3> sortedPositions(sampleCount);
+    rotations.resize(sampleCount);
+    angles.resize(sampleAngles.size());
+    for (int i = 0; i < sampleCount; i++)
+    {
+        sortedPositions[i] = positions[order[i]];
+        rotations[i] = sampleRotations[order[i]];
+        std::copy_n(&sampleAngles[order[i] * jointCount], jointCount, &angles[i * jointCount]);
+    }
+    positions.swap(sortedPositions);
+
+    buildTime = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+    TraceLog(LOG_INFO, "Baza punktów startowych IK zbudowana: %d próbek, %.2f s", sampleCount, buildTime);
+}
+
+void IKSeedDatabase::BuildTree(int begin, int end, int depth, std::vector<int> &order)
+{
+    if (end - begin <= 1)
+        return;
+
+    int mid = (begin + end) / 2;
+    int axis = depth % 3;
+    std::nth_element(order.begin() + begin, order.begin() + mid, order.begin() + end,
+                     [&](int a, int b) { return Axis(positions[a], axis) < Axis(positions[b], axis); });
+
+    BuildTree(begin, mid, depth + 1, order);
+    BuildTree(mid + 1, end, depth + 1, order);
+}
+
+void IKSeedDatabase::Search(int begin, int end, int depth, const Vector3 &point,
+                            int *best, float *bestDistance, int &found, int maxFound) const
+{
+    if (begin >= end)
+        return;
+
+    int mid = (begin + end) / 2;
+    float distance = Vector3DistanceSqr(point, positions[mid]);
+
+    // Wstawienie do posortowanej listy najbliższych
+    if (found < maxFound || distance < bestDistance[found - 1])
+    {
+        int i = (found < maxFound) ? found++ : found - 1;
+        while (i > 0 && bestDistance[i - 1] > distance)
+        {
+            best[i] = best[i - 1];
+            bestDistance[i] = bestDistance[i - 1];
+            i--;
+        }
+        best[i] = mid;
+        bestDistance[i] = distance;
+    }
+
+    int axis = depth % 3;
+    float diff = Axis(point, axis) - Axis(positions[mid], axis);
+    if (diff < 0.0f)
+    {
+        Search(begin, mid, depth + 1, point, best, bestDistance, found, maxFound);
+        if (found < maxFound || diff * diff < bestDistance[found - 1])
+            Search(mid + 1, end, depth + 1, point, best, bestDistance, found, maxFound);
+    }
+    else
+    {
+        Search(mid + 1, end, depth + 1, point, best, bestDistance, found, maxFound);
+        if (found < maxFound || diff * diff < bestDistance[found - 1])
+            Search(begin, mid, depth + 1, point, best, bestDistance, found, maxFound);
+    }
+}
+
+bool IKSeedDatabase::FindSeed(const Vector3 &modelPosition, const Matrix *targetRotation, float *outAngles,
+                              float positionWeight) const
+{
+    if (positions.empty())
+        return false;
+
+    int best[MAX_CANDIDATES];
+    float bestDistance[MAX_CANDIDATES];
+    int found = 0;
+    int maxFound = targetRotation ? MAX_CANDIDATES : 1;
+    Search(0, (int)positions.size(), 0, modelPosition, best, bestDistance, found, maxFound);
+
+    int chosen = best[0];
+    if (targetRotation)
+    {
+        Quaternion target = QuaternionFromMatrix(*targetRotation);
+        float bestCost = INFINITY;
+        for (int i = 0; i < found; i++)
+        {
+            const Quaternion &q = rotations[best[i]];
+            float dot = fabsf(target.x * q.x + target.y * q.y + target.z * q.z + target.w * q.w);
+            float angle = 2.0f * acosf(fminf(dot, 1.0f));
+            float cost = sqrtf(bestDistance[i]) + positionWeight * angle;
+            if (cost < bestCost)
+            {
+                bestCost = cost;
+                chosen = best[i];
+            }
+        }
+    }
+
+    std::copy_n(&angles[chosen * jointCount], jointCount, outAngles);
+    return true;
+}
+
+bool IKSeedDatabase::Load(const fs::path &path, uint64_t expectedHash)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open())
+        return false;
+
+    FileHeader header;
+    if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)))
+        return false;
+    if (memcmp(header.magic, MAGIC, 4) != 0 || header.version != VERSION ||
+        header.configHash != expectedHash || header.sampleCount <= 0 || header.jointCount <= 0)
+    {
+        return false;
+    }
+
+    std::vector<Vector3> filePositions(header.sampleCount);
+    std::vector<Quaternion> fileRotations(header.sampleCount);
+    std::vector<float> fileAngles((size_t)header.sampleCount * header.jointCount);
+    if (!file.read(reinterpret_cast<char *>(filePositions.data()), filePositions.size() * sizeof(Vector3)) ||
+        !file.read(reinterpret_cast<char *>(fileRotations.data()), fileRotations.size() * sizeof(Quaternion)) ||
+        !file.read(reinterpret_cast<char *>(fileAngles.data()), fileAngles.size() * sizeof(float)))
+    {
+        return false;
+    }
+
+    configHash = header.configHash;
+    jointCount = header.jointCount;
+    positions.swap(filePositions);
+    rotations.swap(fileRotations);
+    angles.swap(fileAngles);
+    return true;
+}
+
+bool IKSeedDatabase::Save(const fs::path &path) const
+{
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open())
+        return false;
+
+    FileHeader header;
+    memcpy(header.magic, MAGIC, 4);
+    header.version = VERSION;
+    header.configHash = configHash;
+    header.sampleCount = (int32_t)positions.size();
+    header.jointCount = jointCount;
+
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(positions.data()), positions.size() * sizeof(Vector3));
+    file.write(reinterpret_cast<const char *>(rotations.data()), rotations.size() * sizeof(Quaternion));
+    file.write(reinterpret_cast<const char *>(angles.data()), angles.size() * sizeof(float));
+    return file.good();
+}
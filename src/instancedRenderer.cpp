@@ -0,0 +1,227 @@
+#include "instancedRenderer.h"
+#include "modelCache.h"
+#include "rlgl.h"
+#include <algorithm>
+
+int InstancedRenderer::CreateInstance(const ModelAsset *asset, Shader shader, Matrix transform, Color color, Vector4 bounds)
+{
+    Group &group = groups[{asset, shader.id}];
+    if (!group.asset)
+    {
+        group.asset = asset;
+        group.shader = shader;
+    }
+
+    int instanceId;
+    if (freeInstance >= 0)
+    {
+        instanceId = freeInstance;
+        freeInstance = instances[instanceId].slot;
+    }
+    else
+    {
+        instanceId = (int)instances.size();
+        instances.push_back({});
+    }
+
+    instances[instanceId] = {&group, (int)group.data.size()};
+    group.data.push_back({});
+    group.owners.push_back(instanceId);
+    group.boundsX.push_back(0.0f);
+    group.boundsY.push_back(0.0f);
+    group.boundsZ.push_back(0.0f);
+    group.boundsRadius.push_back(0.0f);
+    group.lodLevel.push_back(NO_LEVEL);
+    instanceCount++;
+    UpdateInstance(instanceId, transform, color, bounds);
+    return instanceId;
+}
+
+void InstancedRenderer::DestroyInstance(int instanceId)
+{
+    if (instanceId < 0 || instanceId >= (int)instances.size() || !instances[instanceId].group)
+        return;
+
+    // Ostatni slot grupy przechodzi na miejsce usuwanego - bufor pozostaje ciągły
+    Group &group = *instances[instanceId].group;
+    int slot = instances[instanceId].slot;
+    int last = (int)group.data.size() - 1;
+    if (slot != last)
+    {
+        group.data[slot] = group.data[last];
+        group.owners[slot] = group.owners[last];
+        group.boundsX[slot] = group.boundsX[last];
+        group.boundsY[slot] = group.boundsY[last];
+        group.boundsZ[slot] = group.boundsZ[last];
+        group.boundsRadius[slot] = group.boundsRadius[last];
+        group.lodLevel[slot] = group.lodLevel[last];
+        instances[group.owners[slot]].slot = slot;
+        MarkDirty(group, slot);
+    }
+    group.data.pop_back();
+    group.owners.pop_back();
+    group.boundsX.pop_back();
+    group.boundsY.pop_back();
+    group.boundsZ.pop_back();
+    group.boundsRadius.pop_back();
+    group.lodLevel.pop_back();
+
+    instances[instanceId] = {nullptr, freeInstance};
+    freeInstance = instanceId;
+    instanceCount--;
+
+    if (group.data.empty())
+    {
+        ReleaseBuffers(group);
+        groups.erase({group.asset, group.shader.id});
+    }
+}
+
+void InstancedRenderer::UpdateInstance(int instanceId, Matrix transform, Color color, Vector4 bounds)
+{
+    if (instanceId < 0 || instanceId >= (int)instances.size() || !instances[instanceId].group)
+        return;
+
+    Group &group = *instances[instanceId].group;
+    int slot = instances[instanceId].slot;
+    // Transformacja z pliku modelu wpieczona w macierz instancji (jak w DrawModel)
+    group.data[slot].transform = MatrixToFloatV(MatrixMultiply(group.asset->model.transform, transform));
+    group.data[slot].color = ColorNormalize(color);
+    group.boundsX[slot] = bounds.x;
+    group.boundsY[slot] = bounds.y;
+    group.boundsZ[slot] = bounds.z;
+    group.boundsRadius[slot] = bounds.w;
+    MarkDirty(group, slot);
+}
+
+void InstancedRenderer::MarkDirty(Group &group, int slot)
+{
+    if (group.dirtyBegin == group.dirtyEnd)
+    {
+        group.dirtyBegin = slot;
+        group.dirtyEnd = slot + 1;
+        return;
+    }
+    group.dirtyBegin = std::min(group.dirtyBegin, slot);
+    group.dirtyEnd = std::max(group.dirtyEnd, slot + 1);
+}
+
+void InstancedRenderer::Upload(Group &group)
+{
+    const int count = (int)group.data.size();
+    if (count > group.capacity)
+    {
+        // Zapas, żeby dodawanie obiektów nie realokowało bufora co klatkę
+        if (group.vboId != 0)
+            rlUnloadVertexBuffer(group.vboId);
+        group.capacity = std::max(MIN_CAPACITY, count * 2);
+        group.vboId = rlLoadVertexBuffer(nullptr, group.capacity * (int)sizeof(RenderInstance), true);
+        group.dirtyBegin = 0;
+        group.dirtyEnd = count;
+    }
+
+    group.dirtyEnd = std::min(group.dirtyEnd, count);
+    if (group.dirtyBegin < group.dirtyEnd)
+    {
+        int bytes = (group.dirtyEnd - group.dirtyBegin) * (int)sizeof(RenderInstance);
+        rlUpdateVertexBuffer(group.vboId, group.data.data() + group.dirtyBegin, bytes,
+                             group.dirtyBegin * (int)sizeof(RenderInstance));
+        uploadedBytes += bytes;
+    }
+    group.dirtyBegin = group.dirtyEnd = 0;
+}
+
+void InstancedRenderer::UploadVisible(Group &group, int level, const std::vector<int> &slots)
+{
+    visibleData.resize(slots.size());
+    for (size_t i = 0; i < slots.size(); i++)
+        visibleData[i] = group.data[slots[i]];
+
+    const int count = (int)visibleData.size();
+    unsigned int &vboId = group.visibleVboId[level];
+    int &capacity = group.visibleCapacity[level];
+    if (count > capacity)
+    {
+        if (vboId != 0)
+            rlUnloadVertexBuffer(vboId);
+        capacity = std::max(MIN_CAPACITY, count * 2);
+        vboId = rlLoadVertexBuffer(nullptr, capacity * (int)sizeof(RenderInstance), true);
+    }
+    int bytes = count * (int)sizeof(RenderInstance);
+    rlUpdateVertexBuffer(vboId, visibleData.data(), bytes, 0);
+    uploadedBytes += bytes;
+}
+
+void InstancedRenderer::ReleaseBuffers(Group &group)
+{
+    if (group.vboId != 0)
+        rlUnloadVertexBuffer(group.vboId);
+    group.vboId = 0;
+    group.capacity = 0;
+    for (int level = 0; level < ModelLod::MAX_LEVELS; level++)
+    {
+        if (group.visibleVboId[level] != 0)
+            rlUnloadVertexBuffer(group.visibleVboId[level]);
+        group.visibleVboId[level] = 0;
+        group.visibleCapacity[level] = 0;
+    }
+}
+
+void InstancedRenderer::Submit()
+{
+    uploadedBytes = 0;
+    visibleCount = 0;
+    RenderQueue &queue = RenderQueue::GetInstance();
+    const Frustum &frustum = queue.GetFrustum();
+    for (auto &entry : groups)
+    {
+        Group &group = entry.second;
+        const int count = (int)group.data.size();
+        // Trwały bufor zawsze aktualny - przy zmianie widoku wystarczy go narysować
+        Upload(group);
+
+        frustum.CullSpheres(group.boundsX.data(), group.boundsY.data(), group.boundsZ.data(),
+                            group.boundsRadius.data(), count, visible);
+        queue.AddCulled(count - (int)visible.size());
+        visibleCount += (int)visible.size();
+        if (visible.empty())
+            continue;
+
+        // Poziom szczegółowości każdej widocznej instancji, z histerezą względem poprzedniego
+        const ModelAsset &asset = *group.asset;
+        int usedLevels = 0, lastLevel = 0;
+        for (std::vector<int> &slots : levelSlots)
+            slots.clear();
+        for (int slot : visible)
+        {
+            int previous = group.lodLevel[slot] == NO_LEVEL ? -1 : group.lodLevel[slot];
+            int level = queue.SelectLod(asset.lod, {group.boundsX[slot], group.boundsY[slot], group.boundsZ[slot]},
+                                        group.boundsRadius[slot], previous);
+            group.lodLevel[slot] = (uint8_t)level;
+            if (levelSlots[level].empty())
+                usedLevels++;
+            levelSlots[level].push_back(slot);
+            lastLevel = level;
+        }
+
+        // Jeden poziom i większość grupy w kadrze - cały trwały bufor
+        if (usedLevels == 1 && (int)visible.size() >= COMPACT_FRACTION * count)
+        {
+            for (int m = 0; m < asset.model.meshCount; m++)
+                queue.SubmitInstanced(asset.lod.GetMesh(asset.model, lastLevel, m), group.shader, group.vboId, count);
+            continue;
+        }
+
+        for (int level = 0; level < ModelLod::MAX_LEVELS; level++)
+        {
+            if (levelSlots[level].empty())
+                continue;
+            UploadVisible(group, level, levelSlots[level]);
+            for (int m = 0; m < asset.model.meshCount; m++)
+            {
+                queue.SubmitInstanced(asset.lod.GetMesh(asset.model, level, m), group.shader, group.visibleVboId[level],
+                                      (int)levelSlots[level].size());
+            }
+        }
+    }
+}
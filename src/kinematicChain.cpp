@@ -0,0 +1,51 @@
+#include "kinematicChain.h"
+
+namespace
+{
+    // Znane konfiguracje; kolejne roboty wystarczy dopisać do tabeli
+    const ChainAxis BUNDLED_ARM[] = {ChainAxis::Y, ChainAxis::Y, ChainAxis::Z, ChainAxis::Z, ChainAxis::X, ChainAxis::Z};
+    const ChainAxis INDUSTRIAL_6R[] = {ChainAxis::Y, ChainAxis::Z, ChainAxis::Z, ChainAxis::X, ChainAxis::Z, ChainAxis::X};
+    const ChainAxis SCARA_4[] = {ChainAxis::Y, ChainAxis::Y, ChainAxis::Y, ChainAxis::Y};
+
+    struct ChainEntry
+    {
+        const ChainAxis *axes;
+        int count;
+        KinematicChainSpec spec;
+    };
+
+    const ChainEntry CHAINS[] = {
+        {BUNDLED_ARM, 6, {"YYZZXZ", &KinematicChain<6, ChainAxis::Y, ChainAxis::Y, ChainAxis::Z, ChainAxis::Z, ChainAxis::X, ChainAxis::Z>::Forward}},
+        {INDUSTRIAL_6R, 6, {"YZZXZX", &KinematicChain<6, ChainAxis::Y, ChainAxis::Z, ChainAxis::Z, ChainAxis::X, ChainAxis::Z, ChainAxis::X>::Forward}},
+        {SCARA_4, 4, {"YYYY", &KinematicChain<4, ChainAxis::Y, ChainAxis::Y, ChainAxis::Y, ChainAxis::Y>::Forward}},
+    };
+
+    bool ClassifyAxis(const Vector3 &axis, ChainAxis &out)
+    {
+        const float EPS = 1e-6f;
+        if (fabsf(axis.x - 1.0f) < EPS && fabsf(axis.y) < EPS && fabsf(axis.z) < EPS) out = ChainAxis::X;
+        else if (fabsf(axis.x) < EPS && fabsf(axis.y - 1.0f) < EPS && fabsf(axis.z) < EPS) out = ChainAxis::Y;
+        else if (fabsf(axis.x) < EPS && fabsf(axis.y) < EPS && fabsf(axis.z - 1.0f) < EPS) out = ChainAxis::Z;
+        else return false;
+        return true;
+    }
+}
+
+const KinematicChainSpec *SelectKinematicChain(const ArmRotation *rotations, int meshCount)
+{
+    for (const ChainEntry &entry : CHAINS)
+    {
+        if (entry.count != meshCount)
+            continue;
+
+        bool match = true;
+        for (int i = 0; i < meshCount && match; i++)
+        {
+            ChainAxis axis;
+            match = ClassifyAxis(rotations[i].axis, axis) && axis == entry.axes[i];
+        }
+        if (match)
+            return &entry.spec;
+    }
+    return nullptr;
+}
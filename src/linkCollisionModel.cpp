@@ -0,0 +1,361 @@
+#include "linkCollisionModel.h"
+#include "collisionPrimitives.h"
+#include "sceneBroadphase.h"
+#include "object3D.h"
+#include "simd.h"
+#include <algorithm>
+#include <cfloat>
+#include <cstdlib>
+
+namespace
+{
+    constexpr int PAIR_COMPONENTS = 13; // a1, b1, a2, b2 (xyz) + suma promieni
+
+    struct CapsuleFit
+    {
+        Vector3 a, b;
+        float radius = 0.0f;
+        float volume = 0.0f;
+        Vector3 axis;
+        float center = 0.0f; // środek zakresu rzutów na oś
+    };
+
+    // Najmniejsza kapsuła wokół prostej przez środek ciężkości w kierunku głównej składowej
+    CapsuleFit FitCapsule(const std::vector<Vector3> &points)
+    {
+        CapsuleFit fit;
+        Vector3 mean = Vector3Zero();
+        for (const Vector3 &p : points)
+            mean = Vector3Add(mean, p);
+        mean = Vector3Scale(mean, 1.0f / points.size());
+
+        float cxx = 0, cxy = 0, cxz = 0, cyy = 0, cyz = 0, czz = 0;
+        for (const Vector3 &p : points)
+        {
+            Vector3 d = Vector3Subtract(p, mean);
+            cxx += d.x * d.x, cxy += d.x * d.y, cxz += d.x * d.z;
+            cyy += d.y * d.y, cyz += d.y * d.z, czz += d.z * d.z;
+        }
+
+        // Metoda potęgowa od osi o największej wariancji
+        Vector3 axis = cxx >= cyy && cxx >= czz ? Vector3{1, 0, 0} : (cyy >= czz ? Vector3{0, 1, 0} : Vector3{0, 0, 1});
+        for (int i = 0; i < 32; i++)
+        {
+            Vector3 next = {cxx * axis.x + cxy * axis.y + cxz * axis.z,
+                            cxy * axis.x + cyy * axis.y + cyz * axis.z,
+                            cxz * axis.x + cyz * axis.y + czz * axis.z};
+            float length = Vector3Length(next);
+            if (length < 1e-12f)
+                break;
+            axis = Vector3Scale(next, 1.0f / length);
+        }
+
+        float radiusSqr = 0.0f, tMin = FLT_MAX, tMax = -FLT_MAX;
+        for (const Vector3 &p : points)
+        {
+            Vector3 d = Vector3Subtract(p, mean);
+            float t = Vector3DotProduct(d, axis);
+            radiusSqr = fmaxf(radiusSqr, Vector3DotProduct(d, d) - t * t);
+            tMin = fminf(tMin, t);
+            tMax = fmaxf(tMax, t);
+        }
+
+        // Końce odcinka tak, by każdy punkt mieścił się w półsferach
+        float top = -FLT_MAX, bottom = FLT_MAX;
+        for (const Vector3 &p : points)
+        {
+            Vector3 d = Vector3Subtract(p, mean);
+            float t = Vector3DotProduct(d, axis);
+            float cap = sqrtf(fmaxf(radiusSqr - (Vector3DotProduct(d, d) - t * t), 0.0f));
+            top = fmaxf(top, t - cap);
+            bottom = fminf(bottom, t + cap);
+        }
+        if (top < bottom)
+            top = bottom = 0.5f * (top + bottom);
+
+        fit.radius = sqrtf(radiusSqr);
+        fit.a = Vector3Add(mean, Vector3Scale(axis, bottom));
+        fit.b = Vector3Add(mean, Vector3Scale(axis, top));
+        fit.volume = PI * radiusSqr * (top - bottom) + 4.0f / 3.0f * PI * radiusSqr * fit.radius;
+        fit.axis = axis;
+        fit.center = 0.5f * (tMin + tMax) + Vector3DotProduct(mean, axis);
+        return fit;
+    }
+
+    template <typename Lanes>
+    inline Lanes Clamp01(Lanes x)
+    {
+        return Min(Max(x, Lanes::Set(0.0f)), Lanes::Set(1.0f));
+    }
+
+    // Odległości powierzchni par kapsuł - ClosestPointsSegmentSegment w pasach SIMD
+    template <typename Lanes>
+    void CapsuleDistanceLanes(const float *pairs, int stride, int first, float *out)
+    {
+        auto load = [&](int component) { return Lanes::Load(pairs + component * stride + first); };
+        const Lanes epsilon = Lanes::Set(1e-12f);
+
+        Lanes p1x = load(0), p1y = load(1), p1z = load(2);
+        Lanes d1x = load(3) - p1x, d1y = load(4) - p1y, d1z = load(5) - p1z;
+        Lanes p2x = load(6), p2y = load(7), p2z = load(8);
+        Lanes d2x = load(9) - p2x, d2y = load(10) - p2y, d2z = load(11) - p2z;
+        Lanes rx = p1x - p2x, ry = p1y - p2y, rz = p1z - p2z;
+
+        Lanes a = Max(d1x * d1x + d1y * d1y + d1z * d1z, epsilon);
+        Lanes e = Max(d2x * d2x + d2y * d2y + d2z * d2z, epsilon);
+        Lanes b = d1x * d2x + d1y * d2y + d1z * d2z;
+        Lanes c = d1x * rx + d1y * ry + d1z * rz;
+        Lanes f = d2x * rx + d2y * ry + d2z * rz;
+        Lanes denom = Max(a * e - b * b, epsilon);
+
+        Lanes s = Clamp01((b * f - c * e) / denom);
+        Lanes t = Clamp01((b * s + f) / e);
+        s = Clamp01((b * t - c) / a);
+
+        Lanes dx = rx + d1x * s - d2x * t;
+        Lanes dy = ry + d1y * s - d2y * t;
+        Lanes dz = rz + d1z * s - d2z * t;
+        (Sqrt(dx * dx + dy * dy + dz * dz) - load(12)).Store(out + first);
+    }
+}
+
+void LinkCollisionModel::Fit(const Mesh *meshes, int meshCount)
+{
+    localCapsules.clear();
+    selfPairs.clear();
+
+    std::vector<Vector3> points, lower, upper;
+    for (int m = 0; m < meshCount; m++)
+    {
+        const Mesh &mesh = meshes[m];
+        if (!mesh.vertices || mesh.vertexCount == 0)
+            continue;
+
+        points.resize(mesh.vertexCount);
+        for (int i = 0; i < mesh.vertexCount; i++)
+            points[i] = {mesh.vertices[i * 3], mesh.vertices[i * 3 + 1], mesh.vertices[i * 3 + 2]};
+        CapsuleFit single = FitCapsule(points);
+
+        // Wydłużone ogniwa (ramię z przegubem na końcu) lepiej opisują dwie kapsuły
+        lower.clear();
+        upper.clear();
+        for (const Vector3 &p : points)
+            (Vector3DotProduct(p, single.axis) < single.center ? lower : upper).push_back(p);
+
+        if (MAX_CAPSULES_PER_LINK > 1 && !lower.empty() && !upper.empty())
+        {
+            CapsuleFit first = FitCapsule(lower);
+            CapsuleFit second = FitCapsule(upper);
+            if (first.volume + second.volume < SPLIT_GAIN * single.volume)
+            {
+                localCapsules.push_back({first.a, first.b, first.radius, m});
+                localCapsules.push_back({second.a, second.b, second.radius, m});
+                continue;
+            }
+        }
+        localCapsules.push_back({single.a, single.b, single.radius, m});
+    }
+    worldCapsules = localCapsules;
+}
+
+void LinkCollisionModel::UpdatePose(const Matrix *jointTransforms, float scale)
+{
+    for (size_t i = 0; i < localCapsules.size(); i++)
+    {
+        const Capsule &local = localCapsules[i];
+        const Matrix &frame = jointTransforms[local.link];
+        worldCapsules[i].a = Vector3Scale(Vector3Transform(local.a, frame), scale);
+        worldCapsules[i].b = Vector3Scale(Vector3Transform(local.b, frame), scale);
+        worldCapsules[i].radius = local.radius * scale;
+    }
+}
+
+void LinkCollisionModel::BuildSelfPairs()
+{
+    selfPairs.clear();
+    for (size_t i = 0; i < worldCapsules.size(); i++)
+    {
+        for (size_t j = i + 1; j < worldCapsules.size(); j++)
+        {
+            const Capsule &first = worldCapsules[i];
+            const Capsule &second = worldCapsules[j];
+            if (std::abs(first.link - second.link) < 2)
+                continue;
+
+            Vector3 c1, c2;
+            float distanceSqr = ClosestPointsSegmentSegment(first.a, first.b, second.a, second.b, c1, c2);
+            float radiusSum = first.radius + second.radius;
+            if (distanceSqr > radiusSum * radiusSum)
+                selfPairs.push_back({(int)i, (int)j});
+        }
+    }
+}
+
+void LinkCollisionModel::PackPair(int slot, int stride, const Capsule &first, const Capsule &second)
+{
+    const float values[PAIR_COMPONENTS] = {first.a.x, first.a.y, first.a.z, first.b.x, first.b.y, first.b.z,
+                                           second.a.x, second.a.y, second.a.z, second.b.x, second.b.y, second.b.z,
+                                           first.radius + second.radius};
+    for (int c = 0; c < PAIR_COMPONENTS; c++)
+        pairBuffer[c * stride + slot] = values[c];
+}
+
+void LinkCollisionModel::EvaluatePairs(int count, int stride)
+{
+    int i = 0;
+    if (useSimd)
+    {
+        for (; i + FloatLanes::WIDTH <= stride; i += FloatLanes::WIDTH)
+            CapsuleDistanceLanes<FloatLanes>(pairBuffer.data(), stride, i, pairDistances.data());
+    }
+    for (; i < count; i++)
+        CapsuleDistanceLanes<ScalarLanes>(pairBuffer.data(), stride, i, pairDistances.data());
+}
+
+LinkContact LinkCollisionModel::MakeContact(LinkContactType type, const Capsule &first, const Capsule &second)
+{
+    Vector3 c1, c2;
+    float distance = sqrtf(ClosestPointsSegmentSegment(first.a, first.b, second.a, second.b, c1, c2));
+    Vector3 normal = distance > 1e-9f ? Vector3Scale(Vector3Subtract(c2, c1), 1.0f / distance) : Vector3Zero();
+
+    LinkContact contact;
+    contact.type = type;
+    contact.link = first.link;
+    contact.otherLink = second.link;
+    contact.distance = distance - first.radius - second.radius;
+    contact.point = Vector3Add(c1, Vector3Scale(normal, first.radius));
+    contact.otherPoint = Vector3Subtract(c2, Vector3Scale(normal, second.radius));
+    return contact;
+}
+
+void LinkCollisionModel::AddContact(std::vector<LinkContact> &out, const LinkContact &contact)
+{
+    for (LinkContact &existing : out)
+    {
+        if (existing.type == contact.type && existing.link == contact.link &&
+            existing.otherLink == contact.otherLink && existing.object == contact.object)
+        {
+            if (contact.distance < existing.distance)
+                existing = contact;
+            return;
+        }
+    }
+    out.push_back(contact);
+}
+
+void LinkCollisionModel::CheckSelf(float margin, std::vector<LinkContact> &out)
+{
+    const int count = (int)selfPairs.size();
+    const int stride = (count + 7) & ~7; // pełne pasy AVX, nadmiar wyzerowany
+    pairBuffer.assign(PAIR_COMPONENTS * stride, 0.0f);
+    pairDistances.resize(stride);
+    for (int i = 0; i < count; i++)
+        PackPair(i, stride, worldCapsules[selfPairs[i].first], worldCapsules[selfPairs[i].second]);
+
+    EvaluatePairs(count, stride);
+
+    for (int i = 0; i < count; i++)
+    {
+        if (pairDistances[i] < margin)
+            AddContact(out, MakeContact(LinkContactType::SELF, worldCapsules[selfPairs[i].first], worldCapsules[selfPairs[i].second]));
+    }
+}
+
+void LinkCollisionModel::CheckRobot(const LinkCollisionModel &other, float margin, std::vector<LinkContact> &out)
+{
+    const int otherCount = (int)other.worldCapsules.size();
+    const int count = (int)worldCapsules.size() * otherCount;
+    const int stride = (count + 7) & ~7;
+    pairBuffer.assign(PAIR_COMPONENTS * stride, 0.0f);
+    pairDistances.resize(stride);
+    for (int i = 0; i < count; i++)
+        PackPair(i, stride, worldCapsules[i / otherCount], other.worldCapsules[i % otherCount]);
+
+    EvaluatePairs(count, stride);
+
+    for (int i = 0; i < count; i++)
+    {
+        if (pairDistances[i] < margin)
+            AddContact(out, MakeContact(LinkContactType::ROBOT, worldCapsules[i / otherCount], other.worldCapsules[i % otherCount]));
+    }
+}
+
+void LinkCollisionModel::CheckScene(float margin, const Object3D *attached, int attachedLink, std::vector<LinkContact> &out) const
+{
+    // Walidacja trajektorii woła CheckScene z wielu wątków
+    thread_local std::vector<Object3D *> candidates;
+    for (const Capsule &capsule : worldCapsules)
+    {
+        float reach = capsule.radius + margin;
+        Vector3 r = {reach, reach, reach};
+        BoundingBox bounds = {Vector3Subtract(Vector3Min(capsule.a, capsule.b), r), Vector3Add(Vector3Max(capsule.a, capsule.b), r)};
+
+        candidates.clear();
+        SceneBroadphase::GetInstance().Query(bounds, [&](Object3D *object)
+                                             {
+                                                 if (!object->markedForDeletion && !(object == attached && (attachedLink < 0 || capsule.link == attachedLink)))
+                                                     candidates.push_back(object);
+                                                 return true; });
+
+        for (const Object3D *object : candidates)
+        {
+            Vector3 surfacePoint;
+            float distance = object->SegmentDistance(capsule.a, capsule.b, reach, &surfacePoint);
+            if (distance >= reach)
+                continue;
+
+            Vector3 onAxis, unused;
+            ClosestPointsSegmentSegment(capsule.a, capsule.b, surfacePoint, surfacePoint, onAxis, unused);
+            Vector3 normal = distance > 1e-9f ? Vector3Scale(Vector3Subtract(surfacePoint, onAxis), 1.0f / distance) : Vector3Zero();
+
+            LinkContact contact;
+            contact.type = LinkContactType::SCENE;
+            contact.link = capsule.link;
+            contact.otherLink = -1;
+            contact.object = object;
+            contact.distance = distance - capsule.radius;
+            contact.point = Vector3Add(onAxis, Vector3Scale(normal, capsule.radius));
+            contact.otherPoint = surfacePoint;
+            AddContact(out, contact);
+        }
+    }
+}
+
+bool LinkCollisionModel::IntersectsScene(float margin, const Object3D *attached, int attachedLink) const
+{
+    for (const Capsule &capsule : worldCapsules)
+    {
+        float reach = capsule.radius + margin;
+        Vector3 r = {reach, reach, reach};
+        BoundingBox bounds = {Vector3Subtract(Vector3Min(capsule.a, capsule.b), r), Vector3Add(Vector3Max(capsule.a, capsule.b), r)};
+
+        bool hit = false;
+        SceneBroadphase::GetInstance().Query(bounds, [&](Object3D *object)
+                                             {
+                                                 if (!object->markedForDeletion && !(object == attached && (attachedLink < 0 || capsule.link == attachedLink)))
+                                                     hit = object->IsSegmentWithin(capsule.a, capsule.b, reach);
+                                                 return !hit; });
+        if (hit)
+            return true;
+    }
+    return false;
+}
+
+void LinkCollisionModel::Draw(const std::vector<LinkContact> &contacts) const
+{
+    for (const Capsule &capsule : worldCapsules)
+    {
+        bool touching = false;
+        for (const LinkContact &contact : contacts)
+        {
+            if (contact.distance < 0.0f && (contact.link == capsule.link ||
+                                            (contact.type == LinkContactType::SELF && contact.otherLink == capsule.link)))
+                touching = true;
+        }
+        DrawCapsuleWires(capsule.a, capsule.b, capsule.radius, 8, 4, touching ? RED : Fade(SKYBLUE, 0.6f));
+    }
+    for (const LinkContact &contact : contacts)
+    {
+        DrawLine3D(contact.point, contact.otherPoint, contact.distance < 0.0f ? RED : ORANGE);
+    }
+}
@@ -1,5 +1,6 @@
 #include "logWindow.h"
 #include "raylib.h"
+#include <cstdio>
 
 LogWindow::LogWindow() : autoScroll(true) {}
 
@@ -43,6 +44,14 @@ void LogWindow::Draw(const char* title, const ImVec2& position, const ImVec2& si
 
 void LogWindow::AddLog(const char* message, LogLevel level) {
     logs.push_back({message, level, static_cast<float>(GetTime())});
+    if (consoleEcho && level >= consoleLevel) {
+        fprintf(stderr, "%s %s\n", GetPrefixForLevel(level), message);
+    }
+}
+
+void LogWindow::SetConsoleEcho(bool enabled, LogLevel min) {
+    consoleEcho = enabled;
+    consoleLevel = min;
 }
 
 void LogWindow::Clear() {
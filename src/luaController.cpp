@@ -7,7 +7,8 @@ float LuaController::last_wait = 0.0f;
 static RobotArm* g_robotArm = nullptr;
 
 LuaController::LuaController(RobotArm& robot, LogWindow& log) 
-    : robotArm(robot), logWindow(log), isRunning(false), stepMode(false), currentLine(0) {
+    : robotArm(robot), logWindow(log), isRunning(false), stepMode(false), currentLine(0),
+      waitTime(0.0f), executeTimer(0.0f) {
     
     L = luaL_newstate();
     luaL_openlibs(L);
@@ -18,6 +19,10 @@ LuaController::LuaController(RobotArm& robot, LogWindow& log)
 void LuaController::RegisterFunctions() {
     lua_register(L, "setJointRotation", lua_setJointRotation);
     lua_register(L, "wait", lua_wait);
+    lua_register(L, "solveIKMany", lua_solveIKMany);
+    lua_register(L, "planMotion", lua_planMotion);
+    lua_register(L, "grip", lua_grip);
+    lua_register(L, "release", lua_release);
 }
 
 int LuaController::lua_setJointRotation(lua_State* L) {
@@ -39,6 +44,125 @@ int LuaController::lua_wait(lua_State* L) {
     return lua_yield(L, 0);
 }
 
+// grip() -> true, jeśli chwytak złapał obiekt, z którym koliduje
+int LuaController::lua_grip(lua_State* L) {
+    if (g_robotArm) {
+        g_robotArm->GripObject();
+    }
+    lua_pushboolean(L, g_robotArm && g_robotArm->IsGripping());
+    return 1;
+}
+
+int LuaController::lua_release(lua_State* L) {
+    if (g_robotArm) {
+        g_robotArm->ReleaseObject();
+    }
+    return 0;
+}
+
+// Pole liczbowe tabeli: najpierw klucz nazwany (x, y, z...), potem pozycja w tablicy
+static float GetTableNumber(lua_State* L, int table, const char* key, int index, float fallback, bool* found = nullptr) {
+    lua_getfield(L, table, key);
+    if (lua_isnil(L, -1)) {
+        lua_pop(L, 1);
+        lua_rawgeti(L, table, index);
+    }
+    bool present = lua_isnumber(L, -1);
+    float value = present ? (float)lua_tonumber(L, -1) : fallback;
+    lua_pop(L, 1);
+    if (found) *found = present;
+    return value;
+}
+
+// solveIKMany({{x, y, z}, {x=.., y=.., z=.., rx=.., ry=.., rz=..}, ...})
+// -> {{angles={...}, converged=bool, reachable=bool, error=number}, ...}
+int LuaController::lua_solveIKMany(lua_State* L) {
+    luaL_checktype(L, 1, LUA_TTABLE);
+    if (!g_robotArm) return 0;
+
+    std::vector<IKTarget> targets;
+    int count = (int)lua_rawlen(L, 1);
+    targets.reserve(count);
+    for (int t = 1; t <= count; t++) {
+        lua_rawgeti(L, 1, t);
+        if (!lua_istable(L, -1)) {
+            return luaL_error(L, "solveIKMany: cel %d nie jest tabelą", t);
+        }
+        int table = lua_gettop(L);
+
+        IKTarget target;
+        target.position.x = GetTableNumber(L, table, "x", 1, 0.0f);
+        target.position.y = GetTableNumber(L, table, "y", 2, 0.0f);
+        target.position.z = GetTableNumber(L, table, "z", 3, 0.0f);
+        bool hasRx = false, hasRy = false, hasRz = false;
+        target.orientation.x = GetTableNumber(L, table, "rx", 4, 0.0f, &hasRx);
+        target.orientation.y = GetTableNumber(L, table, "ry", 5, 0.0f, &hasRy);
+        target.orientation.z = GetTableNumber(L, table, "rz", 6, 0.0f, &hasRz);
+        target.useOrientation = hasRx || hasRy || hasRz;
+        targets.push_back(target);
+        lua_pop(L, 1);
+    }
+
+    RobotKinematics* kinematics = g_robotArm->GetKinematics();
+    std::vector<float> angles;
+    std::vector<IKResult> results;
+    kinematics->SolveIKBatch(targets, angles, results);
+
+    const int jointCount = kinematics->GetMeshCount();
+    lua_createtable(L, count, 0);
+    for (int t = 0; t < count; t++) {
+        lua_createtable(L, 0, 4);
+
+        lua_createtable(L, jointCount, 0);
+        for (int j = 0; j < jointCount; j++) {
+            lua_pushnumber(L, angles[(size_t)t * jointCount + j]);
+            lua_rawseti(L, -2, j + 1);
+        }
+        lua_setfield(L, -2, "angles");
+
+        lua_pushboolean(L, results[t].converged);
+        lua_setfield(L, -2, "converged");
+        lua_pushboolean(L, results[t].reachable);
+        lua_setfield(L, -2, "reachable");
+        lua_pushnumber(L, results[t].positionError);
+        lua_setfield(L, -2, "error");
+
+        lua_rawseti(L, -2, t + 1);
+    }
+    return 1;
+}
+
+// planMotion({x, y, z[, rx, ry, rz]}) -> {success=bool, planningMs=number, duration=number, nodes=number}
+// Planuje bezkolizyjny ruch RRT-Connect i uruchamia go; skrypt czeka przez wait(duration)
+int LuaController::lua_planMotion(lua_State* L) {
+    luaL_checktype(L, 1, LUA_TTABLE);
+    if (!g_robotArm) return 0;
+
+    IKTarget target;
+    target.position.x = GetTableNumber(L, 1, "x", 1, 0.0f);
+    target.position.y = GetTableNumber(L, 1, "y", 2, 0.0f);
+    target.position.z = GetTableNumber(L, 1, "z", 3, 0.0f);
+    bool hasRx = false, hasRy = false, hasRz = false;
+    target.orientation.x = GetTableNumber(L, 1, "rx", 4, 0.0f, &hasRx);
+    target.orientation.y = GetTableNumber(L, 1, "ry", 5, 0.0f, &hasRy);
+    target.orientation.z = GetTableNumber(L, 1, "rz", 6, 0.0f, &hasRz);
+    target.useOrientation = hasRx || hasRy || hasRz;
+
+    bool success = g_robotArm->PlanMotion(target);
+    const MotionPlan& plan = g_robotArm->GetLastMotionPlan();
+
+    lua_createtable(L, 0, 4);
+    lua_pushboolean(L, success);
+    lua_setfield(L, -2, "success");
+    lua_pushnumber(L, plan.planningMs);
+    lua_setfield(L, -2, "planningMs");
+    lua_pushnumber(L, success ? g_robotArm->GetKinematics()->GetTimedTrajectory().GetDuration() : 0.0f);
+    lua_setfield(L, -2, "duration");
+    lua_pushinteger(L, plan.treeNodes);
+    lua_setfield(L, -2, "nodes");
+    return 1;
+}
+
 LuaController::~LuaController() {
     if(L) {
         lua_close(L);
@@ -46,8 +170,11 @@ LuaController::~LuaController() {
     g_robotArm = nullptr;
 }
 
-void LuaController::LoadScript(const std::string& code) {
+bool LuaController::LoadScript(const std::string& code) {
     Stop();
+    lastError.clear();
+    waitTime = 0.0f;
+    last_wait = 0.0f;
     if(L) lua_close(L);
     
     L = luaL_newstate();
@@ -71,12 +198,14 @@ void LuaController::LoadScript(const std::string& code) {
     }, LUA_MASKLINE, 0);
     
     if(luaL_loadstring(L, code.c_str()) != LUA_OK) {
-        logWindow.AddLog(lua_tostring(L, -1), LogLevel::Error);
+        lastError = lua_tostring(L, -1);
+        logWindow.AddLog(lastError.c_str(), LogLevel::Error);
         lua_pop(L, 1);
-        return;
+        return false;
     }
     
     logWindow.AddLog("Skrypt załadowany pomyślnie", LogLevel::Info);
+    return true;
 }
 
 void LuaController::Run() {
@@ -115,6 +244,7 @@ void LuaController::Step() {
 
     if(status != LUA_YIELD && status != LUA_OK) {
         std::string error = lua_tostring(L, -1);
+        lastError = error;
         logWindow.AddLog(("Błąd wykonania: " + error).c_str(), LogLevel::Error);
         lua_pop(L, 1);
         Stop();
@@ -158,8 +288,10 @@ void LuaController::Update(float deltaTime) {
         }
 
         if (status == LUA_YIELD) {
-            // Ustaw czas oczekiwania z funkcji wait()
+            // Ustaw czas oczekiwania z funkcji wait() - tylko raz, kolejne
+            // yieldy z hooka linii nie mogą powtarzać tego samego czekania
             waitTime = last_wait;
+            last_wait = 0.0f;
         }
         else if (status == LUA_OK) {
             logWindow.AddLog("Skrypt zakończony", LogLevel::Info);
@@ -167,6 +299,7 @@ void LuaController::Update(float deltaTime) {
         }
         else {
             std::string error = lua_tostring(L, -1);
+            lastError = error;
             logWindow.AddLog(("Błąd wykonania: " + error).c_str(), LogLevel::Error);
             lua_pop(L, 1);
             Stop();
@@ -18,6 +18,13 @@
 #include "luaController.h"
 #include "sceneLoader.h"
 #include "pickRobot.h"
+#include "headlessSimulation.h"
+#include "simulationClock.h"
+#include "sceneBroadphase.h"
+#include "modelCache.h"
+#include "instancedRenderer.h"
+#include "renderQueue.h"
+#include "dynamicResolution.h"
 
 #define RLIGHTS_IMPLEMENTATION
 #include "rlights.h"
@@ -28,15 +35,6 @@
 #define GLSL_VERSION 100
 #endif
 
-void UpdateRenderTexture(RenderTexture2D &target, const ImVec2 &size)
-{
-    if (target.texture.width != (int)size.x || target.texture.height != (int)size.y)
-    {
-        UnloadRenderTexture(target);
-        target = LoadRenderTexture((int)size.x, (int)size.y);
-    }
-}
-
 void DrawSplashScreen(bool &showSplashScreen, Texture2D &logo)
 {
     const ImGuiViewport *viewport = ImGui::GetMainViewport();
@@ -82,8 +80,17 @@ void DrawSplashScreen(bool &showSplashScreen, Texture2D &logo)
     }
 }
 
-int main()
+int main(int argc, char **argv)
 {
+    // Tryb wsadowy bez okna: robolab --headless --scene x.scn --script y.lua
+    if (HeadlessSimulation::IsRequested(argc, argv))
+    {
+        HeadlessOptions options;
+        if (!HeadlessSimulation::ParseArguments(argc, argv, options))
+            return 2;
+        return HeadlessSimulation(options).Run();
+    }
+
     const int screenWidth = 1280;
     const int screenHeight = 720;
     SetConfigFlags(FLAG_WINDOW_RESIZABLE | FLAG_MSAA_4X_HINT);
@@ -96,7 +103,8 @@ int main()
     }
     SetWindowIcon(icon);
     UnloadImage(icon);
-    RenderTexture2D target = LoadRenderTexture(1920, 1080);
+    // Widok sceny w skalowanej rozdzielczości z puli tekstur
+    DynamicResolution sceneResolution(1920, 1080);
     bool showSplashScreen = true;
     Texture2D logo = LoadTexture("assets/images/banner.png");
     std::vector<Object3D *> sceneObjects;
@@ -110,7 +118,7 @@ int main()
     CameraController cameraController(10.0f, 10.0f, 10.0f);
 
     // Inicjalizacja ramienia robota
-    RobotArm robotArm("assets/models/robot.glb", shader);
+    RobotArm robotArm("assets/robots/robot.glb", shader);
     robotArm.SetScale(0.005f);
 
     CodeEditor codeEditor;
@@ -136,14 +144,16 @@ int main()
         sceneLoader.SaveScene(filename, sceneObjects);
     };
 
-    sceneLoader.onLoadScene = [&sceneObjects, &sceneLoader, &shader](const std::string &filename)
+    sceneLoader.onLoadScene = [&sceneObjects, &sceneLoader, &shader, &robotArm](const std::string &filename)
     {
+        // Wczytanie sceny usuwa dotychczasowe obiekty - robot nie może trzymać do nich wskaźników
+        for (auto *obj : sceneObjects)
+            robotArm.DetachObject(obj);
         sceneLoader.LoadScene(filename, sceneObjects, shader);
     };
 
-    robotArm.SetSceneObjects(sceneObjects);
-
     LuaController luaController(robotArm, logWindow);
+    SimulationClock simulationClock;
 
     toolBar.SetStartCallback([&luaController, &codeEditor]()
                              {
@@ -213,8 +223,15 @@ int main()
         const float toolbarHeight = 50.0f;
         const float logWindowHeight = currentHeight * 0.2f;
 
-        float deltaTime = GetFrameTime();
-        luaController.Update(deltaTime);
+        // Symulacja w stałych krokach niezależnie od liczby klatek na sekundę
+        int steps = simulationClock.Advance(GetFrameTime());
+        for (int i = 0; i < steps; i++)
+        {
+            luaController.Update(simulationClock.GetStep());
+            robotArm.Update(simulationClock.GetStep());
+            robotArm.CheckCollisions();
+        }
+        robotArm.PrepareRender(simulationClock.GetAlpha());
 
         if (float wheelMove = GetMouseWheelMove(); wheelMove != 0)
         {
@@ -222,24 +239,22 @@ int main()
         }
         cameraController.Update();
         //////////////////////////////////////////////////////////////////////////////////////////
-        BeginTextureMode(target);
+        sceneResolution.BeginScene();
         ClearBackground(DARKGRAY);
 
         lightController.Update();
         BeginMode3D(cameraController.GetCamera());
-        robotArm.Update();
-        robotArm.CheckCollisions(sceneObjects);
+        RenderQueue::GetInstance().BeginFrame();
         robotArm.Draw();
-        for (auto *obj : sceneObjects)
-        {
-            obj->Draw();
-        }
+        // Obiekty sceny grupami po modelu - jedno wywołanie na siatkę grupy
+        InstancedRenderer::GetInstance().Submit();
+        RenderQueue::GetInstance().Flush();
         DrawGrid(10, 1.0f);
         DrawSphereWires(lightController.GetLight().position, 0.5f, 8, 8, YELLOW);
         robotArm.DrawPivotPoints();
 
         EndMode3D();
-        EndTextureMode();
+        sceneResolution.EndScene();
         ///////////////////////////////////////////////////////////////////////////////////////////
         BeginDrawing();
         ClearBackground(DARKGRAY);
@@ -258,7 +273,9 @@ int main()
             if (ImGui::BeginTabItem("Debug"))
             {
                 cameraController.DrawImGuiControls();
+                simulationClock.DrawImGuiControls();
                 robotArm.DrawImGuiControls();
+                RenderQueue::GetInstance().DrawImGuiControls();
 
                 lightController.DrawImGuiControls();
 
@@ -289,6 +306,13 @@ int main()
             // Zakładka dla kontrolek ramienia robota
             if (ImGui::BeginTabItem("Obiekty"))
             {
+                SceneBroadphase &broadphase = SceneBroadphase::GetInstance();
+                ImGui::Text("Faza szeroka: %d obiektów, wysokość drzewa %d", broadphase.GetProxyCount(), broadphase.GetHeight());
+                InstancedRenderer &renderer = InstancedRenderer::GetInstance();
+                ImGui::Text("Instancing: %d grup, %d instancji (%d widocznych), przesłano %d B",
+                            renderer.GetGroupCount(), renderer.GetInstanceCount(), renderer.GetVisibleCount(),
+                            renderer.GetUploadedBytes());
+                ModelCache::GetInstance().DrawImGuiControls();
                 for (auto *obj : sceneObjects)
                 {
                     obj->DrawImGuiControls();
@@ -339,6 +363,7 @@ int main()
                 }
 
                 ImGui::TextWrapped("Aktualny filtr: %s", filters[currentFilter]);
+                sceneResolution.DrawImGuiControls();
 
                 ImGui::EndTabItem();
             }
@@ -357,11 +382,7 @@ int main()
 
         ImGui::Begin("Scene View", nullptr, ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoCollapse);
         ImVec2 contentSize = ImGui::GetContentRegionAvail();
-        UpdateRenderTexture(target, contentSize);
-        if (currentTextureFilter == TEXTURE_FILTER_TRILINEAR)
-            GenTextureMipmaps(&target.texture);
-        SetTextureFilter(target.texture, currentTextureFilter);
-        rlImGuiImageRenderTextureFit(&target, true);
+        sceneResolution.Present(contentSize, currentTextureFilter);
         cameraController.SetSceneViewActive(ImGui::IsWindowHovered());
         ImGui::End();
 
@@ -376,10 +397,12 @@ int main()
         }
         rlImGuiEnd();
 
-        // Usuń obiekty zaznaczone do usunięcia
+        // Usuń obiekty zaznaczone do usunięcia (zwalnia je ProcessDeleteQueue)
         auto it = std::remove_if(sceneObjects.begin(), sceneObjects.end(),
-                                 [](Object3D *obj)
+                                 [&robotArm](Object3D *obj)
                                  {
+                                     if (obj->markedForDeletion)
+                                         robotArm.DetachObject(obj);
                                      return obj->markedForDeletion;
                                  });
         sceneObjects.erase(it, sceneObjects.end());
@@ -387,6 +410,7 @@ int main()
         // Przetwórz kolejkę usuwania
         Object3D::ProcessDeleteQueue();
 
+        sceneResolution.EndFrame();
         EndDrawing();
     }
     for (auto *obj : sceneObjects)
@@ -394,9 +418,10 @@ int main()
         delete obj;
     }
     sceneObjects.clear();
+    Object3D::ProcessDeleteQueue();
 
     // Czyszczenie zasobów
-    UnloadRenderTexture(target);
+    sceneResolution.Unload();
     UnloadShader(shader);
     rlImGuiShutdown();
     CloseWindow();
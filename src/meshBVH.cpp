@@ -0,0 +1,434 @@
+#include "meshBVH.h"
+#include "collisionPrimitives.h"
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+
+namespace
+{
+    struct BuildBounds
+    {
+        Vector3 min = {FLT_MAX, FLT_MAX, FLT_MAX};
+        Vector3 max = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+
+        void Grow(Vector3 p)
+        {
+            min = Vector3Min(min, p);
+            max = Vector3Max(max, p);
+        }
+        void Grow(const BuildBounds &other)
+        {
+            min = Vector3Min(min, other.min);
+            max = Vector3Max(max, other.max);
+        }
+        float Area() const
+        {
+            Vector3 e = Vector3Subtract(max, min);
+            if (e.x < 0.0f)
+                return 0.0f;
+            return e.x * e.y + e.y * e.z + e.z * e.x;
+        }
+    };
+
+    float Axis(Vector3 v, int axis)
+    {
+        return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+    }
+
+    // Wejście i wyjście promienia z AABB; brak trafienia - tNear > tFar
+    void RayBox(Vector3 origin, Vector3 invDir, Vector3 min, Vector3 max, float &tNear, float &tFar)
+    {
+        float tx1 = (min.x - origin.x) * invDir.x, tx2 = (max.x - origin.x) * invDir.x;
+        float ty1 = (min.y - origin.y) * invDir.y, ty2 = (max.y - origin.y) * invDir.y;
+        float tz1 = (min.z - origin.z) * invDir.z, tz2 = (max.z - origin.z) * invDir.z;
+        tNear = fmaxf(fmaxf(fminf(tx1, tx2), fminf(ty1, ty2)), fminf(tz1, tz2));
+        tFar = fminf(fminf(fmaxf(tx1, tx2), fmaxf(ty1, ty2)), fmaxf(tz1, tz2));
+    }
+
+    float BoxDistanceSqr(Vector3 p, Vector3 min, Vector3 max)
+    {
+        Vector3 d = Vector3Subtract(Vector3Clamp(p, min, max), p);
+        return Vector3DotProduct(d, d);
+    }
+
+    // Dolne ograniczenie kwadratu odległości odcinka a-b od AABB: większe z odstępu
+    // AABB odcinka i odległości od środka pudełka minus jego półprzekątna (długie
+    // ukośne odcinki mają duże AABB, więc sam odstęp AABB słabo przycina)
+    float SegmentBoxGapSqr(Vector3 a, Vector3 b, Vector3 segMin, Vector3 segMax, Vector3 min, Vector3 max)
+    {
+        Vector3 gap = Vector3Max(Vector3Max(Vector3Subtract(min, segMax), Vector3Subtract(segMin, max)), Vector3Zero());
+        float gapSqr = Vector3DotProduct(gap, gap);
+
+        Vector3 center = Vector3Scale(Vector3Add(min, max), 0.5f);
+        float halfDiagonal = 0.5f * Vector3Distance(min, max);
+        Vector3 ab = Vector3Subtract(b, a);
+        float t = Clamp(Vector3DotProduct(Vector3Subtract(center, a), ab) / fmaxf(Vector3DotProduct(ab, ab), 1e-12f), 0.0f, 1.0f);
+        float sphereGap = Vector3Distance(center, Vector3Add(a, Vector3Scale(ab, t))) - halfDiagonal;
+        return sphereGap > 0.0f ? fmaxf(gapSqr, sphereGap * sphereGap) : gapSqr;
+    }
+}
+
+void MeshBVH::Build(const Mesh *meshes, int meshCount)
+{
+    auto start = std::chrono::steady_clock::now();
+    triangles.clear();
+    nodes.clear();
+
+    std::vector<Triangle> source;
+    for (int m = 0; m < meshCount; m++)
+    {
+        const Mesh &mesh = meshes[m];
+        if (!mesh.vertices)
+            continue;
+        auto vertex = [&](int index)
+        {
+            return Vector3{mesh.vertices[index * 3], mesh.vertices[index * 3 + 1], mesh.vertices[index * 3 + 2]};
+        };
+        for (int t = 0; t < mesh.triangleCount; t++)
+        {
+            int i0 = mesh.indices ? mesh.indices[t * 3] : t * 3;
+            int i1 = mesh.indices ? mesh.indices[t * 3 + 1] : t * 3 + 1;
+            int i2 = mesh.indices ? mesh.indices[t * 3 + 2] : t * 3 + 2;
+            source.push_back({vertex(i0), vertex(i1), vertex(i2)});
+        }
+    }
+    if (source.empty())
+        return;
+
+    const int count = (int)source.size();
+    std::vector<BuildBounds> triBounds(count);
+    std::vector<Vector3> centroids(count);
+    std::vector<int> order(count);
+    for (int i = 0; i < count; i++)
+    {
+        triBounds[i].Grow(source[i].a);
+        triBounds[i].Grow(source[i].b);
+        triBounds[i].Grow(source[i].c);
+        centroids[i] = Vector3Scale(Vector3Add(triBounds[i].min, triBounds[i].max), 0.5f);
+        order[i] = i;
+    }
+
+    nodes.reserve(2 * count);
+    nodes.push_back({});
+    nodes[0].first = 0;
+    nodes[0].count = count;
+
+    // (węzeł, głębokość) - głębokość ograniczona do rozmiaru stosu zapytań
+    std::vector<std::pair<int, int>> stack = {{0, 0}};
+    while (!stack.empty())
+    {
+        auto [nodeIndex, depth] = stack.back();
+        stack.pop_back();
+        int first = nodes[nodeIndex].first;
+        int nodeCount = nodes[nodeIndex].count;
+
+        BuildBounds bounds, centroidBounds;
+        for (int i = first; i < first + nodeCount; i++)
+        {
+            bounds.Grow(triBounds[order[i]]);
+            centroidBounds.Grow(centroids[order[i]]);
+        }
+        nodes[nodeIndex].min = bounds.min;
+        nodes[nodeIndex].max = bounds.max;
+        if (nodeCount <= 2 || depth >= STACK_SIZE - 2)
+            continue;
+
+        // Najtańszy podział po kubełkach centroidów na każdej osi
+        float bestCost = FLT_MAX;
+        int bestAxis = -1, bestSplit = 0;
+        for (int axis = 0; axis < 3; axis++)
+        {
+            float lo = Axis(centroidBounds.min, axis), hi = Axis(centroidBounds.max, axis);
+            if (hi - lo < 1e-9f)
+                continue;
+
+            BuildBounds binBounds[BIN_COUNT];
+            int binCount[BIN_COUNT] = {0};
+            float binScale = BIN_COUNT / (hi - lo);
+            for (int i = first; i < first + nodeCount; i++)
+            {
+                int bin = std::min(BIN_COUNT - 1, (int)((Axis(centroids[order[i]], axis) - lo) * binScale));
+                binBounds[bin].Grow(triBounds[order[i]]);
+                binCount[bin]++;
+            }
+
+            float rightArea[BIN_COUNT - 1];
+            int rightCount[BIN_COUNT - 1];
+            BuildBounds right;
+            int rightSum = 0;
+            for (int b = BIN_COUNT - 1; b > 0; b--)
+            {
+                right.Grow(binBounds[b]);
+                rightSum += binCount[b];
+                rightArea[b - 1] = right.Area();
+                rightCount[b - 1] = rightSum;
+            }
+
+            BuildBounds left;
+            int leftSum = 0;
+            for (int b = 0; b < BIN_COUNT - 1; b++)
+            {
+                left.Grow(binBounds[b]);
+                leftSum += binCount[b];
+                float cost = leftSum * left.Area() + rightCount[b] * rightArea[b];
+                if (leftSum > 0 && rightCount[b] > 0 && cost < bestCost)
+                {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestSplit = b;
+                }
+            }
+        }
+
+        // Koszt trafienia trójkąta = 1, przejścia węzła = 1 (w jednostkach pola powierzchni rodzica)
+        float leafCost = (float)nodeCount;
+        float splitCost = 1.0f + bestCost / std::max(bounds.Area(), 1e-12f);
+        if (bestAxis < 0 || (splitCost >= leafCost && nodeCount <= MAX_LEAF_SIZE))
+            continue;
+
+        float lo = Axis(centroidBounds.min, bestAxis);
+        float binScale = BIN_COUNT / (Axis(centroidBounds.max, bestAxis) - lo);
+        int *middle = std::partition(order.data() + first, order.data() + first + nodeCount, [&](int t)
+                                     { return std::min(BIN_COUNT - 1, (int)((Axis(centroids[t], bestAxis) - lo) * binScale)) <= bestSplit; });
+        int leftCount = (int)(middle - (order.data() + first));
+        if (leftCount == 0 || leftCount == nodeCount)
+            continue;
+
+        int leftIndex = (int)nodes.size();
+        nodes.push_back({});
+        nodes.push_back({});
+        nodes[leftIndex].first = first;
+        nodes[leftIndex].count = leftCount;
+        nodes[leftIndex + 1].first = first + leftCount;
+        nodes[leftIndex + 1].count = nodeCount - leftCount;
+        nodes[nodeIndex].first = leftIndex;
+        nodes[nodeIndex].count = 0;
+        stack.push_back({leftIndex, depth + 1});
+        stack.push_back({leftIndex + 1, depth + 1});
+    }
+
+    // Trójkąty w kolejności liści - liść czyta ciągły zakres
+    triangles.resize(count);
+    for (int i = 0; i < count; i++)
+        triangles[i] = source[order[i]];
+    nodes.shrink_to_fit();
+
+    buildTime = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+}
+
+BoundingBox MeshBVH::GetBounds() const
+{
+    if (nodes.empty())
+        return {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+    return {nodes[0].min, nodes[0].max};
+}
+
+RayCollision MeshBVH::Raycast(Vector3 origin, Vector3 direction, float maxDistance) const
+{
+    RayCollision result = {0};
+    result.distance = maxDistance;
+    if (nodes.empty())
+        return result;
+
+    Vector3 invDir = {1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z};
+    int hitTriangle = -1;
+
+    int stack[STACK_SIZE];
+    int stackSize = 0;
+    float tNear, tFar;
+    RayBox(origin, invDir, nodes[0].min, nodes[0].max, tNear, tFar);
+    if (tNear <= tFar && tFar >= 0.0f && tNear < result.distance)
+        stack[stackSize++] = 0;
+
+    while (stackSize > 0)
+    {
+        const Node &node = nodes[stack[--stackSize]];
+        if (node.count > 0)
+        {
+            // Möller-Trumbore
+            for (int i = node.first; i < node.first + node.count; i++)
+            {
+                const Triangle &tri = triangles[i];
+                Vector3 e1 = Vector3Subtract(tri.b, tri.a);
+                Vector3 e2 = Vector3Subtract(tri.c, tri.a);
+                Vector3 p = Vector3CrossProduct(direction, e2);
+                float det = Vector3DotProduct(e1, p);
+                if (fabsf(det) < 1e-12f)
+                    continue;
+                float invDet = 1.0f / det;
+                Vector3 s = Vector3Subtract(origin, tri.a);
+                float u = Vector3DotProduct(s, p) * invDet;
+                if (u < 0.0f || u > 1.0f)
+                    continue;
+                Vector3 q = Vector3CrossProduct(s, e1);
+                float v = Vector3DotProduct(direction, q) * invDet;
+                if (v < 0.0f || u + v > 1.0f)
+                    continue;
+                float t = Vector3DotProduct(e2, q) * invDet;
+                if (t >= 0.0f && t < result.distance)
+                {
+                    result.distance = t;
+                    hitTriangle = i;
+                }
+            }
+            continue;
+        }
+
+        // Bliższe dziecko na szczyt stosu, dalsze odrzucane, gdy trafienie jest bliżej niż jego AABB
+        int children[2] = {node.first, node.first + 1};
+        float nears[2];
+        bool hits[2];
+        for (int c = 0; c < 2; c++)
+        {
+            RayBox(origin, invDir, nodes[children[c]].min, nodes[children[c]].max, nears[c], tFar);
+            hits[c] = nears[c] <= tFar && tFar >= 0.0f && nears[c] < result.distance;
+        }
+        int nearChild = nears[0] <= nears[1] ? 0 : 1;
+        if (hits[1 - nearChild] && stackSize < STACK_SIZE)
+            stack[stackSize++] = children[1 - nearChild];
+        if (hits[nearChild] && stackSize < STACK_SIZE)
+            stack[stackSize++] = children[nearChild];
+    }
+
+    if (hitTriangle >= 0)
+    {
+        const Triangle &tri = triangles[hitTriangle];
+        result.hit = true;
+        result.point = Vector3Add(origin, Vector3Scale(direction, result.distance));
+        result.normal = Vector3Normalize(Vector3CrossProduct(Vector3Subtract(tri.b, tri.a), Vector3Subtract(tri.c, tri.a)));
+    }
+    return result;
+}
+
+bool MeshBVH::IntersectsSphere(Vector3 center, float radius) const
+{
+    if (nodes.empty())
+        return false;
+
+    const float radiusSqr = radius * radius;
+    int stack[STACK_SIZE];
+    int stackSize = 0;
+    if (BoxDistanceSqr(center, nodes[0].min, nodes[0].max) <= radiusSqr)
+        stack[stackSize++] = 0;
+
+    while (stackSize > 0)
+    {
+        const Node &node = nodes[stack[--stackSize]];
+        if (node.count > 0)
+        {
+            for (int i = node.first; i < node.first + node.count; i++)
+            {
+                const Triangle &tri = triangles[i];
+                Vector3 closest = ClosestPointOnTriangle(center, tri.a, tri.b, tri.c);
+                if (Vector3DistanceSqr(closest, center) <= radiusSqr)
+                    return true;
+            }
+            continue;
+        }
+
+        for (int c = 0; c < 2; c++)
+        {
+            const Node &child = nodes[node.first + c];
+            if (stackSize < STACK_SIZE && BoxDistanceSqr(center, child.min, child.max) <= radiusSqr)
+                stack[stackSize++] = node.first + c;
+        }
+    }
+    return false;
+}
+
+float MeshBVH::SegmentDistance(Vector3 a, Vector3 b, float maxDistance, Vector3 *closestPoint) const
+{
+    if (nodes.empty())
+        return maxDistance;
+
+    Vector3 segMin = Vector3Min(a, b), segMax = Vector3Max(a, b);
+    float bestSqr = maxDistance * maxDistance;
+    int stack[STACK_SIZE];
+    int stackSize = 0;
+    if (SegmentBoxGapSqr(a, b, segMin, segMax, nodes[0].min, nodes[0].max) < bestSqr)
+        stack[stackSize++] = 0;
+
+    while (stackSize > 0)
+    {
+        const Node &node = nodes[stack[--stackSize]];
+        // Ograniczenie mogło zmaleć od wstawienia węzła na stos
+        if (SegmentBoxGapSqr(a, b, segMin, segMax, node.min, node.max) >= bestSqr)
+            continue;
+
+        if (node.count > 0)
+        {
+            for (int i = node.first; i < node.first + node.count; i++)
+            {
+                const Triangle &tri = triangles[i];
+                Vector3 onSegment, onTriangle;
+                float distanceSqr = ClosestPointsSegmentTriangle(a, b, tri.a, tri.b, tri.c, onSegment, onTriangle);
+                if (distanceSqr < bestSqr)
+                {
+                    bestSqr = distanceSqr;
+                    if (closestPoint)
+                        *closestPoint = onTriangle;
+                    if (distanceSqr == 0.0f)
+                        return 0.0f;
+                }
+            }
+            continue;
+        }
+
+        // Bliższe dziecko na szczyt stosu
+        float gaps[2];
+        for (int c = 0; c < 2; c++)
+        {
+            const Node &child = nodes[node.first + c];
+            gaps[c] = SegmentBoxGapSqr(a, b, segMin, segMax, child.min, child.max);
+        }
+        int nearChild = gaps[0] <= gaps[1] ? 0 : 1;
+        if (gaps[1 - nearChild] < bestSqr && stackSize < STACK_SIZE)
+            stack[stackSize++] = node.first + 1 - nearChild;
+        if (gaps[nearChild] < bestSqr && stackSize < STACK_SIZE)
+            stack[stackSize++] = node.first + nearChild;
+    }
+    return sqrtf(bestSqr);
+}
+
+bool MeshBVH::SegmentWithin(Vector3 a, Vector3 b, float distance) const
+{
+    if (nodes.empty())
+        return false;
+
+    Vector3 segMin = Vector3Min(a, b), segMax = Vector3Max(a, b);
+    const float distanceSqr = distance * distance;
+    int stack[STACK_SIZE];
+    int stackSize = 0;
+    if (SegmentBoxGapSqr(a, b, segMin, segMax, nodes[0].min, nodes[0].max) < distanceSqr)
+        stack[stackSize++] = 0;
+
+    while (stackSize > 0)
+    {
+        const Node &node = nodes[stack[--stackSize]];
+        if (node.count > 0)
+        {
+            for (int i = node.first; i < node.first + node.count; i++)
+            {
+                const Triangle &tri = triangles[i];
+                Vector3 onSegment, onTriangle;
+                if (ClosestPointsSegmentTriangle(a, b, tri.a, tri.b, tri.c, onSegment, onTriangle) < distanceSqr)
+                    return true;
+            }
+            continue;
+        }
+
+        // Bliższe dziecko na szczyt stosu - najpewniej tam jest trafienie
+        float gaps[2];
+        for (int c = 0; c < 2; c++)
+        {
+            const Node &child = nodes[node.first + c];
+            gaps[c] = SegmentBoxGapSqr(a, b, segMin, segMax, child.min, child.max);
+        }
+        int nearChild = gaps[0] <= gaps[1] ? 0 : 1;
+        if (gaps[1 - nearChild] < distanceSqr && stackSize < STACK_SIZE)
+            stack[stackSize++] = node.first + 1 - nearChild;
+        if (gaps[nearChild] < distanceSqr && stackSize < STACK_SIZE)
+            stack[stackSize++] = node.first + nearChild;
+    }
+    return false;
+}
@@ -0,0 +1,546 @@
+#include "meshSimplifier.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+static constexpr int MAX_ITERATIONS = 100;
+static constexpr double AGGRESSIVENESS = 7.0;       // wzrost progu błędu z iteracją
+static constexpr double MAX_COLLAPSE_ERROR = 2.5e-3; // ~5% rozmiaru siatki - dalej kształt się rozpada
+static constexpr float SMOOTH_ANGLE_COS = 0.7071f;  // 45° - sąsiednie ściany o większym kącie dają ostrą krawędź
+static constexpr float FLIP_COS = 0.2f;             // minimalna zgodność normalnej po kolapsie
+static constexpr int MAX_INDEXED_VERTICES = 65535;  // indeksy Mesh są 16-bitowe
+
+namespace
+{
+// Symetryczna macierz 4x4 kwadryki zapisana jako 10 współczynników
+struct Quadric
+{
+    double m[10] = {0.0};
+
+    Quadric() = default;
+    Quadric(double a, double b, double c, double d)
+        : m{a * a, a * b, a * c, a * d, b * b, b * c, b * d, c * c, c * d, d * d}
+    {
+    }
+
+    Quadric &operator+=(const Quadric &other)
+    {
+        for (int i = 0; i < 10; i++)
+            m[i] += other.m[i];
+        return *this;
+    }
+
+    double Det(int a11, int a12, int a13, int a21, int a22, int a23, int a31, int a32, int a33) const
+    {
+        return m[a11] * m[a22] * m[a33] + m[a13] * m[a21] * m[a32] + m[a12] * m[a23] * m[a31] -
+               m[a13] * m[a22] * m[a31] - m[a11] * m[a23] * m[a32] - m[a12] * m[a21] * m[a33];
+    }
+
+    double Error(double x, double y, double z) const
+    {
+        return m[0] * x * x + 2 * m[1] * x * y + 2 * m[2] * x * z + 2 * m[3] * x + m[4] * y * y + 2 * m[5] * y * z +
+               2 * m[6] * y + m[7] * z * z + 2 * m[8] * z + m[9];
+    }
+};
+
+struct Triangle
+{
+    int v[3];
+    double error[4]; // krawędzie v0-v1, v1-v2, v2-v0 i minimum
+    Vector3 normal;
+    bool deleted = false;
+    bool dirty = false;
+};
+
+struct Vertex
+{
+    Vector3 position;
+    Quadric quadric;
+    int refStart = 0;
+    int refCount = 0;
+    bool border = false;
+};
+
+struct Ref
+{
+    int triangle;
+    int corner;
+};
+
+class Simplifier
+{
+public:
+    std::vector<Triangle> triangles;
+    std::vector<Vertex> vertices;
+    double maxError = 0.0;
+
+    void Run(int target)
+    {
+        const int triangleCount = (int)triangles.size();
+        int deletedCount = 0;
+        std::vector<char> deleted0, deleted1;
+
+        for (int iteration = 0; iteration < MAX_ITERATIONS; iteration++)
+        {
+            if (triangleCount - deletedCount <= target)
+                break;
+            // Co kilka iteracji usunięcie skasowanych trójkątów i odbudowa list sąsiedztwa
+            if (iteration % 5 == 0)
+                UpdateMesh(iteration);
+
+            for (Triangle &t : triangles)
+                t.dirty = false;
+
+            const double threshold = std::min(1e-9 * pow(iteration + 3.0, AGGRESSIVENESS), MAX_COLLAPSE_ERROR);
+            for (size_t ti = 0; ti < triangles.size(); ti++)
+            {
+                Triangle &t = triangles[ti];
+                if (t.error[3] > threshold || t.deleted || t.dirty)
+                    continue;
+
+                for (int j = 0; j < 3; j++)
+                {
+                    if (t.error[j] >= threshold)
+                        continue;
+                    const int i0 = t.v[j];
+                    const int i1 = t.v[(j + 1) % 3];
+                    Vertex &v0 = vertices[i0];
+                    Vertex &v1 = vertices[i1];
+                    // Brzeg siatki zwija się tylko wzdłuż brzegu
+                    if (v0.border != v1.border)
+                        continue;
+
+                    Vector3 p;
+                    double error = EdgeError(i0, i1, p);
+                    deleted0.assign(v0.refCount, 0);
+                    deleted1.assign(v1.refCount, 0);
+                    if (Flipped(p, i1, v0, deleted0) || Flipped(p, i0, v1, deleted1))
+                        continue;
+
+                    v0.position = p;
+                    v0.quadric += v1.quadric;
+                    const int refStart = (int)refs.size();
+                    UpdateTriangles(i0, v0, deleted0, deletedCount);
+                    UpdateTriangles(i0, v1, deleted1, deletedCount);
+                    const int refCount = (int)refs.size() - refStart;
+                    if (refCount <= v0.refCount)
+                    {
+                        // Mieści się w dotychczasowym zakresie - bez wzrostu tablicy
+                        if (refCount > 0)
+                            memmove(&refs[v0.refStart], &refs[refStart], refCount * sizeof(Ref));
+                        refs.resize(refStart);
+                    }
+                    else
+                    {
+                        v0.refStart = refStart;
+                    }
+                    v0.refCount = refCount;
+                    maxError = std::max(maxError, error);
+                    break;
+                }
+                if (triangleCount - deletedCount <= target)
+                    break;
+            }
+        }
+        Compact();
+    }
+
+private:
+    std::vector<Ref> refs;
+
+    double VertexError(const Quadric &q, Vector3 p) const { return q.Error(p.x, p.y, p.z); }
+
+    // Błąd kolapsu krawędzi i optymalna pozycja wynikowego wierzchołka
+    double EdgeError(int a, int b, Vector3 &result) const
+    {
+        Quadric q = vertices[a].quadric;
+        q += vertices[b].quadric;
+        const Vector3 pa = vertices[a].position, pb = vertices[b].position;
+        const bool border = vertices[a].border && vertices[b].border;
+
+        double det = q.Det(0, 1, 2, 1, 4, 5, 2, 5, 7);
+        if (!border && fabs(det) > 1e-15)
+        {
+            Vector3 p = {(float)(-1.0 / det * q.Det(1, 2, 3, 4, 5, 6, 5, 7, 8)),
+                         (float)(1.0 / det * q.Det(0, 2, 3, 1, 5, 6, 2, 7, 8)),
+                         (float)(-1.0 / det * q.Det(0, 1, 3, 1, 4, 6, 2, 5, 8))};
+            // Prawie osobliwa kwadryka potrafi wyrzucić punkt daleko od krawędzi
+            Vector3 mid = Vector3Scale(Vector3Add(pa, pb), 0.5f);
+            if (Vector3Distance(p, mid) <= Vector3Distance(pa, pb))
+            {
+                result = p;
+                return VertexError(q, p);
+            }
+        }
+
+        Vector3 mid = Vector3Scale(Vector3Add(pa, pb), 0.5f);
+        double ea = VertexError(q, pa), eb = VertexError(q, pb), em = VertexError(q, mid);
+        double error = std::min(ea, std::min(eb, em));
+        result = error == ea ? pa : (error == eb ? pb : mid);
+        return error;
+    }
+
+    // Czy przesunięcie wierzchołka v do p odwróci lub zdegeneruje któryś z jego trójkątów.
+    // deleted - trójkąty zawierające krawędź z other (znikną przy kolapsie)
+    bool Flipped(Vector3 p, int other, const Vertex &v, std::vector<char> &deleted) const
+    {
+        for (int k = 0; k < v.refCount; k++)
+        {
+            const Ref &r = refs[v.refStart + k];
+            const Triangle &t = triangles[r.triangle];
+            if (t.deleted)
+                continue;
+
+            const int id1 = t.v[(r.corner + 1) % 3];
+            const int id2 = t.v[(r.corner + 2) % 3];
+            if (id1 == other || id2 == other)
+            {
+                deleted[k] = 1;
+                continue;
+            }
+
+            Vector3 d1 = Vector3Normalize(Vector3Subtract(vertices[id1].position, p));
+            Vector3 d2 = Vector3Normalize(Vector3Subtract(vertices[id2].position, p));
+            if (fabsf(Vector3DotProduct(d1, d2)) > 0.999f)
+                return true;
+            Vector3 n = Vector3Normalize(Vector3CrossProduct(d1, d2));
+            if (Vector3DotProduct(n, t.normal) < FLIP_COS)
+                return true;
+        }
+        return false;
+    }
+
+    void UpdateTriangles(int i0, const Vertex &v, const std::vector<char> &deleted, int &deletedCount)
+    {
+        Vector3 p;
+        for (int k = 0; k < v.refCount; k++)
+        {
+            const Ref r = refs[v.refStart + k];
+            Triangle &t = triangles[r.triangle];
+            if (t.deleted)
+                continue;
+            if (deleted[k])
+            {
+                t.deleted = true;
+                deletedCount++;
+                continue;
+            }
+
+            t.v[r.corner] = i0;
+            t.dirty = true;
+            t.normal = Vector3Normalize(Vector3CrossProduct(
+                Vector3Subtract(vertices[t.v[1]].position, vertices[t.v[0]].position),
+                Vector3Subtract(vertices[t.v[2]].position, vertices[t.v[0]].position)));
+            t.error[0] = EdgeError(t.v[0], t.v[1], p);
+            t.error[1] = EdgeError(t.v[1], t.v[2], p);
+            t.error[2] = EdgeError(t.v[2], t.v[0], p);
+            t.error[3] = std::min(t.error[0], std::min(t.error[1], t.error[2]));
+            refs.push_back(r);
+        }
+    }
+
+    void UpdateMesh(int iteration)
+    {
+        if (iteration > 0)
+        {
+            triangles.erase(std::remove_if(triangles.begin(), triangles.end(), [](const Triangle &t)
+                                           { return t.deleted; }),
+                            triangles.end());
+        }
+
+        // Listy trójkątów każdego wierzchołka
+        for (Vertex &v : vertices)
+            v.refCount = 0;
+        for (const Triangle &t : triangles)
+        {
+            for (int j = 0; j < 3; j++)
+                vertices[t.v[j]].refCount++;
+        }
+        int start = 0;
+        for (Vertex &v : vertices)
+        {
+            v.refStart = start;
+            start += v.refCount;
+            v.refCount = 0;
+        }
+        refs.resize(triangles.size() * 3);
+        for (int i = 0; i < (int)triangles.size(); i++)
+        {
+            for (int j = 0; j < 3; j++)
+            {
+                Vertex &v = vertices[triangles[i].v[j]];
+                refs[v.refStart + v.refCount++] = {i, j};
+            }
+        }
+
+        if (iteration != 0)
+            return;
+
+        // Krawędź brzegowa należy do jednego trójkąta: sąsiad widziany raz
+        std::vector<int> neighbourCount, neighbourIds;
+        for (Vertex &v : vertices)
+            v.border = false;
+        for (const Vertex &v : vertices)
+        {
+            neighbourCount.clear();
+            neighbourIds.clear();
+            for (int k = 0; k < v.refCount; k++)
+            {
+                const Triangle &t = triangles[refs[v.refStart + k].triangle];
+                for (int j = 0; j < 3; j++)
+                {
+                    auto found = std::find(neighbourIds.begin(), neighbourIds.end(), t.v[j]);
+                    if (found == neighbourIds.end())
+                    {
+                        neighbourIds.push_back(t.v[j]);
+                        neighbourCount.push_back(1);
+                    }
+                    else
+                    {
+                        neighbourCount[found - neighbourIds.begin()]++;
+                    }
+                }
+            }
+            for (size_t j = 0; j < neighbourIds.size(); j++)
+            {
+                if (neighbourCount[j] == 1)
+                    vertices[neighbourIds[j]].border = true;
+            }
+        }
+
+        // Kwadryki z płaszczyzn trójkątów
+        for (Triangle &t : triangles)
+        {
+            Vector3 p0 = vertices[t.v[0]].position;
+            Vector3 n = Vector3Normalize(Vector3CrossProduct(Vector3Subtract(vertices[t.v[1]].position, p0),
+                                                             Vector3Subtract(vertices[t.v[2]].position, p0)));
+            t.normal = n;
+            Quadric q(n.x, n.y, n.z, -Vector3DotProduct(n, p0));
+            for (int j = 0; j < 3; j++)
+                vertices[t.v[j]].quadric += q;
+        }
+        Vector3 p;
+        for (Triangle &t : triangles)
+        {
+            for (int j = 0; j < 3; j++)
+                t.error[j] = EdgeError(t.v[j], t.v[(j + 1) % 3], p);
+            t.error[3] = std::min(t.error[0], std::min(t.error[1], t.error[2]));
+        }
+    }
+
+    // Usuwa skasowane trójkąty i nieużywane wierzchołki
+    void Compact()
+    {
+        triangles.erase(std::remove_if(triangles.begin(), triangles.end(), [](const Triangle &t)
+                                       { return t.deleted; }),
+                        triangles.end());
+        std::vector<int> remap(vertices.size(), -1);
+        int count = 0;
+        for (Triangle &t : triangles)
+        {
+            for (int j = 0; j < 3; j++)
+            {
+                int &target = remap[t.v[j]];
+                if (target < 0)
+                {
+                    target = count++;
+                }
+            }
+        }
+        std::vector<Vertex> compacted(count);
+        for (size_t i = 0; i < vertices.size(); i++)
+        {
+            if (remap[i] >= 0)
+                compacted[remap[i]] = vertices[i];
+        }
+        for (Triangle &t : triangles)
+        {
+            for (int j = 0; j < 3; j++)
+                t.v[j] = remap[t.v[j]];
+        }
+        vertices.swap(compacted);
+    }
+};
+
+struct PositionKey
+{
+    uint32_t x, y, z;
+    bool operator==(const PositionKey &other) const { return x == other.x && y == other.y && z == other.z; }
+};
+
+struct PositionKeyHash
+{
+    size_t operator()(const PositionKey &key) const
+    {
+        return (size_t)key.x * 73856093u ^ (size_t)key.y * 19349663u ^ (size_t)key.z * 83492791u;
+    }
+};
+}
+
+// Normalne wierzchołków z progiem kąta; narożniki o zgodnych normalnych dzielą wierzchołek wyjściowy
+static void BuildOutputMesh(const Simplifier &simplifier, Vector3 offset, float scale, Mesh &out)
+{
+    const auto &triangles = simplifier.triangles;
+    const auto &vertices = simplifier.vertices;
+
+    std::vector<Vector3> faceNormals(triangles.size()); // nieznormalizowane - waga pola
+    std::vector<std::vector<int>> vertexFaces(vertices.size());
+    for (size_t i = 0; i < triangles.size(); i++)
+    {
+        const Triangle &t = triangles[i];
+        Vector3 p0 = vertices[t.v[0]].position;
+        faceNormals[i] = Vector3CrossProduct(Vector3Subtract(vertices[t.v[1]].position, p0),
+                                             Vector3Subtract(vertices[t.v[2]].position, p0));
+        for (int j = 0; j < 3; j++)
+            vertexFaces[t.v[j]].push_back((int)i);
+    }
+
+    struct Corner
+    {
+        int vertex;
+        Vector3 normal;
+    };
+    std::vector<Corner> outVertices;
+    std::vector<std::vector<int>> vertexOutputs(vertices.size()); // wierzchołek -> indeksy w outVertices
+    std::vector<int> indices(triangles.size() * 3);
+    for (size_t i = 0; i < triangles.size(); i++)
+    {
+        Vector3 faceNormal = Vector3Normalize(faceNormals[i]);
+        for (int j = 0; j < 3; j++)
+        {
+            int vertex = triangles[i].v[j];
+            Vector3 normal = {0.0f, 0.0f, 0.0f};
+            for (int face : vertexFaces[vertex])
+            {
+                if (Vector3DotProduct(Vector3Normalize(faceNormals[face]), faceNormal) >= SMOOTH_ANGLE_COS)
+                    normal = Vector3Add(normal, faceNormals[face]);
+            }
+            normal = Vector3Length(normal) > 0.0f ? Vector3Normalize(normal) : faceNormal;
+
+            int index = -1;
+            for (int candidate : vertexOutputs[vertex])
+            {
+                if (Vector3DotProduct(outVertices[candidate].normal, normal) > 0.9999f)
+                {
+                    index = candidate;
+                    break;
+                }
+            }
+            if (index < 0)
+            {
+                index = (int)outVertices.size();
+                outVertices.push_back({vertex, normal});
+                vertexOutputs[vertex].push_back(index);
+            }
+            indices[i * 3 + j] = index;
+        }
+    }
+
+    // Za dużo wierzchołków na indeksy 16-bitowe - siatka bez indeksów
+    const bool indexed = (int)outVertices.size() <= MAX_INDEXED_VERTICES;
+    out = {0};
+    out.triangleCount = (int)triangles.size();
+    out.vertexCount = indexed ? (int)outVertices.size() : out.triangleCount * 3;
+    out.vertices = (float *)MemAlloc(out.vertexCount * 3 * sizeof(float));
+    out.normals = (float *)MemAlloc(out.vertexCount * 3 * sizeof(float));
+    auto write = [&](int slot, const Corner &corner)
+    {
+        Vector3 p = Vector3Add(Vector3Scale(vertices[corner.vertex].position, scale), offset);
+        memcpy(&out.vertices[slot * 3], &p, sizeof(Vector3));
+        memcpy(&out.normals[slot * 3], &corner.normal, sizeof(Vector3));
+    };
+    if (indexed)
+    {
+        for (size_t i = 0; i < outVertices.size(); i++)
+            write((int)i, outVertices[i]);
+        out.indices = (unsigned short *)MemAlloc((unsigned int)(indices.size() * sizeof(unsigned short)));
+        for (size_t i = 0; i < indices.size(); i++)
+            out.indices[i] = (unsigned short)indices[i];
+    }
+    else
+    {
+        for (size_t i = 0; i < indices.size(); i++)
+            write((int)i, outVertices[indices[i]]);
+    }
+}
+
+bool SimplifyMesh(const Mesh &source, float targetRatio, int minTriangles, SimplifyResult &result)
+{
+    result = {};
+    if (!source.vertices || source.vertexCount < 3)
+        return false;
+
+    const int triangleCount = source.indices ? source.triangleCount : source.vertexCount / 3;
+    result.sourceTriangles = triangleCount;
+
+    // Pozycje w sześcianie jednostkowym - progi błędu nie zależą od jednostek modelu
+    Vector3 minimum = {source.vertices[0], source.vertices[1], source.vertices[2]}, maximum = minimum;
+    for (int i = 1; i < source.vertexCount; i++)
+    {
+        Vector3 p = {source.vertices[i * 3], source.vertices[i * 3 + 1], source.vertices[i * 3 + 2]};
+        minimum = Vector3Min(minimum, p);
+        maximum = Vector3Max(maximum, p);
+    }
+    const float extent = fmaxf(Vector3Distance(minimum, maximum), 1e-12f);
+    const float invExtent = 1.0f / extent;
+
+    // Sklejanie wierzchołków o identycznej pozycji
+    Simplifier simplifier;
+    std::unordered_map<PositionKey, int, PositionKeyHash> welded;
+    std::vector<int> sourceToWelded(source.vertexCount);
+    for (int i = 0; i < source.vertexCount; i++)
+    {
+        const float *p = &source.vertices[i * 3];
+        PositionKey key;
+        memcpy(&key.x, &p[0], 4);
+        memcpy(&key.y, &p[1], 4);
+        memcpy(&key.z, &p[2], 4);
+        auto inserted = welded.emplace(key, (int)simplifier.vertices.size());
+        if (inserted.second)
+        {
+            Vertex v;
+            v.position = Vector3Scale(Vector3Subtract({p[0], p[1], p[2]}, minimum), invExtent);
+            simplifier.vertices.push_back(v);
+        }
+        sourceToWelded[i] = inserted.first->second;
+    }
+
+    simplifier.triangles.reserve(triangleCount);
+    for (int i = 0; i < triangleCount; i++)
+    {
+        Triangle t;
+        for (int j = 0; j < 3; j++)
+        {
+            int index = source.indices ? source.indices[i * 3 + j] : i * 3 + j;
+            if (index >= source.vertexCount)
+                return false;
+            t.v[j] = sourceToWelded[index];
+        }
+        // Trójkąty zdegenerowane po sklejeniu nie niosą powierzchni
+        if (t.v[0] == t.v[1] || t.v[1] == t.v[2] || t.v[2] == t.v[0])
+            continue;
+        simplifier.triangles.push_back(t);
+    }
+    if (simplifier.triangles.empty())
+        return false;
+
+    int target = std::max(minTriangles, (int)(triangleCount * targetRatio));
+    simplifier.Run(target);
+    if (simplifier.triangles.empty())
+        return false;
+
+    BuildOutputMesh(simplifier, minimum, extent, result.mesh);
+    result.maxError = (float)simplifier.maxError;
+    return true;
+}
+
+void FreeSimplifiedMesh(Mesh &mesh)
+{
+    MemFree(mesh.vertices);
+    MemFree(mesh.normals);
+    MemFree(mesh.indices);
+    mesh = {0};
+}
@@ -0,0 +1,163 @@
+#include "modelCache.h"
+#include "modelLoader.h"
+#include "convexCollision.h"
+#include "imgui.h"
+#include <chrono>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+static constexpr uint64_t FNV_OFFSET = 14695981039346656037ull;
+static constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+static uint64_t HashBytes(uint64_t hash, const char *data, size_t size)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= (unsigned char)data[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+uint64_t ModelCache::HashFile(const std::string &path)
+{
+    std::error_code error;
+    fs::path canonical = fs::weakly_canonical(path, error);
+    std::string key = error ? path : canonical.string();
+
+    uintmax_t size = fs::file_size(key, error);
+    if (error)
+    {
+        // Brak pliku - wpis po ścieżce, żeby nieudane wczytanie też było współdzielone
+        return HashBytes(FNV_OFFSET, key.data(), key.size());
+    }
+    fs::file_time_type modified = fs::last_write_time(key, error);
+
+    auto stamp = stamps.find(key);
+    if (stamp != stamps.end() && stamp->second.size == size && stamp->second.modified == modified)
+        return stamp->second.hash;
+
+    uint64_t hash = FNV_OFFSET;
+    std::ifstream stream(key, std::ios::binary);
+    char buffer[1 << 16];
+    while (stream.read(buffer, sizeof(buffer)) || stream.gcount() > 0)
+        hash = HashBytes(hash, buffer, (size_t)stream.gcount());
+
+    // .gltf wskazuje bufory i tekstury względem swojego katalogu - ten sam tekst
+    // w innym katalogu to inny model
+    if (canonical.extension() != ".glb")
+    {
+        std::string directory = canonical.parent_path().string();
+        hash = HashBytes(hash, directory.data(), directory.size());
+    }
+
+    stamps[key] = {hash, size, modified};
+    return hash;
+}
+
+const ModelAsset *ModelCache::Acquire(const char *path, bool collision, bool lod)
+{
+    uint64_t hash = HashFile(path);
+    auto found = assets.find(hash);
+    ModelAsset *asset;
+    if (found != assets.end())
+    {
+        asset = found->second.get();
+        hits++;
+    }
+    else
+    {
+        auto start = std::chrono::steady_clock::now();
+        auto created = std::make_unique<ModelAsset>();
+        created->model = ModelLoader::Load(path);
+        created->path = path;
+        created->hash = hash;
+        created->loadTime = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+        totalLoadTime += created->loadTime;
+        TraceLog(LOG_INFO, "MODEL CACHE: [%s] Wczytano (%.1f ms)", path, created->loadTime * 1000.0f);
+        asset = created.get();
+        assets.emplace(hash, std::move(created));
+        misses++;
+    }
+
+    if (collision && !asset->hasCollision)
+    {
+        auto start = std::chrono::steady_clock::now();
+        asset->bvh.Build(asset->model.meshes, asset->model.meshCount);
+        asset->hullPoints = CollectHullPoints(asset->model.meshes, asset->model.meshCount);
+        asset->hasCollision = true;
+        float elapsed = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+        asset->loadTime += elapsed;
+        totalLoadTime += elapsed;
+    }
+
+    if (lod && !asset->hasLod && !ModelLoader::IsHeadless())
+    {
+        // Poziomy w katalogu konfiguracji modelu, jak mapa osiągalności robota
+        auto start = std::chrono::steady_clock::now();
+        fs::path source(asset->path);
+        asset->lod.LoadOrBuild(source.parent_path() / ("." + source.stem().string()), asset->model, asset->hash);
+        asset->lod.Upload();
+        asset->hasLod = true;
+        float elapsed = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+        asset->loadTime += elapsed;
+        totalLoadTime += elapsed;
+    }
+
+    asset->references++;
+    return asset;
+}
+
+void ModelCache::Release(const ModelAsset *asset)
+{
+    if (!asset)
+        return;
+    auto found = assets.find(asset->hash);
+    if (found == assets.end() || found->second.get() != asset)
+        return;
+
+    ModelAsset &entry = *found->second;
+    if (--entry.references > 0)
+        return;
+
+    TraceLog(LOG_INFO, "MODEL CACHE: [%s] Zwolniono", entry.path.c_str());
+    entry.lod.Unload();
+    ModelLoader::Unload(entry.model);
+    assets.erase(found);
+}
+
+int ModelCache::GetReferenceCount() const
+{
+    int total = 0;
+    for (const auto &entry : assets)
+        total += entry.second->references;
+    return total;
+}
+
+void ModelCache::DrawImGuiControls()
+{
+    if (ImGui::TreeNode("Pamięć modeli"))
+    {
+        ImGui::Text("Unikalne modele: %d, instancje: %d", GetAssetCount(), GetReferenceCount());
+        ImGui::Text("Trafienia: %d, wczytania: %d, łączny czas wczytania: %.1f ms",
+                    hits, misses, totalLoadTime * 1000.0f);
+        for (const auto &entry : assets)
+        {
+            const ModelAsset &asset = *entry.second;
+            ImGui::BulletText("%s - %d ref., %d siatek, %.1f ms", fs::path(asset.path).filename().string().c_str(),
+                              asset.references, asset.model.meshCount, asset.loadTime * 1000.0f);
+            if (asset.lod.GetLevelCount() > 1)
+            {
+                ImGui::SameLine();
+                ImGui::TextDisabled("LOD:");
+                for (int level = 0; level < asset.lod.GetLevelCount(); level++)
+                {
+                    ImGui::SameLine();
+                    ImGui::TextDisabled("%d", asset.lod.GetTriangleCount(level));
+                }
+            }
+        }
+        ImGui::TreePop();
+    }
+}
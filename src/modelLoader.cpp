@@ -0,0 +1,287 @@
+#include "modelLoader.h"
+#include <nlohmann/json.hpp>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+using json = nlohmann::json;
+
+bool ModelLoader::headless = false;
+
+namespace
+{
+    const uint32_t GLB_MAGIC = 0x46546C67;  // "glTF"
+    const uint32_t CHUNK_JSON = 0x4E4F534A; // "JSON"
+    const uint32_t CHUNK_BIN = 0x004E4942;  // "BIN\0"
+    const int COMPONENT_FLOAT = 5126;
+    const int MODE_TRIANGLES = 4;
+
+    struct GLBFile
+    {
+        json document;
+        std::vector<unsigned char> binary;
+    };
+
+    bool ReadGLB(const char *path, GLBFile &file)
+    {
+        std::ifstream stream(path, std::ios::binary);
+        if (!stream.is_open())
+            return false;
+        std::vector<unsigned char> data((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+        uint32_t header[3];
+        if (data.size() < sizeof(header))
+            return false;
+        memcpy(header, data.data(), sizeof(header));
+        if (header[0] != GLB_MAGIC || header[1] != 2)
+            return false;
+
+        size_t offset = sizeof(header);
+        while (offset + 8 <= data.size())
+        {
+            uint32_t chunk[2]; // długość, typ
+            memcpy(chunk, data.data() + offset, sizeof(chunk));
+            offset += sizeof(chunk);
+            if (offset + chunk[0] > data.size())
+                return false;
+
+            if (chunk[1] == CHUNK_JSON)
+                file.document = json::parse(data.begin() + offset, data.begin() + offset + chunk[0]);
+            else if (chunk[1] == CHUNK_BIN)
+                file.binary.assign(data.begin() + offset, data.begin() + offset + chunk[0]);
+            offset += chunk[0];
+        }
+        return file.document.is_object();
+    }
+
+    // Wskaźnik na pierwszy element accessora i odstęp między elementami; nullptr, jeśli dane wychodzą poza bufor
+    const unsigned char *AccessorData(const GLBFile &file, const json &accessor, size_t elementSize, size_t &stride)
+    {
+        const json &view = file.document["bufferViews"][accessor["bufferView"].get<int>()];
+        size_t offset = view.value("byteOffset", (size_t)0) + accessor.value("byteOffset", (size_t)0);
+        size_t count = accessor["count"].get<size_t>();
+        stride = view.value("byteStride", elementSize);
+        if (count == 0 || offset + stride * (count - 1) + elementSize > file.binary.size())
+            return nullptr;
+        return file.binary.data() + offset;
+    }
+
+    bool ReadFloats(const GLBFile &file, int index, int components, std::vector<float> &out)
+    {
+        const json &accessor = file.document["accessors"][index];
+        if (accessor["componentType"].get<int>() != COMPONENT_FLOAT || !accessor.contains("bufferView"))
+            return false;
+
+        size_t stride;
+        const unsigned char *data = AccessorData(file, accessor, components * sizeof(float), stride);
+        if (!data)
+            return false;
+
+        size_t count = accessor["count"].get<size_t>();
+        out.resize(count * components);
+        for (size_t i = 0; i < count; i++)
+            memcpy(&out[i * components], data + i * stride, components * sizeof(float));
+        return true;
+    }
+
+    bool ReadIndices(const GLBFile &file, int index, std::vector<unsigned int> &out)
+    {
+        const json &accessor = file.document["accessors"][index];
+        int componentType = accessor["componentType"].get<int>();
+        size_t size = componentType == 5121 ? 1 : (componentType == 5123 ? 2 : (componentType == 5125 ? 4 : 0));
+        if (size == 0 || !accessor.contains("bufferView"))
+            return false;
+
+        size_t stride;
+        const unsigned char *data = AccessorData(file, accessor, size, stride);
+        if (!data)
+            return false;
+
+        size_t count = accessor["count"].get<size_t>();
+        out.resize(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            const unsigned char *element = data + i * stride;
+            if (size == 1)
+                out[i] = *element;
+            else if (size == 2)
+            {
+                uint16_t value;
+                memcpy(&value, element, 2);
+                out[i] = value;
+            }
+            else
+                memcpy(&out[i], element, 4);
+        }
+        return true;
+    }
+
+    Matrix NodeLocalTransform(const json &node)
+    {
+        if (node.contains("matrix"))
+        {
+            // glTF zapisuje macierz kolumnami
+            std::vector<float> a = node["matrix"].get<std::vector<float>>();
+            return {a[0], a[4], a[8], a[12],
+                    a[1], a[5], a[9], a[13],
+                    a[2], a[6], a[10], a[14],
+                    a[3], a[7], a[11], a[15]};
+        }
+
+        std::vector<float> t = node.value("translation", std::vector<float>{0.0f, 0.0f, 0.0f});
+        std::vector<float> r = node.value("rotation", std::vector<float>{0.0f, 0.0f, 0.0f, 1.0f});
+        std::vector<float> s = node.value("scale", std::vector<float>{1.0f, 1.0f, 1.0f});
+        Matrix scale = MatrixScale(s[0], s[1], s[2]);
+        Matrix rotation = QuaternionToMatrix({r[0], r[1], r[2], r[3]});
+        Matrix translation = MatrixTranslate(t[0], t[1], t[2]);
+        return MatrixMultiply(MatrixMultiply(scale, rotation), translation);
+    }
+
+    bool LoadPrimitive(const GLBFile &file, const json &primitive, Matrix transform, Mesh &mesh)
+    {
+        if (primitive.value("mode", MODE_TRIANGLES) != MODE_TRIANGLES)
+            return false;
+        const json &attributes = primitive["attributes"];
+        std::vector<float> positions;
+        if (!attributes.contains("POSITION") || !ReadFloats(file, attributes["POSITION"].get<int>(), 3, positions))
+            return false;
+
+        mesh = {0};
+        mesh.vertexCount = (int)(positions.size() / 3);
+        mesh.vertices = (float *)MemAlloc(mesh.vertexCount * 3 * sizeof(float));
+        for (int i = 0; i < mesh.vertexCount; i++)
+        {
+            Vector3 v = Vector3Transform({positions[i * 3], positions[i * 3 + 1], positions[i * 3 + 2]}, transform);
+            mesh.vertices[i * 3] = v.x;
+            mesh.vertices[i * 3 + 1] = v.y;
+            mesh.vertices[i * 3 + 2] = v.z;
+        }
+
+        std::vector<float> normals;
+        if (attributes.contains("NORMAL") && ReadFloats(file, attributes["NORMAL"].get<int>(), 3, normals) &&
+            (int)normals.size() == mesh.vertexCount * 3)
+        {
+            Matrix normalMatrix = MatrixTranspose(MatrixInvert(transform));
+            normalMatrix.m12 = normalMatrix.m13 = normalMatrix.m14 = 0.0f;
+            mesh.normals = (float *)MemAlloc(mesh.vertexCount * 3 * sizeof(float));
+            for (int i = 0; i < mesh.vertexCount; i++)
+            {
+                Vector3 n = Vector3Normalize(Vector3Transform({normals[i * 3], normals[i * 3 + 1], normals[i * 3 + 2]}, normalMatrix));
+                mesh.normals[i * 3] = n.x;
+                mesh.normals[i * 3 + 1] = n.y;
+                mesh.normals[i * 3 + 2] = n.z;
+            }
+        }
+
+        std::vector<unsigned int> indices;
+        if (primitive.contains("indices") && ReadIndices(file, primitive["indices"].get<int>(), indices))
+        {
+            // Jak w raylib: Mesh przechowuje indeksy 16-bitowe
+            mesh.indices = (unsigned short *)MemAlloc((unsigned int)(indices.size() * sizeof(unsigned short)));
+            bool truncated = false;
+            for (size_t i = 0; i < indices.size(); i++)
+            {
+                truncated |= indices[i] > 0xFFFF;
+                mesh.indices[i] = (unsigned short)indices[i];
+            }
+            if (truncated)
+                TraceLog(LOG_WARNING, "MODEL: Indeksy 32-bitowe obcięte do 16 bitów");
+            mesh.triangleCount = (int)(indices.size() / 3);
+        }
+        else
+        {
+            mesh.triangleCount = mesh.vertexCount / 3;
+        }
+        return true;
+    }
+}
+
+Model ModelLoader::Load(const char *path)
+{
+    if (!headless)
+        return LoadModel(path);
+    return LoadGLBGeometry(path);
+}
+
+void ModelLoader::Unload(Model &model)
+{
+    if (!headless)
+    {
+        UnloadModel(model);
+        return;
+    }
+
+    for (int i = 0; i < model.meshCount; i++)
+    {
+        MemFree(model.meshes[i].vertices);
+        MemFree(model.meshes[i].normals);
+        MemFree(model.meshes[i].indices);
+    }
+    MemFree(model.meshes);
+    model.meshes = nullptr;
+    model.meshCount = 0;
+}
+
+Model ModelLoader::LoadGLBGeometry(const char *path)
+{
+    Model model = {0};
+    model.transform = MatrixIdentity();
+
+    std::vector<Mesh> meshes;
+    try
+    {
+        GLBFile file;
+        if (!ReadGLB(path, file))
+        {
+            TraceLog(LOG_WARNING, "MODEL: [%s] Nie udało się wczytać - tryb headless obsługuje tylko pliki .glb", path);
+            return model;
+        }
+
+        const json nodes = file.document.value("nodes", json::array());
+        const json gltfMeshes = file.document.value("meshes", json::array());
+
+        std::vector<int> parents(nodes.size(), -1);
+        for (size_t i = 0; i < nodes.size(); i++)
+        {
+            for (const auto &child : nodes[i].value("children", json::array()))
+                parents[child.get<int>()] = (int)i;
+        }
+
+        // Kolejność siatek jak w raylib: węzły po kolei, prymitywy trójkątne każdej siatki
+        for (size_t i = 0; i < nodes.size(); i++)
+        {
+            if (!nodes[i].contains("mesh"))
+                continue;
+
+            Matrix world = NodeLocalTransform(nodes[i]);
+            for (int parent = parents[i]; parent >= 0; parent = parents[parent])
+                world = MatrixMultiply(world, NodeLocalTransform(nodes[parent]));
+
+            for (const auto &primitive : gltfMeshes[nodes[i]["mesh"].get<int>()]["primitives"])
+            {
+                Mesh mesh;
+                if (LoadPrimitive(file, primitive, world, mesh))
+                    meshes.push_back(mesh);
+            }
+        }
+    }
+    catch (const json::exception &e)
+    {
+        TraceLog(LOG_WARNING, "MODEL: [%s] Błędny dokument glTF: %s", path, e.what());
+        for (auto &mesh : meshes)
+        {
+            MemFree(mesh.vertices);
+            MemFree(mesh.normals);
+            MemFree(mesh.indices);
+        }
+        return model;
+    }
+
+    model.meshCount = (int)meshes.size();
+    model.meshes = (Mesh *)MemAlloc((unsigned int)(meshes.size() * sizeof(Mesh)));
+    memcpy(model.meshes, meshes.data(), meshes.size() * sizeof(Mesh));
+    TraceLog(LOG_INFO, "MODEL: [%s] Wczytano %d siatek (tylko dane CPU)", path, model.meshCount);
+    return model;
+}
@@ -0,0 +1,301 @@
+#include "modelLod.h"
+#include "meshSimplifier.h"
+#include "threadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+    const char MAGIC[4] = {'L', 'O', 'D', 'S'};
+    const uint32_t VERSION = 1;
+
+    struct FileHeader
+    {
+        char magic[4];
+        uint32_t version;
+        uint64_t sourceHash;
+        int32_t levelCount;
+        int32_t meshCount;
+    };
+
+    struct MeshHeader
+    {
+        int32_t vertexCount; // 0 - siatka z poziomu niżej
+        int32_t triangleCount;
+        int32_t indexed;
+    };
+
+    const int MIN_TRIANGLES = 32;       // siatek mniejszych nie ma sensu upraszczać
+    const float MIN_REDUCTION = 0.8f;   // poziom musi mieć najwyżej tyle trójkątów poprzedniego
+    const int MAX_VERTICES = 1 << 24;   // ochrona przed uszkodzonym plikiem
+}
+
+bool ModelLod::LoadOrBuild(const fs::path &configDir, const Model &model, uint64_t hash)
+{
+    fs::path path = configDir / "lod.bin";
+    if (Load(path, model, hash))
+        return true;
+
+    Build(model, hash);
+    std::error_code error;
+    fs::create_directories(configDir, error);
+    if (error || !Save(path))
+    {
+        TraceLog(LOG_WARNING, "Nie udało się zapisać poziomów szczegółowości: %s", path.string().c_str());
+    }
+    return levelCount > 1;
+}
+
+void ModelLod::Build(const Model &model, uint64_t hash)
+{
+    auto start = std::chrono::steady_clock::now();
+    Unload();
+    sourceHash = hash;
+    meshCount = model.meshCount;
+    const int simplifiedLevels = MAX_LEVELS - 1;
+    std::vector<std::vector<Mesh>> built(simplifiedLevels, std::vector<Mesh>(meshCount, Mesh{0}));
+
+    // Każdy poziom liczony z oryginału - błędy nie kumulują się między poziomami
+    ThreadPool::GetInstance().ParallelFor(simplifiedLevels * meshCount, [&](int begin, int end)
+    {
+        for (int i = begin; i < end; i++)
+        {
+            int level = i / meshCount + 1;
+            int meshIndex = i % meshCount;
+            SimplifyResult result;
+            if (SimplifyMesh(model.meshes[meshIndex], LEVEL_RATIOS[level], MIN_TRIANGLES, result))
+                built[level - 1][meshIndex] = result.mesh;
+        }
+    });
+
+    // Poziom zostaje tylko przy wyraźnym zysku; siatka bez zysku korzysta z poziomu niżej
+    triangleCounts.assign(1, 0);
+    std::vector<int> previous(meshCount);
+    for (int m = 0; m < meshCount; m++)
+    {
+        previous[m] = model.meshes[m].triangleCount;
+        triangleCounts[0] += previous[m];
+    }
+    for (int level = 0; level < simplifiedLevels; level++)
+    {
+        std::vector<Mesh> &meshes = built[level];
+        int total = 0;
+        for (int m = 0; m < meshCount; m++)
+        {
+            if (meshes[m].vertexCount > 0 && meshes[m].triangleCount > MIN_REDUCTION * previous[m])
+                FreeSimplifiedMesh(meshes[m]);
+            if (meshes[m].vertexCount > 0)
+                previous[m] = meshes[m].triangleCount;
+            total += previous[m];
+        }
+
+        if (total > MIN_REDUCTION * triangleCounts.back())
+        {
+            for (int rest = level; rest < simplifiedLevels; rest++)
+            {
+                for (Mesh &mesh : built[rest])
+                {
+                    if (mesh.vertexCount > 0)
+                        FreeSimplifiedMesh(mesh);
+                }
+            }
+            break;
+        }
+        levels.push_back(std::move(meshes));
+        triangleCounts.push_back(total);
+    }
+    levelCount = (int)triangleCounts.size();
+
+    buildTime = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+    TraceLog(LOG_INFO, "LOD: %d poziomów, %d -> %d trójkątów (%.1f ms)", levelCount, triangleCounts.front(),
+             triangleCounts.back(), buildTime * 1000.0f);
+}
+
+bool ModelLod::Load(const fs::path &path, const Model &model, uint64_t expectedHash)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open())
+        return false;
+
+    FileHeader header;
+    if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)))
+        return false;
+    if (memcmp(header.magic, MAGIC, 4) != 0 || header.version != VERSION || header.sourceHash != expectedHash ||
+        header.meshCount != model.meshCount || header.levelCount < 1 || header.levelCount > MAX_LEVELS)
+    {
+        return false;
+    }
+
+    std::vector<std::vector<Mesh>> loaded;
+    std::vector<int> counts(1, 0);
+    std::vector<int> previous(model.meshCount);
+    for (int m = 0; m < model.meshCount; m++)
+    {
+        previous[m] = model.meshes[m].triangleCount;
+        counts[0] += previous[m];
+    }
+
+    bool valid = true;
+    for (int level = 1; level < header.levelCount && valid; level++)
+    {
+        loaded.emplace_back(model.meshCount, Mesh{0});
+        int total = 0;
+        for (int m = 0; m < model.meshCount && valid; m++)
+        {
+            MeshHeader meshHeader;
+            if (!file.read(reinterpret_cast<char *>(&meshHeader), sizeof(meshHeader)) ||
+                meshHeader.vertexCount < 0 || meshHeader.vertexCount > MAX_VERTICES || meshHeader.triangleCount < 0 ||
+                (!meshHeader.indexed && meshHeader.vertexCount != meshHeader.triangleCount * 3))
+            {
+                valid = false;
+                break;
+            }
+            if (meshHeader.vertexCount == 0)
+            {
+                total += previous[m];
+                continue;
+            }
+
+            Mesh &mesh = loaded.back()[m];
+            mesh.vertexCount = meshHeader.vertexCount;
+            mesh.triangleCount = meshHeader.triangleCount;
+            mesh.vertices = (float *)MemAlloc(mesh.vertexCount * 3 * sizeof(float));
+            mesh.normals = (float *)MemAlloc(mesh.vertexCount * 3 * sizeof(float));
+            file.read(reinterpret_cast<char *>(mesh.vertices), mesh.vertexCount * 3 * sizeof(float));
+            file.read(reinterpret_cast<char *>(mesh.normals), mesh.vertexCount * 3 * sizeof(float));
+            if (meshHeader.indexed)
+            {
+                mesh.indices = (unsigned short *)MemAlloc(mesh.triangleCount * 3 * sizeof(unsigned short));
+                file.read(reinterpret_cast<char *>(mesh.indices), mesh.triangleCount * 3 * sizeof(unsigned short));
+                for (int i = 0; i < mesh.triangleCount * 3 && valid; i++)
+                    valid = mesh.indices[i] < mesh.vertexCount;
+            }
+            valid = valid && file.good();
+            previous[m] = mesh.triangleCount;
+            total += previous[m];
+        }
+        counts.push_back(total);
+    }
+
+    if (!valid)
+    {
+        for (auto &meshes : loaded)
+        {
+            for (Mesh &mesh : meshes)
+            {
+                if (mesh.vertexCount > 0)
+                    FreeSimplifiedMesh(mesh);
+            }
+        }
+        return false;
+    }
+
+    Unload();
+    sourceHash = header.sourceHash;
+    meshCount = header.meshCount;
+    levels.swap(loaded);
+    triangleCounts.swap(counts);
+    levelCount = header.levelCount;
+    buildTime = 0.0f;
+    return true;
+}
+
+bool ModelLod::Save(const fs::path &path) const
+{
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open())
+        return false;
+
+    FileHeader header;
+    memcpy(header.magic, MAGIC, 4);
+    header.version = VERSION;
+    header.sourceHash = sourceHash;
+    header.levelCount = levelCount;
+    header.meshCount = meshCount;
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    for (const auto &meshes : levels)
+    {
+        for (const Mesh &mesh : meshes)
+        {
+            MeshHeader meshHeader = {mesh.vertexCount, mesh.triangleCount, mesh.indices != nullptr};
+            file.write(reinterpret_cast<const char *>(&meshHeader), sizeof(meshHeader));
+            if (mesh.vertexCount == 0)
+                continue;
+            file.write(reinterpret_cast<const char *>(mesh.vertices), mesh.vertexCount * 3 * sizeof(float));
+            file.write(reinterpret_cast<const char *>(mesh.normals), mesh.vertexCount * 3 * sizeof(float));
+            if (mesh.indices)
+                file.write(reinterpret_cast<const char *>(mesh.indices), mesh.triangleCount * 3 * sizeof(unsigned short));
+        }
+    }
+    return file.good();
+}
+
+void ModelLod::Upload()
+{
+    if (uploaded)
+        return;
+    for (auto &meshes : levels)
+    {
+        for (Mesh &mesh : meshes)
+        {
+            if (mesh.vertexCount > 0)
+                UploadMesh(&mesh, false);
+        }
+    }
+    uploaded = true;
+}
+
+void ModelLod::Unload()
+{
+    for (auto &meshes : levels)
+    {
+        for (Mesh &mesh : meshes)
+        {
+            if (mesh.vertexCount == 0)
+                continue;
+            if (uploaded)
+                UnloadMesh(mesh);
+            else
+                FreeSimplifiedMesh(mesh);
+        }
+    }
+    levels.clear();
+    triangleCounts.clear();
+    levelCount = 1;
+    uploaded = false;
+}
+
+const Mesh &ModelLod::GetMesh(const Model &model, int level, int meshIndex) const
+{
+    for (level = std::min(level, levelCount - 1); level > 0; level--)
+    {
+        const Mesh &mesh = levels[level - 1][meshIndex];
+        if (mesh.vertexCount > 0)
+            return mesh;
+    }
+    return model.meshes[meshIndex];
+}
+
+int ModelLod::SelectLevel(float screenSize, int current, int levelCount)
+{
+    // Poziom przy progach zwężonych i poszerzonych o pas histerezy: pomiędzy nimi obecny poziom zostaje
+    int coarsest = 0, finest = 0;
+    for (int i = 0; i < levelCount - 1; i++)
+    {
+        if (screenSize < SCREEN_THRESHOLDS[i] * (1.0f + HYSTERESIS))
+            coarsest = i + 1;
+        if (screenSize < SCREEN_THRESHOLDS[i] * (1.0f - HYSTERESIS))
+            finest = i + 1;
+    }
+    if (current < 0)
+    {
+        int level = 0;
+        while (level < levelCount - 1 && screenSize < SCREEN_THRESHOLDS[level])
+            level++;
+        return level;
+    }
+    return std::clamp(current, finest, coarsest);
+}
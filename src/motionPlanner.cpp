@@ -0,0 +1,337 @@
+#include "motionPlanner.h"
+#include "threadPool.h"
+#include <algorithm>
+#include <atomic>
+
+MotionPlanner::MotionPlanner(const RobotKinematics &kinematics, const LinkCollisionModel &collision, const Object3D *attached)
+    : kinematics(kinematics), collision(collision), attached(attached), jointCount(kinematics.GetMeshCount())
+{
+    for (int i = 0; i < jointCount; i++)
+    {
+        const JointLimit &limit = kinematics.GetJointLimit(i);
+        lowerLimits.push_back(limit.min);
+        upperLimits.push_back(limit.max);
+    }
+    mainScratch = CreateScratch();
+    scratchConfig.resize(jointCount);
+}
+
+const char *MotionPlanner::GetStatusName(MotionPlanStatus status)
+{
+    switch (status)
+    {
+    case MotionPlanStatus::SUCCESS:
+        return "sukces";
+    case MotionPlanStatus::START_IN_COLLISION:
+        return "start w kolizji";
+    case MotionPlanStatus::GOAL_IN_COLLISION:
+        return "cel w kolizji";
+    case MotionPlanStatus::TIMEOUT:
+        return "przekroczony czas";
+    }
+    return "";
+}
+
+MotionPlanner::Scratch MotionPlanner::CreateScratch() const
+{
+    Scratch scratch{collision};
+    scratch.rotations.resize(jointCount);
+    for (int i = 0; i < jointCount; i++)
+        scratch.rotations[i] = {0.0f, kinematics.GetDescription().joints[i].axis};
+    scratch.frames.assign(jointCount, MatrixIdentity());
+    return scratch;
+}
+
+bool MotionPlanner::CheckState(Scratch &scratch, const float *angles) const
+{
+    for (int i = 0; i < jointCount; i++)
+        scratch.rotations[i].angle = angles[i];
+    kinematics.ComputeJointTransforms(scratch.rotations.data(), 0, scratch.frames.data());
+    scratch.probe.UpdatePose(scratch.frames.data(), kinematics.GetScale());
+
+    // Każdy kontakt w marginesie clearance oznacza stan niedozwolony
+    scratch.contacts.clear();
+    scratch.probe.CheckSelf(settings.clearance, scratch.contacts);
+    if (!scratch.contacts.empty())
+        return false;
+    return !scratch.probe.IntersectsScene(settings.clearance, attached, -1);
+}
+
+bool MotionPlanner::IsStateValid(const float *angles)
+{
+    stateChecks++;
+    return CheckState(mainScratch, angles);
+}
+
+int MotionPlanner::StateCount(const float *a, const float *b) const
+{
+    float maxDelta = 0.0f;
+    for (int i = 0; i < jointCount; i++)
+        maxDelta = fmaxf(maxDelta, fabsf(b[i] - a[i]));
+    return (int)ceilf(maxDelta / settings.edgeResolution);
+}
+
+int MotionPlanner::ValidPrefix(const float *a, const float *b, int stateCount)
+{
+    auto interpolate = [&](int state, float *out)
+    {
+        float t = state / (float)stateCount;
+        for (int i = 0; i < jointCount; i++)
+            out[i] = a[i] + (b[i] - a[i]) * t;
+    };
+
+    if (stateCount < PARALLEL_MIN_STATES)
+    {
+        for (int state = 1; state <= stateCount; state++)
+        {
+            interpolate(state, scratchConfig.data());
+            if (!IsStateValid(scratchConfig.data()))
+                return state - 1;
+        }
+        return stateCount;
+    }
+
+    // Porcje stanów na wątkach puli; porcje za najwcześniejszą kolizją kończą pracę
+    std::atomic<int> firstInvalid{stateCount + 1};
+    std::atomic<int> checks{0};
+    ThreadPool::GetInstance().ParallelFor(stateCount, [&](int begin, int end)
+    {
+        Scratch scratch = CreateScratch();
+        std::vector<float> q(jointCount);
+        int local = 0;
+        for (int state = begin + 1; state <= end && state < firstInvalid.load(std::memory_order_relaxed); state++)
+        {
+            interpolate(state, q.data());
+            local++;
+            if (!CheckState(scratch, q.data()))
+            {
+                int expected = firstInvalid.load();
+                while (state < expected && !firstInvalid.compare_exchange_weak(expected, state))
+                {
+                }
+                break;
+            }
+        }
+        checks += local;
+    }, PARALLEL_MIN_STATES / 2);
+
+    stateChecks += checks.load();
+    return firstInvalid.load() - 1;
+}
+
+int MotionPlanner::Nearest(const Tree &tree, const float *q) const
+{
+    int best = 0;
+    float bestDistance = INFINITY;
+    const int count = (int)tree.parents.size();
+    for (int node = 0; node < count; node++)
+    {
+        const float *p = &tree.nodes[node * jointCount];
+        float distance = 0.0f;
+        for (int i = 0; i < jointCount; i++)
+            distance += (p[i] - q[i]) * (p[i] - q[i]);
+        if (distance < bestDistance)
+        {
+            bestDistance = distance;
+            best = node;
+        }
+    }
+    return best;
+}
+
+int MotionPlanner::AddNode(Tree &tree, const float *q, int parent) const
+{
+    tree.nodes.insert(tree.nodes.end(), q, q + jointCount);
+    tree.parents.push_back(parent);
+    return (int)tree.parents.size() - 1;
+}
+
+MotionPlanner::ExtendResult MotionPlanner::Extend(Tree &tree, const float *target, int &node)
+{
+    node = Nearest(tree, target);
+    // Kopia - dodanie węzła może przenieść tablicę drzewa
+    std::vector<float> near(tree.nodes.begin() + node * jointCount, tree.nodes.begin() + (node + 1) * jointCount);
+
+    float maxDelta = 0.0f;
+    for (int i = 0; i < jointCount; i++)
+        maxDelta = fmaxf(maxDelta, fabsf(target[i] - near[i]));
+
+    std::vector<float> next(target, target + jointCount);
+    ExtendResult result = ExtendResult::REACHED;
+    if (maxDelta > settings.stepSize)
+    {
+        for (int i = 0; i < jointCount; i++)
+            next[i] = near[i] + (target[i] - near[i]) * settings.stepSize / maxDelta;
+        result = ExtendResult::ADVANCED;
+    }
+
+    int stateCount = StateCount(near.data(), next.data());
+    if (stateCount == 0)
+        return ExtendResult::REACHED;
+    if (ValidPrefix(near.data(), next.data(), stateCount) < stateCount)
+        return ExtendResult::TRAPPED;
+    node = AddNode(tree, next.data(), node);
+    return result;
+}
+
+MotionPlanner::ExtendResult MotionPlanner::Connect(Tree &tree, const float *target, int &node)
+{
+    // Cała prosta do celu sprawdzana naraz (równolegle), potem węzły co stepSize
+    // wzdłuż poprawnej części - jak seria kroków Extend w tym samym kierunku
+    node = Nearest(tree, target);
+    std::vector<float> near(tree.nodes.begin() + node * jointCount, tree.nodes.begin() + (node + 1) * jointCount);
+
+    int stateCount = StateCount(near.data(), target);
+    if (stateCount == 0)
+        return ExtendResult::REACHED;
+    int valid = ValidPrefix(near.data(), target, stateCount);
+    if (valid == 0)
+        return ExtendResult::TRAPPED;
+
+    const int stride = std::max(1, (int)ceilf(settings.stepSize / settings.edgeResolution));
+    std::vector<float> q(jointCount);
+    for (int state = std::min(stride, valid);; state = std::min(state + stride, valid))
+    {
+        if (state == stateCount)
+        {
+            std::copy(target, target + jointCount, q.begin());
+        }
+        else
+        {
+            float t = state / (float)stateCount;
+            for (int i = 0; i < jointCount; i++)
+                q[i] = near[i] + (target[i] - near[i]) * t;
+        }
+        node = AddNode(tree, q.data(), node);
+        if (state == valid)
+            break;
+    }
+    return valid == stateCount ? ExtendResult::REACHED : ExtendResult::ADVANCED;
+}
+
+void MotionPlanner::BuildPath(const Tree &startTree, int startNode, const Tree &goalTree, int goalNode,
+                              std::vector<float> &path) const
+{
+    path.clear();
+    for (int node = startNode; node >= 0; node = startTree.parents[node])
+        path.insert(path.begin(), startTree.nodes.begin() + node * jointCount, startTree.nodes.begin() + (node + 1) * jointCount);
+    // goalNode ma tę samą konfigurację co startNode
+    for (int node = goalTree.parents[goalNode]; node >= 0; node = goalTree.parents[node])
+        path.insert(path.end(), goalTree.nodes.begin() + node * jointCount, goalTree.nodes.begin() + (node + 1) * jointCount);
+}
+
+void MotionPlanner::Shortcut(std::vector<float> &path, std::mt19937 &rng)
+{
+    for (int iteration = 0; iteration < settings.shortcutIterations; iteration++)
+    {
+        int count = (int)path.size() / jointCount;
+        if (count < 3 || std::chrono::steady_clock::now() > deadline)
+            break;
+
+        int first = std::uniform_int_distribution<int>(0, count - 3)(rng);
+        int last = std::uniform_int_distribution<int>(first + 2, count - 1)(rng);
+        const float *a = &path[first * jointCount];
+        const float *b = &path[last * jointCount];
+        int stateCount = StateCount(a, b);
+        if (ValidPrefix(a, b, stateCount) == stateCount)
+            path.erase(path.begin() + (first + 1) * jointCount, path.begin() + last * jointCount);
+    }
+}
+
+void MotionPlanner::Densify(const std::vector<float> &path, std::vector<float> &out) const
+{
+    // Gęste punkty na odcinkach trzymają splajn TimedTrajectory blisko sprawdzonej łamanej
+    const float spacing = settings.stepSize / 3.0f;
+    const int count = (int)path.size() / jointCount;
+    out.clear();
+    for (int k = 0; k + 1 < count; k++)
+    {
+        const float *a = &path[k * jointCount];
+        const float *b = &path[(k + 1) * jointCount];
+        float maxDelta = 0.0f;
+        for (int i = 0; i < jointCount; i++)
+            maxDelta = fmaxf(maxDelta, fabsf(b[i] - a[i]));
+        int steps = std::max(1, (int)ceilf(maxDelta / spacing));
+        for (int s = 0; s < steps; s++)
+        {
+            float t = s / (float)steps;
+            for (int i = 0; i < jointCount; i++)
+                out.push_back(a[i] + (b[i] - a[i]) * t);
+        }
+    }
+    out.insert(out.end(), path.end() - jointCount, path.end());
+}
+
+MotionPlan MotionPlanner::Plan(const float *start, const float *goal, const MotionPlannerSettings &planSettings)
+{
+    auto startTime = std::chrono::steady_clock::now();
+    settings = planSettings;
+    deadline = startTime + std::chrono::microseconds((long long)(settings.timeLimit * 1e6f));
+    stateChecks = 0;
+
+    MotionPlan plan;
+    auto finish = [&]()
+    {
+        plan.stateChecks = stateChecks;
+        plan.planningMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+        return plan;
+    };
+
+    if (!IsStateValid(start))
+    {
+        plan.status = MotionPlanStatus::START_IN_COLLISION;
+        return finish();
+    }
+    if (!IsStateValid(goal))
+    {
+        plan.status = MotionPlanStatus::GOAL_IN_COLLISION;
+        return finish();
+    }
+
+    Tree trees[2];
+    AddNode(trees[0], start, -1);
+    AddNode(trees[1], goal, -1);
+    std::vector<float> path;
+
+    // Najpierw prosta w przestrzeni przegubów - wystarcza przy wolnej drodze
+    int node;
+    if (Connect(trees[0], goal, node) == ExtendResult::REACHED)
+    {
+        BuildPath(trees[0], node, trees[1], 0, path);
+        plan.status = MotionPlanStatus::SUCCESS;
+    }
+
+    std::mt19937 rng(settings.seed);
+    std::vector<float> sample(jointCount);
+    int current = 0;
+    while (!plan.Succeeded() && std::chrono::steady_clock::now() < deadline)
+    {
+        plan.iterations++;
+        for (int i = 0; i < jointCount; i++)
+            sample[i] = std::uniform_real_distribution<float>(lowerLimits[i], upperLimits[i])(rng);
+
+        // Drzewa zamieniają się rolami: jedno rośnie do próbki, drugie łączy się z nowym węzłem
+        Tree &grown = trees[current];
+        Tree &other = trees[1 - current];
+        int grownNode, otherNode;
+        if (Extend(grown, sample.data(), grownNode) != ExtendResult::TRAPPED &&
+            Connect(other, &grown.nodes[grownNode * jointCount], otherNode) == ExtendResult::REACHED)
+        {
+            if (current == 0)
+                BuildPath(grown, grownNode, other, otherNode, path);
+            else
+                BuildPath(other, otherNode, grown, grownNode, path);
+            plan.status = MotionPlanStatus::SUCCESS;
+        }
+        current = 1 - current;
+    }
+    plan.treeNodes = (int)(trees[0].parents.size() + trees[1].parents.size());
+
+    if (plan.Succeeded())
+    {
+        Shortcut(path, rng);
+        plan.segments = (int)path.size() / jointCount - 1;
+        Densify(path, plan.waypoints);
+    }
+    return finish();
+}
@@ -1,4 +1,8 @@
 #include "object3D.h"
+#include "modelCache.h"
+#include "sceneBroadphase.h"
+#include "instancedRenderer.h"
+#include "renderQueue.h"
 
 int Object3D::nextId = 0;
 std::vector<Object3D*> Object3D::deleteQueue;
@@ -11,31 +15,31 @@ Object3D::Object3D(const char *modelPath, Shader shader) : shader(shader),
     modelPath(modelPath),
     id(nextId++)
 {
-    model = LoadModel(modelPath);
+    // Siatka, BVH i otoczka współdzielone przez wszystkie instancje tego pliku
+    asset = ModelCache::GetInstance().Acquire(modelPath, true, true);
     
-    // Tworzenie osobnej kopii materiału dla każdego obiektu
+    // Tworzenie osobnej kopii materiału dla każdego obiektu - rysowany zamiast materiałów z pliku
     material = LoadMaterialDefault();
     material.shader = shader;
-    
-    // Przypisanie nowego materiału do każdej siatki modelu
-    for (int i = 0; i < model.materialCount; i++) {
-        model.materials[i] = material;
-    }
 
     std::string baseName = fs::path(modelPath).stem().string();
     displayName = baseName + " (" + std::to_string(id) + ")";
-    
-    colorLoc = GetShaderLocation(shader, "materialColor");
+
     UpdateTransformMatrix();
+    proxyId = SceneBroadphase::GetInstance().CreateProxy(worldBounds, this);
+    proxyPosition = position;
+    instanceId = InstancedRenderer::GetInstance().CreateInstance(asset, shader, transformMatrix, color, worldSphere);
 }
 
 Object3D::~Object3D() 
 {
-    // Prawidłowe czyszczenie zasobów
-    for (int i = 0; i < model.materialCount; i++) {
-        UnloadMaterial(model.materials[i]);
-    }
-    UnloadModel(model);
+    SceneBroadphase::GetInstance().DestroyProxy(proxyId);
+    InstancedRenderer::GetInstance().DestroyInstance(instanceId);
+
+    // Prawidłowe czyszczenie zasobów - model zwalnia pamięć podręczna po ostatniej instancji
+    // Materiał domyślny ma tylko mapy; UnloadMaterial zwolniłby też wspólny shader sceny
+    MemFree(material.maps);
+    ModelCache::GetInstance().Release(asset);
 }
 
 void Object3D::UpdateTransformMatrix()
@@ -52,26 +56,103 @@ void Object3D::UpdateTransformMatrix()
     transformMatrix = MatrixMultiply(transformMatrix, rotationY);
     transformMatrix = MatrixMultiply(transformMatrix, rotationZ);
     transformMatrix = MatrixMultiply(transformMatrix, translation);
+    inverseTransform = MatrixInvert(transformMatrix);
+
+    // AABB świata z narożników lokalnego AABB - uwzględnia obrót
+    BoundingBox local = asset->bvh.GetBounds();
+    worldBounds = {Vector3Transform(local.min, transformMatrix), Vector3Transform(local.min, transformMatrix)};
+    for (int i = 1; i < 8; i++)
+    {
+        Vector3 corner = {(i & 1) ? local.max.x : local.min.x,
+                          (i & 2) ? local.max.y : local.min.y,
+                          (i & 4) ? local.max.z : local.min.z};
+        corner = Vector3Transform(corner, transformMatrix);
+        worldBounds.min = Vector3Min(worldBounds.min, corner);
+        worldBounds.max = Vector3Max(worldBounds.max, corner);
+    }
+    // Kula świata dla testu frustum: obrót jej nie zmienia, skala jest jednorodna
+    Vector3 center = Vector3Transform(Vector3Scale(Vector3Add(local.min, local.max), 0.5f), transformMatrix);
+    worldSphere = {center.x, center.y, center.z, 0.5f * Vector3Distance(local.min, local.max) * fabsf(scale)};
 
+    if (proxyId >= 0)
+    {
+        SceneBroadphase::GetInstance().MoveProxy(proxyId, worldBounds, Vector3Subtract(position, proxyPosition));
+        proxyPosition = position;
+    }
+    if (instanceId >= 0)
+        InstancedRenderer::GetInstance().UpdateInstance(instanceId, transformMatrix, color, worldSphere);
 }
 
-void Object3D::Draw()
+void Object3D::SetColor(Color col)
+{
+    color = col;
+    if (instanceId >= 0)
+        InstancedRenderer::GetInstance().UpdateInstance(instanceId, transformMatrix, color, worldSphere);
+}
+
+RayCollision Object3D::Raycast(Ray ray, float maxDistance) const
+{
+    // Kierunek znormalizowany w świecie: t w przestrzeni lokalnej to odległość w świecie
+    Vector3 direction = Vector3Normalize(ray.direction);
+    Vector3 origin = Vector3Transform(ray.position, inverseTransform);
+    Vector3 localDirection = Vector3Subtract(Vector3Transform(Vector3Add(ray.position, direction), inverseTransform), origin);
+
+    RayCollision hit = asset->bvh.Raycast(origin, localDirection, maxDistance);
+    if (hit.hit)
+    {
+        hit.point = Vector3Add(ray.position, Vector3Scale(direction, hit.distance));
+        Matrix normalMatrix = MatrixTranspose(inverseTransform);
+        normalMatrix.m12 = normalMatrix.m13 = normalMatrix.m14 = 0.0f;
+        hit.normal = Vector3Normalize(Vector3Transform(hit.normal, normalMatrix));
+    }
+    return hit;
+}
+
+bool Object3D::IntersectsSphere(Vector3 center, float radius) const
 {
-    BeginShaderMode(shader);
+    if (!CheckCollisionBoxSphere(worldBounds, center, radius) || scale <= 0.0f)
+        return false;
+    // Skala obiektu jest jednorodna, więc kula pozostaje kulą w przestrzeni lokalnej
+    return asset->bvh.IntersectsSphere(Vector3Transform(center, inverseTransform), radius / scale);
+}
 
-    // Ustaw kolor materiału
-    float colorVec[4] = {
-        color.r / 255.0f,
-        color.g / 255.0f,
-        color.b / 255.0f,
-        color.a / 255.0f};
-    SetShaderValue(shader, colorLoc, colorVec, SHADER_UNIFORM_VEC4);
+float Object3D::SegmentDistance(Vector3 a, Vector3 b, float maxDistance, Vector3 *closestPoint) const
+{
+    Vector3 reach = {maxDistance, maxDistance, maxDistance};
+    BoundingBox segmentBounds = {Vector3Subtract(Vector3Min(a, b), reach), Vector3Add(Vector3Max(a, b), reach)};
+    if (!CheckCollisionBoxes(worldBounds, segmentBounds) || scale <= 0.0f)
+        return maxDistance;
+
+    Vector3 localPoint;
+    float distance = asset->bvh.SegmentDistance(Vector3Transform(a, inverseTransform), Vector3Transform(b, inverseTransform),
+                                         maxDistance / scale, &localPoint) * scale;
+    if (closestPoint && distance < maxDistance)
+        *closestPoint = Vector3Transform(localPoint, transformMatrix);
+    return fminf(distance, maxDistance);
+}
 
-    // Narysuj model z transformacją
-    model.transform = transformMatrix;
-    DrawModel(model, Vector3Zero(), 1.0f, color);
+bool Object3D::IsSegmentWithin(Vector3 a, Vector3 b, float distance) const
+{
+    Vector3 reach = {distance, distance, distance};
+    BoundingBox segmentBounds = {Vector3Subtract(Vector3Min(a, b), reach), Vector3Add(Vector3Max(a, b), reach)};
+    if (!CheckCollisionBoxes(worldBounds, segmentBounds) || scale <= 0.0f)
+        return false;
+    return asset->bvh.SegmentWithin(Vector3Transform(a, inverseTransform), Vector3Transform(b, inverseTransform), distance / scale);
+}
 
-    EndShaderMode();
+void Object3D::Draw()
+{
+    RenderQueue &queue = RenderQueue::GetInstance();
+    Vector3 center = {worldSphere.x, worldSphere.y, worldSphere.z};
+    if (!queue.IsVisible(center, worldSphere.w))
+        return;
+    lodLevel = queue.SelectLod(asset->lod, center, worldSphere.w, lodLevel);
+
+    // Siatki wspólnego modelu z własnym materiałem i transformacją (jak DrawModel z odcieniem color)
+    material.maps[MATERIAL_MAP_DIFFUSE].color = color;
+    Matrix transform = MatrixMultiply(asset->model.transform, transformMatrix);
+    for (int i = 0; i < asset->model.meshCount; i++)
+        queue.Submit(asset->lod.GetMesh(asset->model, lodLevel, i), material, transform, color);
 }
 
 Object3D *Object3D::Create(const char *modelPath, Shader shader)
@@ -99,6 +180,8 @@ void Object3D::DrawImGuiControls()
     if (ImGui::CollapsingHeader(displayName.c_str()))
     {
         bool updated = false;
+        ImGui::TextDisabled("Trójkąty: %d, węzły BVH: %d (budowa %.1f ms), punkty otoczki: %d",
+                            asset->bvh.GetTriangleCount(), asset->bvh.GetNodeCount(), asset->bvh.GetBuildTime() * 1000.0f, (int)asset->hullPoints.size());
 
         if (ImGui::TreeNode("Transform"))
         {
@@ -121,7 +204,7 @@ void Object3D::DrawImGuiControls()
 
         if (ImGui::Button("Usuń obiekt"))
         {
-            markedForDeletion = true;
+            Delete(this);
         }
     }
     ImGui::PopID();
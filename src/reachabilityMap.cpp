@@ -0,0 +1,188 @@
+#include "reachabilityMap.h"
+#include "robotKinematics.h"
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+#include <random>
+#include <chrono>
+
+namespace
+{
+    const char MAGIC[4] = {'R', 'M', 'A', 'P'};
+    const uint32_t VERSION = 1;
+
+    struct FileHeader
+    {
+        char magic[4];
+        uint32_t version;
+        uint64_t configHash;
+        int32_t resolution;
+        float origin[3];
+        float voxelSize;
+    };
+}
+
+bool ReachabilityMap::LoadOrBuild(const fs::path &configDir, const RobotKinematics &kinematics)
+{
+    fs::path path = configDir / "reachability.bin";
+    if (Load(path, kinematics.GetConfigHash()))
+    {
+        return true;
+    }
+
+    Build(kinematics);
+    fs::create_directories(configDir);
+    if (!Save(path))
+    {
+        TraceLog(LOG_WARNING, "Nie udało się zapisać mapy osiągalności: %s", path.string().c_str());
+    }
+    return IsLoaded();
+}
+
+void ReachabilityMap::Build(const RobotKinematics &kinematics, int sampleCount)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    const int meshCount = kinematics.GetMeshCount();
+    const float reach = kinematics.GetTotalLength() * 1.05f;
+    const Vector3 base = kinematics.GetPivotPoint(0);
+
+    configHash = kinematics.GetConfigHash();
+    voxelSize = 2.0f * reach / RESOLUTION;
+    origin = Vector3Subtract(base, Vector3{reach, reach, reach});
+
+    // Próbkowanie przestrzeni przegubów wsadowym FK
+    const int CHUNK = 65536;
+    BatchKinematics fk = kinematics.CreateBatchKinematics();
+    const float invScale = 1.0f / kinematics.GetScale();
+
+    std::mt19937 rng(1234);
+    std::vector<std::uniform_real_distribution<float>> distributions;
+    for (int j = 0; j < meshCount; j++)
+    {
+        const JointLimit &limit = kinematics.GetJointLimit(j);
+        distributions.emplace_back(limit.min, limit.max);
+    }
+
+    std::vector<float> angles(meshCount * CHUNK);
+    std::vector<float> x(CHUNK), y(CHUNK), z(CHUNK);
+    std::vector<uint32_t> counts(RESOLUTION * RESOLUTION * RESOLUTION, 0);
+
+    for (int done = 0; done < sampleCount; done += CHUNK)
+    {
+        int count = std::min(CHUNK, sampleCount - done);
+        for (int j = 0; j < meshCount; j++)
+        {
+            for (int c = 0; c < count; c++)
+                angles[j * CHUNK + c] = distributions[j](rng);
+        }
+        fk.Evaluate(angles.data(), CHUNK, count, x.data(), y.data(), z.data());
+
+        for (int c = 0; c < count; c++)
+        {
+            int ix = (int)floorf((x[c] * invScale - origin.x) / voxelSize);
+            int iy = (int)floorf((y[c] * invScale - origin.y) / voxelSize);
+            int iz = (int)floorf((z[c] * invScale - origin.z) / voxelSize);
+            if (ix < 0 || iy < 0 || iz < 0 || ix >= RESOLUTION || iy >= RESOLUTION || iz >= RESOLUTION)
+                continue;
+            counts[Index(ix, iy, iz)]++;
+        }
+    }
+
+    uint32_t maxCount = 1;
+    for (uint32_t c : counts)
+        maxCount = std::max(maxCount, c);
+
+    voxels.assign(counts.size(), 0);
+    const float norm = 254.0f / logf(1.0f + maxCount);
+    for (size_t i = 0; i < counts.size(); i++)
+    {
+        if (counts[i] > 0)
+            voxels[i] = (uint8_t)(1.0f + norm * logf(1.0f + counts[i]));
+    }
+
+    // Dylatacja o jeden woksel zamyka dziury wynikające z losowego próbkowania
+    std::vector<uint8_t> dilated = voxels;
+    for (int iz = 1; iz < RESOLUTION - 1; iz++)
+    {
+        for (int iy = 1; iy < RESOLUTION - 1; iy++)
+        {
+            for (int ix = 1; ix < RESOLUTION - 1; ix++)
+            {
+                int i = Index(ix, iy, iz);
+                if (voxels[i] != 0)
+                    continue;
+                if (voxels[i - 1] || voxels[i + 1] ||
+                    voxels[i - RESOLUTION] || voxels[i + RESOLUTION] ||
+                    voxels[i - RESOLUTION * RESOLUTION] || voxels[i + RESOLUTION * RESOLUTION])
+                {
+                    dilated[i] = 1;
+                }
+            }
+        }
+    }
+    voxels.swap(dilated);
+
+    buildTime = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+    TraceLog(LOG_INFO, "Mapa osiągalności zbudowana: %d próbek, %.2f s", sampleCount, buildTime);
+}
+
+uint8_t ReachabilityMap::GetQuality(const Vector3 &modelPosition) const
+{
+    if (voxels.empty())
+        return 0;
+
+    int ix = (int)floorf((modelPosition.x - origin.x) / voxelSize);
+    int iy = (int)floorf((modelPosition.y - origin.y) / voxelSize);
+    int iz = (int)floorf((modelPosition.z - origin.z) / voxelSize);
+    if (ix < 0 || iy < 0 || iz < 0 || ix >= RESOLUTION || iy >= RESOLUTION || iz >= RESOLUTION)
+        return 0;
+    return voxels[Index(ix, iy, iz)];
+}
+
+bool ReachabilityMap::Load(const fs::path &path, uint64_t expectedHash)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open())
+        return false;
+
+    FileHeader header;
+    if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)))
+        return false;
+    if (memcmp(header.magic, MAGIC, 4) != 0 || header.version != VERSION ||
+        header.configHash != expectedHash || header.resolution != RESOLUTION)
+    {
+        return false;
+    }
+
+    std::vector<uint8_t> data(RESOLUTION * RESOLUTION * RESOLUTION);
+    if (!file.read(reinterpret_cast<char *>(data.data()), data.size()))
+        return false;
+
+    configHash = header.configHash;
+    origin = {header.origin[0], header.origin[1], header.origin[2]};
+    voxelSize = header.voxelSize;
+    voxels.swap(data);
+    return true;
+}
+
+bool ReachabilityMap::Save(const fs::path &path) const
+{
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open())
+        return false;
+
+    FileHeader header;
+    memcpy(header.magic, MAGIC, 4);
+    header.version = VERSION;
+    header.configHash = configHash;
+    header.resolution = RESOLUTION;
+    header.origin[0] = origin.x;
+    header.origin[1] = origin.y;
+    header.origin[2] = origin.z;
+    header.voxelSize = voxelSize;
+
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(voxels.data()), voxels.size());
+    return file.good();
+}
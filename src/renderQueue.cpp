@@ -0,0 +1,309 @@
+#include "renderQueue.h"
+#include "rlgl.h"
+#include "imgui.h"
+#include <algorithm>
+#include <cstddef>
+#include <tuple>
+
+static uint32_t PackColor(Color color)
+{
+    return ((uint32_t)color.r << 24) | ((uint32_t)color.g << 16) | ((uint32_t)color.b << 8) | color.a;
+}
+
+static void SetColorUniform(int location, uint32_t packed)
+{
+    float values[4] = {(packed >> 24) / 255.0f, ((packed >> 16) & 0xFF) / 255.0f,
+                       ((packed >> 8) & 0xFF) / 255.0f, (packed & 0xFF) / 255.0f};
+    rlSetUniform(location, values, RL_SHADER_UNIFORM_VEC4, 1);
+}
+
+void RenderQueue::BeginFrame()
+{
+    stats = {};
+    view = rlGetMatrixModelview();
+    projection = rlGetMatrixProjection();
+    frustum = Frustum::FromMatrix(MatrixMultiply(view, projection));
+}
+
+bool RenderQueue::IsVisible(Vector3 center, float radius)
+{
+    if (frustum.IntersectsSphere(center, radius))
+        return true;
+    stats.culled++;
+    return false;
+}
+
+float RenderQueue::ProjectedSize(Vector3 center, float radius) const
+{
+    // Projekcja ortograficzna (m11 == 0): wielkość nie zależy od odległości
+    if (projection.m11 == 0.0f)
+        return radius * projection.m5;
+
+    // Głębokość środka wzdłuż osi widoku (kamera patrzy w -z)
+    float depth = -(view.m2 * center.x + view.m6 * center.y + view.m10 * center.z + view.m14);
+    if (depth <= radius)
+        return INFINITY;
+    return radius * projection.m5 / depth;
+}
+
+int RenderQueue::SelectLod(const ModelLod &lod, Vector3 center, float radius, int current)
+{
+    int level = 0;
+    if (lodEnabled && lod.GetLevelCount() > 1)
+        level = ModelLod::SelectLevel(ProjectedSize(center, radius) * lodBias, current, lod.GetLevelCount());
+    stats.lodObjects[level]++;
+    return level;
+}
+
+void RenderQueue::Submit(const Mesh &mesh, const Material &material, Matrix transform, Color tint)
+{
+    const MaterialMap &diffuse = material.maps[MATERIAL_MAP_DIFFUSE];
+    items.push_back({&mesh, material.shader, diffuse.texture.id, PackColor(diffuse.color), PackColor(tint), transform, 0, 0});
+}
+
+void RenderQueue::SubmitInstanced(const Mesh &mesh, Shader shader, unsigned int instanceBuffer, int instanceCount)
+{
+    if (instanceCount <= 0)
+        return;
+    // Kolor każdej instancji jest w buforze - uniformy koloru neutralne
+    items.push_back({&mesh, shader, 0, PackColor(WHITE), PackColor(WHITE), MatrixIdentity(), instanceBuffer, instanceCount});
+}
+
+void RenderQueue::SubmitSkinned(const Mesh &mesh, const Material &material, Color tint, const Vector4 *linkRows, int linkCount)
+{
+    if (linkCount <= 0)
+        return;
+    const MaterialMap &diffuse = material.maps[MATERIAL_MAP_DIFFUSE];
+    items.push_back({&mesh, material.shader, diffuse.texture.id, PackColor(diffuse.color), PackColor(tint), MatrixIdentity(),
+                     0, 0, linkRows, linkCount});
+}
+
+bool RenderQueue::DrawsBefore(const Item &a, const Item &b)
+{
+    return std::make_tuple(a.shader.id, DrawMode(a), a.texture, a.diffuse, a.mesh->vaoId, a.tint) <
+           std::make_tuple(b.shader.id, DrawMode(b), b.texture, b.diffuse, b.mesh->vaoId, b.tint);
+}
+
+void RenderQueue::SetModeUniforms(const ShaderLocations &locations, int mode, int &current)
+{
+    if (mode == current)
+        return;
+    if (locations.instancing != -1 && (current < 0 || (current == 1) != (mode == 1)))
+    {
+        int enabled = mode == 1 ? 1 : 0;
+        rlSetUniform(locations.instancing, &enabled, RL_SHADER_UNIFORM_INT, 1);
+        stats.uniformChanges++;
+    }
+    if (locations.skinning != -1 && (current < 0 || (current == 2) != (mode == 2)))
+    {
+        int enabled = mode == 2 ? 1 : 0;
+        rlSetUniform(locations.skinning, &enabled, RL_SHADER_UNIFORM_INT, 1);
+        stats.uniformChanges++;
+    }
+    current = mode;
+}
+
+const RenderQueue::ShaderLocations &RenderQueue::GetLocations(Shader shader)
+{
+    auto found = locations.find(shader.id);
+    if (found != locations.end())
+        return found->second;
+
+    ShaderLocations &entry = locations[shader.id];
+    entry.materialColor = GetShaderLocation(shader, "materialColor");
+    entry.instancing = GetShaderLocation(shader, "instancing");
+    entry.instanceTransform = GetShaderLocationAttrib(shader, "instanceTransform");
+    entry.instanceColor = GetShaderLocationAttrib(shader, "instanceColor");
+    entry.skinning = GetShaderLocation(shader, "skinning");
+    entry.linkMatrices = GetShaderLocation(shader, "linkMatrices");
+    return entry;
+}
+
+void RenderQueue::Flush()
+{
+    stats.items += (int)items.size();
+    if (items.empty())
+        return;
+
+    order.resize(items.size());
+    for (uint32_t i = 0; i < (uint32_t)order.size(); i++)
+        order[i] = i;
+    // Stabilnie - elementy o tym samym stanie zachowują kolejność zgłoszenia
+    std::stable_sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b)
+                     { return DrawsBefore(items[a], items[b]); });
+
+    // Linie i inne prymitywy z bieżącej paczki rlgl przed bezpośrednimi wywołaniami GL
+    rlDrawRenderBatchActive();
+    Matrix view = rlGetMatrixModelview();
+    Matrix projection = rlGetMatrixProjection();
+    Matrix viewProjection = MatrixMultiply(view, projection);
+
+    const Shader *shader = nullptr;
+    const ShaderLocations *shaderLocations = nullptr;
+    unsigned int texture = 0;
+    unsigned int vao = 0;
+    uint32_t diffuse = 0, tint = 0;
+    int mode = -1;
+    const Vector4 *linkRows = nullptr;
+    bool colorsValid = false;
+
+    for (uint32_t index : order)
+    {
+        const Item &item = items[index];
+
+        if (!shader || item.shader.id != shader->id)
+        {
+            // Przełączniki zostają wyłączone w opuszczanym shaderze - inne ścieżki ich nie ustawiają
+            if (shader && mode > 0)
+                SetModeUniforms(*shaderLocations, 0, mode);
+
+            shader = &item.shader;
+            shaderLocations = &GetLocations(item.shader);
+            rlEnableShader(shader->id);
+            stats.shaderChanges++;
+
+            // Uniformy widoku raz na shader
+            if (shader->locs[SHADER_LOC_MATRIX_VIEW] != -1)
+                rlSetUniformMatrix(shader->locs[SHADER_LOC_MATRIX_VIEW], view);
+            if (shader->locs[SHADER_LOC_MATRIX_PROJECTION] != -1)
+                rlSetUniformMatrix(shader->locs[SHADER_LOC_MATRIX_PROJECTION], projection);
+            if (shader->locs[SHADER_LOC_MAP_DIFFUSE] != -1)
+            {
+                int slot = 0;
+                rlSetUniform(shader->locs[SHADER_LOC_MAP_DIFFUSE], &slot, RL_SHADER_UNIFORM_INT, 1);
+            }
+            mode = -1;
+            linkRows = nullptr;
+            colorsValid = false;
+        }
+
+        unsigned int itemTexture = item.texture != 0 ? item.texture : rlGetTextureIdDefault();
+        if (itemTexture != texture)
+        {
+            rlActiveTextureSlot(0);
+            rlEnableTexture(itemTexture);
+            texture = itemTexture;
+            stats.textureChanges++;
+        }
+
+        SetModeUniforms(*shaderLocations, DrawMode(item), mode);
+        // Paczki jednego robota dzielą macierze ogniw
+        if (item.linkCount > 0 && item.linkRows != linkRows && shaderLocations->linkMatrices != -1)
+        {
+            rlSetUniform(shaderLocations->linkMatrices, item.linkRows, RL_SHADER_UNIFORM_VEC4, item.linkCount * 3);
+            linkRows = item.linkRows;
+            stats.uniformChanges++;
+        }
+
+        if (!colorsValid || item.diffuse != diffuse)
+        {
+            if (shader->locs[SHADER_LOC_COLOR_DIFFUSE] != -1)
+            {
+                SetColorUniform(shader->locs[SHADER_LOC_COLOR_DIFFUSE], item.diffuse);
+                stats.uniformChanges++;
+            }
+            diffuse = item.diffuse;
+        }
+        if (!colorsValid || item.tint != tint)
+        {
+            if (shaderLocations->materialColor != -1)
+            {
+                SetColorUniform(shaderLocations->materialColor, item.tint);
+                stats.uniformChanges++;
+            }
+            tint = item.tint;
+        }
+        colorsValid = true;
+
+        // Macierze zmieniają się z każdym elementem - jak w DrawMesh
+        Matrix model = item.transform;
+        if (shader->locs[SHADER_LOC_MATRIX_MODEL] != -1)
+            rlSetUniformMatrix(shader->locs[SHADER_LOC_MATRIX_MODEL], model);
+        if (shader->locs[SHADER_LOC_MATRIX_NORMAL] != -1)
+            rlSetUniformMatrix(shader->locs[SHADER_LOC_MATRIX_NORMAL], MatrixTranspose(MatrixInvert(model)));
+        rlSetUniformMatrix(shader->locs[SHADER_LOC_MATRIX_MVP],
+                           mode != 0 ? viewProjection : MatrixMultiply(MatrixMultiply(model, view), projection));
+
+        if (item.mesh->vaoId != vao)
+        {
+            if (!rlEnableVertexArray(item.mesh->vaoId))
+                continue;
+            vao = item.mesh->vaoId;
+            stats.meshChanges++;
+        }
+
+        if (item.instanceBuffer != 0)
+        {
+            DrawInstanced(item, *shaderLocations);
+        }
+        else if (item.mesh->indices != nullptr)
+        {
+            rlDrawVertexArrayElements(0, item.mesh->triangleCount * 3, nullptr);
+        }
+        else
+        {
+            rlDrawVertexArray(0, item.mesh->vertexCount);
+        }
+        stats.drawCalls++;
+    }
+
+    if (shader && mode > 0)
+        SetModeUniforms(*shaderLocations, 0, mode);
+    rlDisableVertexArray();
+    rlDisableTexture();
+    rlDisableShader();
+    items.clear();
+}
+
+void RenderQueue::DrawInstanced(const Item &item, const ShaderLocations &locations)
+{
+    if (locations.instanceTransform < 0 || locations.instanceColor < 0)
+        return;
+
+    // Atrybuty instancji dopinane do VAO siatki tylko na czas rysowania -
+    // ta sama siatka rysowana bez instancji ich nie widzi
+    const int stride = (int)sizeof(RenderInstance);
+    rlEnableVertexBuffer(item.instanceBuffer);
+    for (int i = 0; i < 4; i++)
+    {
+        rlEnableVertexAttribute(locations.instanceTransform + i);
+        rlSetVertexAttribute(locations.instanceTransform + i, 4, RL_FLOAT, false, stride, i * (int)sizeof(Vector4));
+        rlSetVertexAttributeDivisor(locations.instanceTransform + i, 1);
+    }
+    rlEnableVertexAttribute(locations.instanceColor);
+    rlSetVertexAttribute(locations.instanceColor, 4, RL_FLOAT, false, stride, (int)offsetof(RenderInstance, color));
+    rlSetVertexAttributeDivisor(locations.instanceColor, 1);
+
+    if (item.mesh->indices != nullptr)
+        rlDrawVertexArrayElementsInstanced(0, item.mesh->triangleCount * 3, nullptr, item.instanceCount);
+    else
+        rlDrawVertexArrayInstanced(0, item.mesh->vertexCount, item.instanceCount);
+    stats.instances += item.instanceCount;
+
+    for (int i = 0; i < 4; i++)
+    {
+        rlSetVertexAttributeDivisor(locations.instanceTransform + i, 0);
+        rlDisableVertexAttribute(locations.instanceTransform + i);
+    }
+    rlSetVertexAttributeDivisor(locations.instanceColor, 0);
+    rlDisableVertexAttribute(locations.instanceColor);
+    rlDisableVertexBuffer();
+}
+
+void RenderQueue::DrawImGuiControls()
+{
+    if (ImGui::TreeNode("Kolejka renderowania"))
+    {
+        // Bez kolejki każdy element to osobny DrawMesh: shader, tekstura, VAO i kolor od nowa
+        ImGui::Text("Elementy: %d, wywołania rysowania: %d, instancje: %d", stats.items, stats.drawCalls, stats.instances);
+        ImGui::Text("Zmiany shadera: %d, tekstury: %d, VAO: %d, uniformów koloru: %d",
+                    stats.shaderChanges, stats.textureChanges, stats.meshChanges, stats.uniformChanges);
+        ImGui::Text("Odrzucone poza kamerą: %d", stats.culled);
+        ImGui::Checkbox("Poziomy szczegółowości (LOD)", &lodEnabled);
+        ImGui::SliderFloat("Mnożnik LOD", &lodBias, 0.25f, 4.0f);
+        ImGui::Text("Poziomy 0-3: %d / %d / %d / %d", stats.lodObjects[0], stats.lodObjects[1], stats.lodObjects[2],
+                    stats.lodObjects[3]);
+        ImGui::TextDisabled("Bez sortowania i filtrowania: po %d zmian każdego stanu", stats.items);
+        ImGui::TreePop();
+    }
+}
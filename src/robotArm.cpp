@@ -1,11 +1,18 @@
 #include "robotArm.h"
+#include "threadPool.h"
+#include "modelCache.h"
+#include "sceneBroadphase.h"
+#include "renderQueue.h"
+#include "simd.h"
+#include <algorithm>
+#include <cfloat>
+#include <random>
 
 RobotArm::RobotArm(const char *modelPath, Shader shader) 
-    : shader(shader), logWindow(LogWindow::GetInstance())
+    : modelAsset(ModelCache::GetInstance().Acquire(modelPath, false, true)), model(modelAsset->model),
+      shader(shader), logWindow(LogWindow::GetInstance())
 {
-    model = LoadModel(modelPath);
     meshVisibility = new bool[model.meshCount];
-    meshRotations = new ArmRotation[model.meshCount];
     scale = 0.01f;
     color = WHITE;
     showPivotPoints = false;
@@ -15,42 +22,64 @@ RobotArm::RobotArm(const char *modelPath, Shader shader)
     for (int i = 0; i < model.meshCount; i++)
     {
         meshVisibility[i] = true;
-        meshRotations[i] = {0.0f, {0.0f, 1.0f, 0.0f}};
     }
 
-    // Ustaw osie obrotu dla poszczególnych części
-    meshRotations[0].axis = {0.0f, 1.0f, 0.0f}; // Baza
-    meshRotations[1].axis = {0.0f, 1.0f, 0.0f}; // Ramię 1
-    meshRotations[2].axis = {0.0f, 0.0f, 1.0f}; // Ramię 2
-    meshRotations[3].axis = {0.0f, 0.0f, 1.0f}; // Chwytak
-    meshRotations[4].axis = {1.0f, 0.0f, 0.0f}; // Obrót chwytaka
-    meshRotations[5].axis = {0.0f, 0.0f, 1.0f}; // Obrót chwytaka
-
-    pivotPoints = new Vector3[model.meshCount + 1];
-
-    pivotPoints[0] = {0.0f, 0.0f, 0.0f};      // Baza
-    pivotPoints[1] = {0.0f, 100.0f, 0.0f};    // Punkt obrotu ramienia 1
-    pivotPoints[2] = {0.0f, 350.0f, 0.0f};    // Punkt obrotu ramienia 2
-    pivotPoints[3] = {0.0f, 660.0f, 0.0f};    // Punkt obrotu ramienia 3
-    pivotPoints[4] = {-58.0f, 708.0f, 0.0f};  // Punkt obrotu ramienia 4
-    pivotPoints[5] = {-338.0f, 708.0f, 0.0f}; // Punkt obrotu ramienia 5
-    pivotPoints[6] = {-426.0f, 708.0f, 0.0f}; // Punkt obrotu chwytaka
-
-    armLengths = new float[model.meshCount + 1];
+    // Kinematyka z konfiguracji modelu (.<nazwa>/config.json), domyślna geometria jako zapas
+    configDir = (fs::path(modelPath).parent_path() / ("." + fs::path(modelPath).stem().string())).string();
+    if (!description.LoadFromFile(fs::path(configDir) / "config.json") ||
+        description.GetJointCount() != model.meshCount)
+    {
+        TraceLog(LOG_WARNING, "Brak zgodnego opisu przegubów w %s - używam domyślnej geometrii", configDir.c_str());
+        description = RobotDescription::CreateDefault(model.meshCount);
+    }
 
-    armLengths[0] = Vector3Distance(pivotPoints[0], pivotPoints[1]);
-    armLengths[1] = Vector3Distance(pivotPoints[1], pivotPoints[2]);
-    armLengths[2] = Vector3Distance(pivotPoints[2], pivotPoints[3]);
-    armLengths[3] = Vector3Distance(pivotPoints[3], pivotPoints[4]);
-    armLengths[4] = Vector3Distance(pivotPoints[4], pivotPoints[5]);
-    armLengths[5] = Vector3Distance(pivotPoints[5], pivotPoints[6]);
+    meshRotations.resize(model.meshCount);
+    for (int i = 0; i < model.meshCount; i++)
+    {
+        meshRotations[i] = {0.0f, description.joints[i].axis};
+    }
+    previousStepAngles.assign(model.meshCount, 0.0f);
+    currentStepAngles.assign(model.meshCount, 0.0f);
+    renderRotations = meshRotations;
+    renderTransforms.assign(model.meshCount, MatrixIdentity());
 
-    // Pobierz lokalizację koloru w shaderze
-    colorLoc = GetShaderLocation(shader, "materialColor");
+    // Lokalne kule otaczające ogniw do testu frustum przy rysowaniu
+    meshBounds.resize(model.meshCount);
+    for (int i = 0; i < model.meshCount; i++)
+    {
+        BoundingBox box = GetMeshBoundingBox(model.meshes[i]);
+        Vector3 center = Vector3Scale(Vector3Add(box.min, box.max), 0.5f);
+        meshBounds[i] = {center.x, center.y, center.z, 0.5f * Vector3Distance(box.min, box.max)};
+    }
+    meshLod.assign(model.meshCount, -1);
 
     defaultMaterial = LoadMaterialDefault();
     defaultMaterial.shader = shader;
-    kinematics = new RobotKinematics(pivotPoints, armLengths, meshRotations, model.meshCount, scale);
+    skinnedModel.Build(*modelAsset, shader);
+    linkRows.resize(model.meshCount * 3);
+    kinematics = new RobotKinematics(&description, meshRotations.data(), scale);
+    PrepareRender(1.0f);
+
+    // Mapa osiągalności i baza IK leżą obok konfiguracji modelu
+    if (reachabilityMap.LoadOrBuild(configDir, *kinematics))
+    {
+        kinematics->SetReachabilityMap(&reachabilityMap);
+    }
+    if (seedDatabase.LoadOrBuild(configDir, *kinematics))
+    {
+        kinematics->SetSeedDatabase(&seedDatabase);
+    }
+
+    // Kapsuły ogniw; pary do testu własnego wybierane w pozycji zerowej
+    linkCollision.Fit(model.meshes, model.meshCount);
+    stepTransforms.resize(model.meshCount);
+    for (int i = 0; i < model.meshCount; i++)
+        stepTransforms[i] = kinematics->GetJointTransform(i);
+    linkCollision.UpdatePose(stepTransforms.data(), scale);
+    linkCollision.BuildSelfPairs();
+    minLinkDistance = FLT_MAX;
+    TraceLog(LOG_INFO, "Model kolizji ogniw: %d kapsuł, %d par testu własnego",
+             (int)linkCollision.GetCapsules().size(), linkCollision.GetSelfPairCount());
 
     gripperRadius = 20.0f;
     isColliding = false;
@@ -59,10 +88,9 @@ RobotArm::RobotArm(const char *modelPath, Shader shader)
 
 RobotArm::~RobotArm()
 {
-    UnloadModel(model);
-    delete[] meshRotations;
+    skinnedModel.Unload();
+    ModelCache::GetInstance().Release(modelAsset);
     delete[] meshVisibility;
-    delete[] pivotPoints;
     UnloadMaterial(defaultMaterial);
     delete kinematics;
     if (L)
@@ -71,23 +99,57 @@ RobotArm::~RobotArm()
 
 void RobotArm::Draw()
 {
-    BeginShaderMode(shader);
-    float colorVec[4] = {color.r / 255.0f, color.g / 255.0f, color.b / 255.0f, color.a / 255.0f};
-    SetShaderValue(shader, colorLoc, colorVec, SHADER_UNIFORM_VEC4);
+    // Ogniwa trafiają do kolejki renderowania klatki razem z obiektami sceny
+    RenderQueue &queue = RenderQueue::GetInstance();
+    Matrix scaleMatrix = MatrixScale(scale, scale, scale);
+    if (useSkinning && skinnedModel.IsReady())
+    {
+        // Całe ramię jednym wywołaniem na paczkę; ukryte ogniwa mają zerową macierz,
+        // a frustum i poziom szczegółowości liczone są dla kuli obejmującej widoczne ogniwa
+        Vector3 minimum = {INFINITY, INFINITY, INFINITY}, maximum = {-INFINITY, -INFINITY, -INFINITY};
+        for (int i = 0; i < model.meshCount; i++)
+        {
+            if (!meshVisibility[i])
+            {
+                linkRows[i * 3] = linkRows[i * 3 + 1] = linkRows[i * 3 + 2] = {0.0f, 0.0f, 0.0f, 0.0f};
+                continue;
+            }
+            Matrix finalTransform = MatrixMultiply(renderTransforms[i], scaleMatrix);
+            SkinnedModel::PackLinkMatrix(finalTransform, &linkRows[i * 3]);
+            Vector3 center = Vector3Transform({meshBounds[i].x, meshBounds[i].y, meshBounds[i].z}, finalTransform);
+            float radius = meshBounds[i].w * scale;
+            minimum = Vector3Min(minimum, {center.x - radius, center.y - radius, center.z - radius});
+            maximum = Vector3Max(maximum, {center.x + radius, center.y + radius, center.z + radius});
+        }
 
-    for (int i = 0; i < model.meshCount; i++)
+        Vector3 center = Vector3Scale(Vector3Add(minimum, maximum), 0.5f);
+        float radius = 0.5f * Vector3Distance(minimum, maximum);
+        if (minimum.x <= maximum.x && queue.IsVisible(center, radius))
+        {
+            skinnedLod = std::min(queue.SelectLod(modelAsset->lod, center, radius, skinnedLod), skinnedModel.GetLevelCount() - 1);
+            for (const SkinnedModel::Batch &batch : skinnedModel.GetBatches(skinnedLod))
+                queue.SubmitSkinned(batch.mesh, defaultMaterial, color, linkRows.data(), model.meshCount);
+        }
+    }
+    else
     {
-        if (meshVisibility[i])
+        for (int i = 0; i < model.meshCount; i++)
         {
-            Matrix hierarchicalTransform = RobotKinematics::GetHierarchicalTransform(i, meshRotations, pivotPoints);
-            Matrix scaleMatrix = MatrixScale(scale, scale, scale);
-            Matrix finalTransform = MatrixMultiply(hierarchicalTransform, scaleMatrix);
-            DrawMesh(model.meshes[i], defaultMaterial, finalTransform);
+            if (!meshVisibility[i])
+                continue;
+            Matrix finalTransform = MatrixMultiply(renderTransforms[i], scaleMatrix);
+            Vector3 center = Vector3Transform({meshBounds[i].x, meshBounds[i].y, meshBounds[i].z}, finalTransform);
+            float radius = meshBounds[i].w * scale;
+            if (!queue.IsVisible(center, radius))
+                continue;
+            meshLod[i] = queue.SelectLod(modelAsset->lod, center, radius, meshLod[i]);
+            queue.Submit(modelAsset->lod.GetMesh(model, meshLod[i], i), defaultMaterial, finalTransform, color);
         }
     }
-    EndShaderMode();
     DrawTrajectory();
     DrawGripper();
+    if (showCapsules)
+        linkCollision.Draw(linkContacts);
 }
 
 void RobotArm::DrawPivotPoints()
@@ -97,9 +159,7 @@ void RobotArm::DrawPivotPoints()
 
     for (int i = 0; i <= model.meshCount; i++)
     {
-        Matrix parentTransform = (i == 0) ? MatrixIdentity() : RobotKinematics::GetHierarchicalTransform(i - 1, meshRotations, pivotPoints);
-        Vector3 globalPivotPos = Vector3Transform(pivotPoints[i], parentTransform);
-        globalPivotPos = Vector3Scale(globalPivotPos, scale);
+        Vector3 globalPivotPos = kinematics->GetJointPosition(i);
 
         DrawSphere(globalPivotPos, 0.1f, RED);
         DrawSphereWires(globalPivotPos, 0.5f, 8, 8, BLACK);
@@ -110,7 +170,7 @@ void RobotArm::SetPivotPoint(int index, Vector3 position)
 {
     if (index < model.meshCount)
     {
-        pivotPoints[index] = position;
+        description.joints[index].pivot = position;
     }
 }
 
@@ -140,6 +200,11 @@ void RobotArm::DrawImGuiControls()
             // Wyświetl aktualny stan
             ImGui::Text("Stan: %s", isColliding ? "Wykryto obiekt" : "Brak kolizji");
             ImGui::Text("Chwytanie: %s", isGripping ? "Aktywne" : "Nieaktywne");
+            if (isColliding)
+            {
+                const Vector3 &n = gripperContact.normal;
+                ImGui::Text("Przenikanie: %.4f  Normalna: %.2f %.2f %.2f", -gripperContact.distance, n.x, n.y, n.z);
+            }
 
             // Przyciski sterowania chwytakiem
             if (isColliding && !isGripping)
@@ -168,8 +233,33 @@ void RobotArm::DrawImGuiControls()
 
             ImGui::TreePop();
         }
+        if (ImGui::TreeNode("Kolizje ogniw"))
+        {
+            ImGui::Checkbox("Pokaż kapsuły", &showCapsules);
+            ImGui::SliderFloat("Margines", &contactMargin, 0.0f, 0.5f, "%.3f");
+            ImGui::Text("Kapsuły: %d  Pary testu własnego: %d", (int)linkCollision.GetCapsules().size(),
+                        linkCollision.GetSelfPairCount());
+            ImGui::Text("Kolizje: %d  Min. odległość: %s", linkCollisionCount,
+                        minLinkDistance < FLT_MAX ? TextFormat("%.3f", minLinkDistance) : "-");
+
+            for (const LinkContact &contact : linkContacts)
+            {
+                const char *other = contact.type == LinkContactType::SCENE ? "obiekt sceny" : description.names[contact.otherLink].c_str();
+                ImVec4 textColor = contact.distance < 0.0f ? ImVec4(1.0f, 0.4f, 0.4f, 1.0f) : ImVec4(1.0f, 0.8f, 0.3f, 1.0f);
+                ImGui::TextColored(textColor, "%s - %s: %.3f", description.names[contact.link].c_str(), other, contact.distance);
+            }
+
+            if (ImGui::Button("Benchmark kolizji ogniw"))
+            {
+                BenchmarkLinkCollisions();
+            }
+            ImGui::TreePop();
+        }
         if (ImGui::TreeNode("Mesh Visibility"))
         {
+            ImGui::BeginDisabled(!skinnedModel.IsReady());
+            ImGui::Checkbox("Jedno wywołanie rysowania (skinning)", &useSkinning);
+            ImGui::EndDisabled();
             for (int i = 0; i < model.meshCount; i++)
             {
                 char label[32];
@@ -183,9 +273,8 @@ void RobotArm::DrawImGuiControls()
         {
             for (int i = 0; i < model.meshCount; i++)
             {
-                char label[32];
-                sprintf(label, "Joint %d", i);
-                ImGui::SliderFloat(label, &meshRotations[i].angle, -180.0f, 180.0f);
+                const JointLimit &limit = description.joints[i].limit;
+                ImGui::SliderFloat(description.names[i].c_str(), &meshRotations[i].angle, limit.min, limit.max);
             }
             ImGui::TreePop();
         }
@@ -196,15 +285,15 @@ void RobotArm::DrawImGuiControls()
 
             for (int i = 0; i <= model.meshCount; i++)
             {
-                char label[50];
-                sprintf(label, "Pivot %d", i);
-                if (ImGui::TreeNode(label))
+                if (ImGui::TreeNode(description.names[i].c_str()))
                 {
                     ImGui::PushItemWidth(200);
 
-                    if (float pos[3] = {pivotPoints[i].x, pivotPoints[i].y, pivotPoints[i].z}; ImGui::DragFloat3("Position", pos, 0.1f))
+                    Vector3 &pivot = description.joints[i].pivot;
+                    if (float pos[3] = {pivot.x, pivot.y, pivot.z}; ImGui::DragFloat3("Position", pos, 0.1f))
                     {
-                        pivotPoints[i] = {pos[0], pos[1], pos[2]};
+                        pivot = {pos[0], pos[1], pos[2]};
+                        description.UpdateLengths();
                     }
 
                     ImGui::PopItemWidth();
@@ -224,6 +313,15 @@ void RobotArm::DrawImGuiControls()
             {
                 kinematics->SetInterpolationType(static_cast<InterpolationType>(currentType));
                 kinematics->CalculateTrajectory();
+                trajectoryDirty = true;
+            }
+
+            const char *solverTypes[] = {"CCD", "Jacobian DLS", "Analytical"};
+            int currentSolver = static_cast<int>(kinematics->GetSolverType());
+            if (ImGui::Combo("IK Solver", &currentSolver, solverTypes, 3))
+            {
+                kinematics->SetSolverType(static_cast<IKSolverType>(currentSolver));
+                trajectoryDirty = true;
             }
 
             Vector3 targetPos = kinematics->GetTargetPosition();
@@ -231,6 +329,30 @@ void RobotArm::DrawImGuiControls()
             {
                 kinematics->SetTargetPosition(targetPos);
                 kinematics->CalculateTrajectory();
+                trajectoryDirty = true;
+            }
+
+            bool useSeeds = kinematics->IsUsingSeedDatabase();
+            if (ImGui::Checkbox("Start z bazy próbek (k-d)", &useSeeds))
+            {
+                kinematics->SetUseSeedDatabase(useSeeds);
+                trajectoryDirty = true;
+            }
+
+            bool useOrientation = kinematics->IsUsingTargetOrientation();
+            if (ImGui::Checkbox("Target Orientation", &useOrientation))
+            {
+                kinematics->SetUseTargetOrientation(useOrientation);
+                trajectoryDirty = true;
+            }
+            if (useOrientation)
+            {
+                Vector3 targetRot = kinematics->GetTargetOrientation();
+                if (ImGui::DragFloat3("Orientation XYZ", (float *)&targetRot, 1.0f, -180.0f, 180.0f))
+                {
+                    kinematics->SetTargetOrientation(targetRot);
+                    trajectoryDirty = true;
+                }
             }
 
             if (kinematics->GetInterpolationType() == InterpolationType::SPLINE)
@@ -256,24 +378,156 @@ void RobotArm::DrawImGuiControls()
                     {
                         kinematics->SetControlPoints(controlPoints);
                         kinematics->CalculateTrajectory();
+                        trajectoryDirty = true;
                     }
                     ImGui::TreePop();
                 }
             }
 
+            const char *profiles[] = {"Ścieżka (TOPP)", "PTP (trapez)"};
+            int currentProfile = static_cast<int>(motionProfile);
+            if (ImGui::Combo("Profil ruchu", &currentProfile, profiles, 2))
+            {
+                motionProfile = static_cast<MotionProfile>(currentProfile);
+                trajectoryDirty = true;
+            }
+
+            ImGui::Checkbox("Automatyczna walidacja", &autoValidateTrajectory);
+            ImGui::SameLine();
+            if (ImGui::Button("Waliduj trajektorię"))
+            {
+                const TrajectoryValidation &validation = ValidatePlannedTrajectory();
+                logWindow.AddLog(TextFormat("Walidacja trajektorii: %s, %d kroków, %.2f ms",
+                                            validation.collisionFree ? "bez kolizji" : TextFormat("kontakt w t = %.3f s", validation.contactTime),
+                                            validation.steps, validation.elapsedMs),
+                                 validation.collisionFree ? LogLevel::Info : LogLevel::Warning);
+            }
+            else if (trajectoryDirty && autoValidateTrajectory)
+            {
+                ValidatePlannedTrajectory();
+            }
+            if (hasTrajectoryValidation)
+            {
+                const TrajectoryValidation &validation = trajectoryValidation;
+                if (validation.collisionFree)
+                {
+                    ImGui::TextColored(ImVec4(0.4f, 1.0f, 0.4f, 1.0f), "Trajektoria bez kolizji (%d kroków, %.2f ms)",
+                                       validation.steps, validation.elapsedMs);
+                }
+                else
+                {
+                    const LinkContact &contact = validation.contact;
+                    const char *other = ContactTargetName(contact);
+                    ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "Kontakt w t = %.3f s: %s - %s (%.2f ms)",
+                                       validation.contactTime, description.names[contact.link].c_str(), other, validation.elapsedMs);
+                }
+            }
+
             if (ImGui::Button(isAnimating ? "Stop Animation" : "Start Animation"))
             {
-                isAnimating = !isAnimating;
                 if (isAnimating)
+                    isAnimating = false;
+                else
+                    StartAnimation();
+            }
+            ImGui::SameLine();
+            if (ImGui::Button("Planuj ruch (RRT-Connect)"))
+            {
+                IKTarget target;
+                target.position = kinematics->GetTargetPosition();
+                target.orientation = kinematics->GetTargetOrientation();
+                target.useOrientation = kinematics->IsUsingTargetOrientation();
+                PlanMotion(target);
+            }
+            if (isAnimating)
+            {
+                ImGui::SameLine();
+                ImGui::Text("%.2f / %.2f s", animationTime, kinematics->GetTimedTrajectory().GetDuration());
+            }
+
+            if (ImGui::TreeNode("Planer RRT-Connect"))
+            {
+                ImGui::SliderFloat("Krok [deg]", &plannerSettings.stepSize, 2.0f, 45.0f, "%.1f");
+                ImGui::SliderFloat("Rozdzielczość krawędzi [deg]", &plannerSettings.edgeResolution, 0.5f, 10.0f, "%.1f");
+                ImGui::SliderFloat("Odstęp od przeszkód", &plannerSettings.clearance, 0.0f, 0.2f, "%.3f");
+                ImGui::SliderFloat("Limit czasu [s]", &plannerSettings.timeLimit, 0.01f, 5.0f, "%.2f");
+                ImGui::SliderInt("Iteracje skracania", &plannerSettings.shortcutIterations, 0, 256);
+
+                if (motionPlanCount > 0)
                 {
-                    animationTime = 0.0f;
+                    const MotionPlan &plan = lastMotionPlan;
+                    ImGui::Text("Ostatni plan: %s, %.2f ms, %d iteracji, %d węzłów, %d stanów, %d odcinków",
+                                MotionPlanner::GetStatusName(plan.status), plan.planningMs, plan.iterations,
+                                plan.treeNodes, plan.stateChecks, plan.segments);
+                    ImGui::Text("Plany: %d (nieudane %d)  śr. %.2f ms  maks. %.2f ms", motionPlanCount,
+                                motionPlanFailures, GetAveragePlanningMs(), maxPlanningMs);
                 }
+                if (ImGui::Button("Benchmark RRT-Connect"))
+                {
+                    BenchmarkMotionPlanner();
+                }
+                ImGui::TreePop();
+            }
+
+            ImGui::SameLine();
+            if (ImGui::Button("Porównaj solvery"))
+            {
+                CompareIKSolvers();
+            }
+            ImGui::SameLine();
+            if (ImGui::Button("Benchmark FK"))
+            {
+                BenchmarkBatchFK();
+            }
+            ImGui::SameLine();
+            if (ImGui::Button("Benchmark seedów IK"))
+            {
+                BenchmarkIKSeeds();
+            }
+            ImGui::SameLine();
+            if (ImGui::Button("Benchmark IK wsadowe"))
+            {
+                BenchmarkBatchIK();
+            }
+
+            bool useSpecialized = kinematics->IsUsingSpecializedChain();
+            if (ImGui::Checkbox("Specjalizowany łańcuch", &useSpecialized))
+            {
+                kinematics->SetUseSpecializedChain(useSpecialized);
+            }
+            ImGui::SameLine();
+            ImGui::Text("(%s)", kinematics->GetChainName() ? kinematics->GetChainName() : "brak - ścieżka ogólna");
+            ImGui::SameLine();
+            if (ImGui::Button("Benchmark łańcucha"))
+            {
+                BenchmarkKinematicChain();
+            }
+
+            if (kinematics->HasValidReachabilityMap())
+            {
+                int quality = kinematics->GetReachabilityQuality(kinematics->GetTargetPosition());
+                if (quality > 0)
+                    ImGui::TextColored(ImVec4(0.4f, 1.0f, 0.4f, 1.0f), "Cel osiągalny (jakość %d/255)", quality);
+                else
+                    ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "Cel poza przestrzenią roboczą");
+            }
+            else
+            {
+                ImGui::TextDisabled("Brak mapy osiągalności");
+            }
+            if (ImGui::Button("Przebuduj mapę osiągalności"))
+            {
+                RebuildReachabilityMap();
             }
 
             ImGui::Text("End Effector Position:");
             Vector3 currentPos = kinematics->CalculateEndEffectorPosition();
             ImGui::Text("X: %.3f Y: %.3f Z: %.3f", currentPos.x, currentPos.y, currentPos.z);
 
+            const IKResult &ikResult = kinematics->GetLastIKResult();
+            ImGui::Text("Iteracje: %d  Błąd poz.: %.4f  Błąd orient.: %.4f rad",
+                        ikResult.iterations, ikResult.positionError, ikResult.orientationError);
+
             ImGui::TreePop();
         }
 
@@ -281,6 +535,7 @@ void RobotArm::DrawImGuiControls()
         {
             kinematics->SetScale(scale);
             kinematics->CalculateTrajectory(); // Przelicz trajektorię dla nowej skali
+            trajectoryDirty = true;
         }
         float col[4] = {
             color.r / 255.0f,
@@ -300,7 +555,16 @@ void RobotArm::DrawImGuiControls()
 }
 void RobotArm::DrawTrajectory()
 {
-    if (!showTrajectory || kinematics->GetTrajectoryPoints().empty())
+    if (!showTrajectory)
+        return;
+
+    // Ścieżka TCP ostatniego planu RRT-Connect
+    for (size_t i = 1; i < plannedPath.size(); i++)
+    {
+        DrawLine3D(plannedPath[i - 1], plannedPath[i], SKYBLUE);
+    }
+
+    if (kinematics->GetTrajectoryPoints().empty())
         return;
 
     const auto &points = kinematics->GetTrajectoryPoints();
@@ -310,29 +574,149 @@ void RobotArm::DrawTrajectory()
     }
     DrawSphere(points.front(), 0.1f, BLUE);
     DrawSphere(points.back(), 0.1f, RED);
+
+    // Miejsce pierwszego kontaktu znalezione przez walidację
+    if (hasTrajectoryValidation && !trajectoryValidation.collisionFree)
+    {
+        DrawSphere(trajectoryValidation.contact.point, 0.05f, MAGENTA);
+        DrawLine3D(trajectoryValidation.contact.point, trajectoryValidation.contact.otherPoint, MAGENTA);
+    }
 }
 
-void RobotArm::Update()
+void RobotArm::StartAnimation()
 {
-    const auto &trajectoryPoints = kinematics->GetTrajectoryPoints();
+    double start = GetTime();
+    int failures = kinematics->PlanTimedTrajectory(motionProfile);
+    double elapsed = (GetTime() - start) * 1000.0;
 
-    if (isAnimating && !trajectoryPoints.empty())
+    const TimedTrajectory &trajectory = kinematics->GetTimedTrajectory();
+    if (trajectory.IsEmpty())
     {
-        animationTime += GetFrameTime();
+        logWindow.AddLog("Nie udało się zaplanować trajektorii", LogLevel::Warning);
+        return;
+    }
+    if (failures > 0)
+    {
+        logWindow.AddLog(TextFormat("IK niezbieżne w %d punktach trajektorii", failures), LogLevel::Warning);
+    }
+    logWindow.AddLog(TextFormat("Trajektoria: czas ruchu %.2f s, planowanie %.2f ms",
+                                trajectory.GetDuration(), elapsed),
+                     LogLevel::Info);
+
+    plannedPath.clear();
+    trajectoryValidation = ValidateTrajectory(*kinematics, linkCollision, trajectory, grippedObject);
+    hasTrajectoryValidation = true;
+    trajectoryDirty = false;
+    if (!trajectoryValidation.collisionFree)
+    {
+        const LinkContact &contact = trajectoryValidation.contact;
+        const char *other = ContactTargetName(contact);
+        logWindow.AddLog(TextFormat("Trajektoria koliduje w t = %.3f s: %s z %s", trajectoryValidation.contactTime,
+                                    description.names[contact.link].c_str(), other),
+                         LogLevel::Warning);
+    }
 
-        float t = animationTime / ANIMATION_DURATION;
+    animationTime = 0.0f;
+    isAnimating = true;
+}
 
-        if (t >= 1.0f)
+const TrajectoryValidation &RobotArm::ValidatePlannedTrajectory()
+{
+    kinematics->PlanTimedTrajectory(motionProfile, previewTrajectory);
+    trajectoryValidation = ValidateTrajectory(*kinematics, linkCollision, previewTrajectory, grippedObject);
+    hasTrajectoryValidation = true;
+    trajectoryDirty = false;
+    return trajectoryValidation;
+}
+
+bool RobotArm::PlanMotion(const IKTarget &target)
+{
+    isAnimating = false;
+
+    // Konfiguracja docelowa z IK na kopii stanu, start z bieżącej pozy
+    std::vector<float> goal;
+    std::vector<IKResult> ikResults;
+    kinematics->SolveIKBatch({target}, goal, ikResults);
+    if (!ikResults[0].converged)
+    {
+        logWindow.AddLog(TextFormat("IK niezbieżne dla celu planu (błąd %.4f)", ikResults[0].positionError), LogLevel::Warning);
+    }
+
+    std::vector<float> start(model.meshCount);
+    for (int i = 0; i < model.meshCount; i++)
+        start[i] = meshRotations[i].angle;
+
+    MotionPlanner planner(*kinematics, linkCollision, grippedObject);
+    lastMotionPlan = planner.Plan(start.data(), goal.data(), plannerSettings);
+    const MotionPlan &plan = lastMotionPlan;
+    motionPlanCount++;
+    totalPlanningMs += plan.planningMs;
+    maxPlanningMs = fmaxf(maxPlanningMs, plan.planningMs);
+
+    if (!plan.Succeeded() || !kinematics->BuildTimedTrajectory(plan.waypoints))
+    {
+        motionPlanFailures++;
+        logWindow.AddLog(TextFormat("RRT-Connect: %s (%.2f ms, %d węzłów)", MotionPlanner::GetStatusName(plan.status),
+                                    plan.planningMs, plan.treeNodes),
+                         LogLevel::Warning);
+        return false;
+    }
+
+    // Ścieżka TCP do rysowania
+    const int waypointCount = (int)plan.waypoints.size() / model.meshCount;
+    std::vector<ArmRotation> rotations(meshRotations);
+    std::vector<Matrix> frames(model.meshCount);
+    Vector3 tool = kinematics->GetPivotPoint(model.meshCount);
+    plannedPath.clear();
+    for (int w = 0; w < waypointCount; w++)
+    {
+        for (int i = 0; i < model.meshCount; i++)
+            rotations[i].angle = plan.waypoints[w * model.meshCount + i];
+        kinematics->ComputeJointTransforms(rotations.data(), 0, frames.data());
+        plannedPath.push_back(Vector3Scale(Vector3Transform(tool, frames[model.meshCount - 1]), scale));
+    }
+
+    const TimedTrajectory &trajectory = kinematics->GetTimedTrajectory();
+    trajectoryValidation = ValidateTrajectory(*kinematics, linkCollision, trajectory, grippedObject);
+    hasTrajectoryValidation = true;
+    trajectoryDirty = false;
+
+    logWindow.AddLog(TextFormat("RRT-Connect: %.2f ms, %d iteracji, %d węzłów, %d odcinków, ruch %.2f s",
+                                plan.planningMs, plan.iterations, plan.treeNodes, plan.segments, trajectory.GetDuration()),
+                     LogLevel::Info);
+    if (!trajectoryValidation.collisionFree)
+    {
+        const LinkContact &contact = trajectoryValidation.contact;
+        logWindow.AddLog(TextFormat("Trajektoria koliduje w t = %.3f s: %s z %s", trajectoryValidation.contactTime,
+                                    description.names[contact.link].c_str(), ContactTargetName(contact)),
+                         LogLevel::Warning);
+    }
+
+    animationTime = 0.0f;
+    isAnimating = true;
+    return true;
+}
+
+void RobotArm::Update(float deltaTime)
+{
+    const TimedTrajectory &trajectory = kinematics->GetTimedTrajectory();
+
+    if (isAnimating && !trajectory.IsEmpty())
+    {
+        animationTime += deltaTime;
+        if (animationTime >= trajectory.GetDuration())
         {
+            animationTime = trajectory.GetDuration();
             isAnimating = false;
-            t = 1.0f;
         }
 
-        int index = (int)(t * (trajectoryPoints.size() - 1));
-        index = Clamp(index, 0, trajectoryPoints.size() - 2);
-
-        kinematics->SetTargetPosition(trajectoryPoints[index]);
-        kinematics->SolveIK();
+        // Odczyt z tablicy LUT - O(1) na klatkę, bez IK w pętli animacji
+        playbackAngles.resize(trajectory.GetJointCount());
+        trajectory.Sample(animationTime, playbackAngles.data());
+        for (int i = 0; i < model.meshCount && i < trajectory.GetJointCount(); i++)
+        {
+            meshRotations[i].angle = playbackAngles[i];
+        }
     }
 
     if (isGripping && grippedObject)
@@ -340,6 +724,25 @@ void RobotArm::Update()
         Vector3 newPos = Vector3Add(gripperPosition, gripOffset);
         grippedObject->SetPosition(newPos);
     }
+
+    previousStepAngles.swap(currentStepAngles);
+    for (int i = 0; i < model.meshCount; i++)
+    {
+        currentStepAngles[i] = meshRotations[i].angle;
+    }
+}
+
+void RobotArm::PrepareRender(float alpha)
+{
+    for (int i = 0; i < model.meshCount; i++)
+    {
+        renderRotations[i].axis = meshRotations[i].axis;
+        renderRotations[i].angle = Lerp(previousStepAngles[i], currentStepAngles[i], alpha);
+    }
+    if (model.meshCount > 0)
+    {
+        kinematics->ComputeJointTransforms(renderRotations.data(), 0, renderTransforms.data());
+    }
 }
 
 void RobotArm::SetScale(float newScale)
@@ -356,69 +759,496 @@ void RobotArm::RotateJoint(int jointIndex, float angle)
     }
 }
 
-void RobotArm::CheckCollisions(const std::vector<Object3D *> &objects)
+void RobotArm::CompareIKSolvers()
 {
-    static LogWindow &logWindow = LogWindow::GetInstance();
-    static bool wasColliding = false; // Do śledzenia poprzedniego stanu kolizji
+    // Uruchom oba solvery z tej samej pozycji startowej i na tym samym celu
+    std::vector<float> startAngles(model.meshCount);
+    for (int i = 0; i < model.meshCount; i++)
+        startAngles[i] = meshRotations[i].angle;
 
-    Matrix parentTransform = RobotKinematics::GetHierarchicalTransform(model.meshCount - 1, meshRotations, pivotPoints);
-    gripperPosition = Vector3Transform(pivotPoints[model.meshCount], parentTransform);
-    gripperPosition = Vector3Scale(gripperPosition, scale);
+    IKSolverType previousSolver = kinematics->GetSolverType();
+    const char *names[] = {"CCD", "Jacobian DLS", "Analytical"};
+    IKSolverType solvers[] = {IKSolverType::CCD, IKSolverType::JACOBIAN_DLS, IKSolverType::ANALYTICAL};
 
-    bool currentlyColliding = false;
-    std::string collidingObjectName;
+    for (int s = 0; s < 3; s++)
+    {
+        for (int i = 0; i < model.meshCount; i++)
+            meshRotations[i].angle = startAngles[i];
+
+        kinematics->SetSolverType(solvers[s]);
+        double start = GetTime();
+        kinematics->SolveIK();
+        double elapsed = (GetTime() - start) * 1000.0;
+
+        const IKResult &result = kinematics->GetLastIKResult();
+        logWindow.AddLog(TextFormat("%s: iteracje %d, błąd poz. %.4f, błąd orient. %.4f rad, %s, %.3f ms",
+                                    names[s], result.iterations, result.positionError,
+                                    result.orientationError, result.converged ? "zbieżny" : "niezbieżny",
+                                    elapsed),
+                         LogLevel::Info);
+    }
+
+    for (int i = 0; i < model.meshCount; i++)
+        meshRotations[i].angle = startAngles[i];
+    kinematics->SetSolverType(previousSolver);
+}
+
+void RobotArm::BenchmarkBatchFK()
+{
+    const int CONFIG_COUNT = 100000;
+    const int meshCount = model.meshCount;
 
-    for (const auto *obj : objects)
+    // Losowe konfiguracje w układzie SoA: angles[joint * CONFIG_COUNT + config]
+    std::vector<float> angles(meshCount * CONFIG_COUNT);
+    for (int j = 0; j < meshCount; j++)
     {
-        const Model &objModel = obj->GetModel();
+        const JointLimit &limit = kinematics->GetJointLimit(j);
+        for (int c = 0; c < CONFIG_COUNT; c++)
+            angles[j * CONFIG_COUNT + c] = limit.min + (limit.max - limit.min) * (GetRandomValue(0, 10000) / 10000.0f);
+    }
+    std::vector<float> x(CONFIG_COUNT), y(CONFIG_COUNT), z(CONFIG_COUNT);
 
-        BoundingBox objBox = GetMeshBoundingBox(objModel.meshes[0]);
-        Vector3 objPos = obj->GetPosition();
-        float objScale = obj->GetScale();
+    // Ścieżka skalarna: RobotKinematics na żywej tablicy meshRotations
+    std::vector<float> startAngles(meshCount);
+    for (int i = 0; i < meshCount; i++)
+        startAngles[i] = meshRotations[i].angle;
+
+    double start = GetTime();
+    for (int c = 0; c < CONFIG_COUNT; c++)
+    {
+        for (int j = 0; j < meshCount; j++)
+            meshRotations[j].angle = angles[j * CONFIG_COUNT + c];
+        Vector3 p = kinematics->CalculateEndEffectorPosition();
+        x[c] = p.x;
+    }
+    double referenceTime = GetTime() - start;
 
-        Vector3 min = Vector3Add(Vector3Scale(objBox.min, objScale), objPos);
-        Vector3 max = Vector3Add(Vector3Scale(objBox.max, objScale), objPos);
-        BoundingBox transformedBox = {min, max};
+    for (int i = 0; i < meshCount; i++)
+        meshRotations[i].angle = startAngles[i];
+
+    BatchKinematics batch = kinematics->CreateBatchKinematics();
+
+    start = GetTime();
+    batch.EvaluateScalar(angles.data(), CONFIG_COUNT, CONFIG_COUNT, x.data(), y.data(), z.data());
+    double scalarTime = GetTime() - start;
+
+    start = GetTime();
+    batch.Evaluate(angles.data(), CONFIG_COUNT, CONFIG_COUNT, x.data(), y.data(), z.data());
+    double simdTime = GetTime() - start;
+
+    auto rate = [&](double seconds) { return seconds > 0.0 ? CONFIG_COUNT / seconds / 1e6 : 0.0; };
+    logWindow.AddLog(TextFormat("FK %d konfiguracji: RobotKinematics %.2f M/s, batch skalarny %.2f M/s, batch %s x%d %.2f M/s",
+                                CONFIG_COUNT, rate(referenceTime), rate(scalarTime),
+                                BatchKinematics::GetInstructionSet(), BatchKinematics::GetLaneWidth(), rate(simdTime)),
+                     LogLevel::Info);
+}
 
-        if (CheckCollisionBoxSphere(transformedBox, gripperPosition, gripperRadius * scale))
+void RobotArm::BenchmarkIKSeeds()
+{
+    if (!kinematics->HasValidSeedDatabase())
+    {
+        logWindow.AddLog("Brak bazy punktów startowych IK", LogLevel::Warning);
+        return;
+    }
+
+    const int TARGET_COUNT = 200;
+    std::vector<float> startAngles(model.meshCount);
+    for (int i = 0; i < model.meshCount; i++)
+        startAngles[i] = meshRotations[i].angle;
+    Vector3 savedTarget = kinematics->GetTargetPosition();
+    bool savedUseSeeds = kinematics->IsUsingSeedDatabase();
+
+    // Cele z losowych konfiguracji w granicach przegubów - zawsze osiągalne
+    std::vector<Vector3> targets(TARGET_COUNT);
+    for (int t = 0; t < TARGET_COUNT; t++)
+    {
+        for (int i = 0; i < model.meshCount; i++)
         {
-            if (isGripping)
-            {
-                return;
-            }
-            for (int i = 0; i < objModel.meshCount; i++)
-            {
-                Ray ray;
-                ray.position = gripperPosition;
-                ray.direction = {0, 0, 0};
+            const JointLimit &limit = kinematics->GetJointLimit(i);
+            meshRotations[i].angle = (float)GetRandomValue((int)limit.min, (int)limit.max);
+        }
+        targets[t] = kinematics->CalculateEndEffectorPosition();
+    }
 
-                const int numRays = 8;
-                for (int j = 0; j < numRays; j++)
-                {
-                    float angle = (2.0f * PI * j) / numRays;
-                    ray.direction = {cosf(angle), 0.0f, sinf(angle)};
+    for (int pass = 0; pass < 2; pass++)
+    {
+        kinematics->SetUseSeedDatabase(pass == 1);
+        int converged = 0;
+        long totalIterations = 0;
+        double start = GetTime();
 
-                    Matrix transform = obj->GetTransform();
-                    RayCollision collision = GetRayCollisionMesh(ray, objModel.meshes[i], transform);
-                    if (collision.hit && collision.distance < gripperRadius * scale)
-                    {
-                        currentlyColliding = true;
-                        collidingObjectName = obj->GetModelPath();
-                        break;
-                    }
-                }
-                if (currentlyColliding)
-                    break;
+        for (int t = 0; t < TARGET_COUNT; t++)
+        {
+            for (int i = 0; i < model.meshCount; i++)
+                meshRotations[i].angle = startAngles[i];
+            kinematics->SetTargetPosition(targets[t]);
+            kinematics->SolveIK();
+
+            const IKResult &result = kinematics->GetLastIKResult();
+            totalIterations += result.iterations;
+            if (result.converged)
+                converged++;
+        }
+
+        double elapsed = (GetTime() - start) * 1000.0;
+        logWindow.AddLog(TextFormat("IK %s: śr. iteracje %.1f, zbieżność %d/%d (%.0f%%), %.3f ms/cel",
+                                    pass == 1 ? "z bazą k-d" : "bez bazy",
+                                    totalIterations / (float)TARGET_COUNT, converged, TARGET_COUNT,
+                                    100.0f * converged / TARGET_COUNT, elapsed / TARGET_COUNT),
+                         LogLevel::Info);
+    }
+
+    for (int i = 0; i < model.meshCount; i++)
+        meshRotations[i].angle = startAngles[i];
+    kinematics->SetTargetPosition(savedTarget);
+    kinematics->SetUseSeedDatabase(savedUseSeeds);
+}
+
+void RobotArm::BenchmarkBatchIK()
+{
+    const int TARGET_COUNT = 2000;
+    std::vector<float> startAngles(model.meshCount);
+    for (int i = 0; i < model.meshCount; i++)
+        startAngles[i] = meshRotations[i].angle;
+    Vector3 savedTarget = kinematics->GetTargetPosition();
+
+    std::vector<IKTarget> targets(TARGET_COUNT);
+    for (int t = 0; t < TARGET_COUNT; t++)
+    {
+        for (int i = 0; i < model.meshCount; i++)
+        {
+            const JointLimit &limit = kinematics->GetJointLimit(i);
+            meshRotations[i].angle = (float)GetRandomValue((int)limit.min, (int)limit.max);
+        }
+        targets[t].position = kinematics->CalculateEndEffectorPosition();
+    }
+    for (int i = 0; i < model.meshCount; i++)
+        meshRotations[i].angle = startAngles[i];
+
+    // Sekwencyjnie na jednym buforze kątów, jak dotychczasowe SolveIK
+    double start = GetTime();
+    int serialConverged = 0;
+    for (int t = 0; t < TARGET_COUNT; t++)
+    {
+        for (int i = 0; i < model.meshCount; i++)
+            meshRotations[i].angle = startAngles[i];
+        kinematics->SetTargetPosition(targets[t].position);
+        kinematics->SolveIK();
+        if (kinematics->GetLastIKResult().converged)
+            serialConverged++;
+    }
+    double serialTime = GetTime() - start;
+    for (int i = 0; i < model.meshCount; i++)
+        meshRotations[i].angle = startAngles[i];
+    kinematics->SetTargetPosition(savedTarget);
+
+    std::vector<float> angles;
+    std::vector<IKResult> results;
+    start = GetTime();
+    kinematics->SolveIKBatch(targets, angles, results);
+    double batchTime = GetTime() - start;
+
+    int batchConverged = 0;
+    for (const IKResult &result : results)
+    {
+        if (result.converged)
+            batchConverged++;
+    }
+
+    logWindow.AddLog(TextFormat("IK sekwencyjnie: %.0f celów/s (zbieżność %d/%d)",
+                                TARGET_COUNT / serialTime, serialConverged, TARGET_COUNT),
+                     LogLevel::Info);
+    logWindow.AddLog(TextFormat("IK wsadowo (%d wątków): %.0f celów/s (zbieżność %d/%d), przyspieszenie x%.1f",
+                                ThreadPool::GetInstance().GetWorkerCount() + 1, TARGET_COUNT / batchTime,
+                                batchConverged, TARGET_COUNT, serialTime / batchTime),
+                     LogLevel::Info);
+}
+
+void RobotArm::BenchmarkKinematicChain()
+{
+    const int FK_COUNT = 100000;
+    const int IK_COUNT = 300;
+
+    std::vector<float> startAngles(model.meshCount);
+    for (int i = 0; i < model.meshCount; i++)
+        startAngles[i] = meshRotations[i].angle;
+    Vector3 savedTarget = kinematics->GetTargetPosition();
+    bool savedSpecialized = kinematics->IsUsingSpecializedChain();
+
+    std::vector<float> configs(FK_COUNT * model.meshCount);
+    for (int c = 0; c < FK_COUNT; c++)
+    {
+        for (int i = 0; i < model.meshCount; i++)
+        {
+            const JointLimit &limit = kinematics->GetJointLimit(i);
+            configs[c * model.meshCount + i] = (float)GetRandomValue((int)limit.min, (int)limit.max);
+        }
+    }
+
+    std::vector<Vector3> targets(IK_COUNT);
+    for (int t = 0; t < IK_COUNT; t++)
+    {
+        for (int i = 0; i < model.meshCount; i++)
+            meshRotations[i].angle = configs[t * model.meshCount + i];
+        targets[t] = kinematics->CalculateEndEffectorPosition();
+    }
+
+    double fkTime[2], ikTime[2];
+    for (int pass = 0; pass < 2; pass++)
+    {
+        kinematics->SetUseSpecializedChain(pass == 1);
+
+        // FK: każda konfiguracja unieważnia cały łańcuch
+        Vector3 checksum = Vector3Zero();
+        double start = GetTime();
+        for (int c = 0; c < FK_COUNT; c++)
+        {
+            for (int i = 0; i < model.meshCount; i++)
+                meshRotations[i].angle = configs[c * model.meshCount + i];
+            checksum = Vector3Add(checksum, kinematics->CalculateEndEffectorPosition());
+        }
+        fkTime[pass] = GetTime() - start;
+
+        start = GetTime();
+        for (int t = 0; t < IK_COUNT; t++)
+        {
+            for (int i = 0; i < model.meshCount; i++)
+                meshRotations[i].angle = startAngles[i];
+            kinematics->SetTargetPosition(targets[t]);
+            kinematics->SolveIK();
+        }
+        ikTime[pass] = GetTime() - start;
+
+        logWindow.AddLog(TextFormat("Łańcuch %s: FK %.2f M/s, IK %.3f ms/cel (suma kontrolna %.1f)",
+                                    pass == 1 ? "specjalizowany" : "ogólny",
+                                    FK_COUNT / fkTime[pass] / 1e6, ikTime[pass] * 1000.0 / IK_COUNT,
+                                    checksum.x + checksum.y + checksum.z),
+                         LogLevel::Info);
+    }
+
+    if (!kinematics->GetChainName())
+    {
+        logWindow.AddLog("Brak specjalizacji dla osi tego robota - oba przebiegi użyły ścieżki ogólnej", LogLevel::Warning);
+    }
+    else
+    {
+        logWindow.AddLog(TextFormat("Przyspieszenie %s: FK x%.1f, IK x%.1f", kinematics->GetChainName(),
+                                    fkTime[0] / fkTime[1], ikTime[0] / ikTime[1]),
+                         LogLevel::Info);
+    }
+
+    for (int i = 0; i < model.meshCount; i++)
+        meshRotations[i].angle = startAngles[i];
+    kinematics->SetTargetPosition(savedTarget);
+    kinematics->SetUseSpecializedChain(savedSpecialized);
+}
+
+void RobotArm::BenchmarkLinkCollisions()
+{
+    const int STEP_COUNT = 10000;
+    const int meshCount = model.meshCount;
+    if (meshCount == 0)
+        return;
+
+    // Ramki losowych póz liczone z góry - mierzony jest tylko model kolizji
+    std::vector<Matrix> frames(STEP_COUNT * meshCount);
+    std::vector<ArmRotation> rotations = meshRotations;
+    for (int s = 0; s < STEP_COUNT; s++)
+    {
+        for (int j = 0; j < meshCount; j++)
+        {
+            const JointLimit &limit = kinematics->GetJointLimit(j);
+            rotations[j].angle = limit.min + (limit.max - limit.min) * (GetRandomValue(0, 10000) / 10000.0f);
+        }
+        kinematics->ComputeJointTransforms(rotations.data(), 0, frames.data() + s * meshCount);
+    }
+
+    // Drugi robot w bieżącej pozie, przesunięty o połowę zasięgu - test robot-robot
+    LinkCollisionModel probe = linkCollision;
+    LinkCollisionModel neighbour = linkCollision;
+    Matrix shift = MatrixTranslate(0.5f * kinematics->GetTotalLength(), 0.0f, 0.0f);
+    std::vector<Matrix> neighbourFrames(meshCount);
+    for (int j = 0; j < meshCount; j++)
+        neighbourFrames[j] = MatrixMultiply(stepTransforms[j], shift);
+    neighbour.UpdatePose(neighbourFrames.data(), scale);
+
+    std::vector<LinkContact> contacts;
+    double pairTime[2];
+    long long contactCount = 0;
+    for (int pass = 0; pass < 2; pass++)
+    {
+        probe.SetUseSimd(pass == 1);
+        contactCount = 0;
+        double start = GetTime();
+        for (int s = 0; s < STEP_COUNT; s++)
+        {
+            probe.UpdatePose(frames.data() + s * meshCount, scale);
+            contacts.clear();
+            probe.CheckSelf(contactMargin, contacts);
+            probe.CheckRobot(neighbour, contactMargin, contacts);
+            contactCount += contacts.size();
+        }
+        pairTime[pass] = GetTime() - start;
+    }
+
+    double start = GetTime();
+    for (int s = 0; s < STEP_COUNT; s++)
+    {
+        probe.UpdatePose(frames.data() + s * meshCount, scale);
+        contacts.clear();
+        probe.CheckScene(contactMargin, nullptr, -1, contacts);
+    }
+    double sceneTime = GetTime() - start;
+
+    auto perStep = [&](double seconds) { return seconds / STEP_COUNT * 1e6; };
+    logWindow.AddLog(TextFormat("Kolizje ogniw, %d póz: pary kapsuł skalarnie %.2f us/krok, %s x%d %.2f us/krok, "
+                                "scena %.2f us/krok, średnio %.1f kontaktów",
+                                STEP_COUNT, perStep(pairTime[0]), SimdInstructionSet(), FloatLanes::WIDTH,
+                                perStep(pairTime[1]), perStep(sceneTime), (double)contactCount / STEP_COUNT),
+                     LogLevel::Info);
+}
+
+void RobotArm::BenchmarkMotionPlanner()
+{
+    // Losowe zapytania między bezkolizyjnymi konfiguracjami w bieżącej scenie
+    const int QUERIES = 20;
+    const int n = model.meshCount;
+    MotionPlanner planner(*kinematics, linkCollision, grippedObject);
+    std::mt19937 rng(2024);
+
+    auto sampleValid = [&](std::vector<float> &q)
+    {
+        for (int attempt = 0; attempt < 1000; attempt++)
+        {
+            for (int i = 0; i < n; i++)
+            {
+                const JointLimit &limit = description.joints[i].limit;
+                q[i] = std::uniform_real_distribution<float>(limit.min, limit.max)(rng);
             }
+            if (planner.IsStateValid(q.data()))
+                return true;
         }
-        if (currentlyColliding)
+        return false;
+    };
+
+    std::vector<float> start(n), goal(n), times;
+    int successes = 0, nodes = 0;
+    for (int query = 0; query < QUERIES; query++)
+    {
+        if (!sampleValid(start) || !sampleValid(goal))
             break;
+        MotionPlan plan = planner.Plan(start.data(), goal.data(), plannerSettings);
+        times.push_back(plan.planningMs);
+        successes += plan.Succeeded();
+        nodes += plan.treeNodes;
+    }
+    if (times.empty())
+    {
+        logWindow.AddLog("Benchmark RRT-Connect: brak bezkolizyjnych konfiguracji", LogLevel::Warning);
+        return;
+    }
+
+    std::sort(times.begin(), times.end());
+    float total = 0.0f;
+    for (float t : times)
+        total += t;
+    logWindow.AddLog(TextFormat("Benchmark RRT-Connect: %d/%d sukcesów, śr. %.2f ms, mediana %.2f ms, maks. %.2f ms, śr. %d węzłów (%d wątków)",
+                                successes, (int)times.size(), total / times.size(), times[times.size() / 2], times.back(),
+                                nodes / (int)times.size(), ThreadPool::GetInstance().GetWorkerCount() + 1),
+                     LogLevel::Info);
+}
+
+void RobotArm::RebuildReachabilityMap()
+{
+    kinematics->SetReachabilityMap(nullptr);
+    reachabilityMap.Build(*kinematics);
+    fs::create_directories(configDir);
+    if (!reachabilityMap.Save(fs::path(configDir) / "reachability.bin"))
+    {
+        logWindow.AddLog("Nie udało się zapisać mapy osiągalności", LogLevel::Warning);
+    }
+    kinematics->SetReachabilityMap(&reachabilityMap);
+    logWindow.AddLog(TextFormat("Mapa osiągalności przebudowana w %.2f s", reachabilityMap.GetBuildTime()), LogLevel::Info);
+}
+
+const char *RobotArm::ContactTargetName(const LinkContact &contact) const
+{
+    return contact.type == LinkContactType::SCENE ? contact.object->GetModelPath().c_str()
+                                                  : description.names[contact.otherLink].c_str();
+}
+
+void RobotArm::CheckLinkCollisions()
+{
+    // Ramki z cache FK - po Update kąty zmieniły się tylko w poruszonych przegubach
+    for (int i = 0; i < model.meshCount; i++)
+        stepTransforms[i] = kinematics->GetJointTransform(i);
+    linkCollision.UpdatePose(stepTransforms.data(), scale);
+
+    bool wasPenetrating = false;
+    for (const LinkContact &contact : linkContacts)
+        wasPenetrating |= contact.distance < 0.0f;
+
+    linkContacts.clear();
+    linkCollision.CheckSelf(contactMargin, linkContacts);
+    linkCollision.CheckScene(contactMargin, grippedObject, model.meshCount - 1, linkContacts);
+
+    const LinkContact *deepest = nullptr;
+    for (const LinkContact &contact : linkContacts)
+    {
+        minLinkDistance = fminf(minLinkDistance, contact.distance);
+        if (!deepest || contact.distance < deepest->distance)
+            deepest = &contact;
+    }
+
+    if (deepest && deepest->distance < 0.0f && !wasPenetrating)
+    {
+        linkCollisionCount++;
+        const char *other = ContactTargetName(*deepest);
+        logWindow.AddLog(TextFormat("Kolizja ogniwa %s z %s (%.3f)", description.names[deepest->link].c_str(), other,
+                                    deepest->distance),
+                         LogLevel::Warning);
+    }
+}
+
+void RobotArm::CheckCollisions()
+{
+    static LogWindow &logWindow = LogWindow::GetInstance();
+
+    CheckLinkCollisions();
+
+    gripperPosition = kinematics->CalculateEndEffectorPosition();
+
+    bool currentlyColliding = false;
+    std::string collidingObjectName;
+
+    // Kandydaci z drzewa AABB sceny, BVH obiektu sprawdza kulę chwytaka z trójkątami
+    SceneBroadphase::GetInstance().QuerySphere(gripperPosition, gripperRadius * scale, gripperCandidates);
+    if (isGripping && !gripperCandidates.empty())
+    {
+        return;
+    }
+    // BVH rozstrzyga o styku z powierzchnią, GJK/EPA na otoczce daje głębokość, normalną i punkty świadków
+    for (const auto *obj : gripperCandidates)
+    {
+        if (!obj->IntersectsSphere(gripperPosition, gripperRadius * scale))
+            continue;
+
+        ConvexContact contact = ComputeConvexContact(ConvexShape::Sphere(gripperPosition, gripperRadius * scale), obj->GetConvexShape());
+        if (!currentlyColliding || contact.distance < gripperContact.distance)
+        {
+            gripperContact = contact;
+            collidingObjectName = obj->GetModelPath();
+        }
+        currentlyColliding = true;
     }
 
     // Logowanie zmian stanu kolizji
     if (currentlyColliding && !wasColliding)
     {
-        logWindow.AddLog(("Wykryto kolizję z obiektem: " + collidingObjectName).c_str(), LogLevel::Warning);
+        collisionCount++;
+        logWindow.AddLog(TextFormat("Wykryto kolizję z obiektem: %s (przenikanie %.3f)", collidingObjectName.c_str(),
+                                    -gripperContact.distance),
+                         LogLevel::Warning);
     }
     else if (!currentlyColliding && wasColliding)
     {
@@ -432,36 +1262,39 @@ void RobotArm::CheckCollisions(const std::vector<Object3D *> &objects)
 
 void RobotArm::DrawGripper()
 {
-    // Dostosuj promień do skali modelu
+    // Dostosuj promień do skali modelu; pozycja z tej samej interpolacji co siatki
     float scaledRadius = gripperRadius * scale;
-    DrawSphere(gripperPosition, scaledRadius, gripperColor);
+    Vector3 tcp = gripperPosition;
+    if (model.meshCount > 0)
+    {
+        tcp = Vector3Scale(Vector3Transform(description.joints[model.meshCount].pivot, renderTransforms[model.meshCount - 1]), scale);
+    }
+    DrawSphere(tcp, scaledRadius, gripperColor);
+    if (isColliding)
+    {
+        // Normalna kontaktu z punktu świadka na obiekcie
+        DrawLine3D(gripperContact.pointB, Vector3Add(gripperContact.pointB, Vector3Scale(gripperContact.normal, -scaledRadius)), YELLOW);
+    }
 }
 
 void RobotArm::GripObject() 
 {
-    if (!isColliding || isGripping || !sceneObjects)
+    if (!isColliding || isGripping)
         return;
 
-    for (const auto* obj : *sceneObjects) 
+    std::vector<Object3D*> candidates;
+    SceneBroadphase::GetInstance().QuerySphere(gripperPosition, gripperRadius * scale, candidates);
+    for (auto* obj : candidates) 
     {
-        const Model& objModel = obj->GetModel();
-        BoundingBox objBox = GetMeshBoundingBox(objModel.meshes[0]);
         Vector3 objPos = obj->GetPosition();
-        float objScale = obj->GetScale();
-        
-        // Tworzenie transformed bounding box
-        BoundingBox transformedBox = {
-            Vector3Add(Vector3Scale(objBox.min, objScale), objPos),
-            Vector3Add(Vector3Scale(objBox.max, objScale), objPos)
-        };
-        
-        if (CheckCollisionBoxSphere(transformedBox, gripperPosition, gripperRadius * scale)) 
+        if (obj->IntersectsSphere(gripperPosition, gripperRadius * scale)) 
         {
-            grippedObject = const_cast<Object3D*>(obj);
+            grippedObject = obj;
             isGripping = true;
             // Zapisz offset między chwytakiem a obiektem
             gripOffset = Vector3Subtract(objPos, gripperPosition);
-            logWindow.AddLog("Obiekt chwycony", LogLevel::Info);
+            ConvexContact contact = ComputeConvexContact(ConvexShape::Sphere(gripperPosition, gripperRadius * scale), obj->GetConvexShape());
+            logWindow.AddLog(TextFormat("Obiekt chwycony (przenikanie %.3f)", -contact.distance), LogLevel::Info);
             break;
         }
     }
@@ -475,4 +1308,19 @@ void RobotArm::ReleaseObject()
     grippedObject = nullptr;
     isGripping = false;
     logWindow.AddLog("Obiekt puszczony", LogLevel::Info);
+}
+
+void RobotArm::DetachObject(const Object3D *object)
+{
+    if (isGripping && grippedObject == object)
+    {
+        ReleaseObject();
+    }
+    if (hasTrajectoryValidation && trajectoryValidation.contact.object == object)
+    {
+        hasTrajectoryValidation = false;
+        trajectoryDirty = true;
+    }
+    std::erase_if(linkContacts, [object](const LinkContact &contact)
+                  { return contact.object == object; });
 }
\ No newline at end of file
@@ -0,0 +1,156 @@
+#include "robotDescription.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <fstream>
+
+using json = nlohmann::json;
+
+namespace
+{
+    Vector3 ReadVector(const json &j, Vector3 fallback)
+    {
+        if (!j.is_object())
+            return fallback;
+        return {j.value("x", fallback.x), j.value("y", fallback.y), j.value("z", fallback.z)};
+    }
+}
+
+RobotDescription RobotDescription::CreateDefault(int jointCount)
+{
+    // Geometria dołączonego ramienia (assets/robots/robot.glb)
+    static const JointDesc BUNDLED[] = {
+        {{0.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {-180.0f, 180.0f, 120.0f, 300.0f}, 0.0f},     // Baza
+        {{0.0f, 100.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {-90.0f, 90.0f, 120.0f, 300.0f}, 0.0f},     // Ramię 1
+        {{0.0f, 350.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, {-120.0f, 120.0f, 100.0f, 250.0f}, 0.0f},   // Ramię 2
+        {{0.0f, 660.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, {-120.0f, 120.0f, 120.0f, 300.0f}, 0.0f},   // Ramię 3
+        {{-58.0f, 708.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {-180.0f, 180.0f, 180.0f, 450.0f}, 0.0f}, // Ramię 4
+        {{-338.0f, 708.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, {-90.0f, 90.0f, 180.0f, 450.0f}, 0.0f},  // Chwytak
+    };
+    static const char *NAMES[] = {"Baza", "Ramię 1", "Ramię 2", "Ramię 3", "Ramię 4", "Chwytak"};
+    const Vector3 BUNDLED_TOOL = {-426.0f, 708.0f, 0.0f};
+
+    RobotDescription description;
+    for (int i = 0; i < jointCount; i++)
+    {
+        if (i < 6)
+        {
+            description.joints.push_back(BUNDLED[i]);
+            description.names.push_back(NAMES[i]);
+        }
+        else
+        {
+            description.joints.push_back({BUNDLED_TOOL, {0.0f, 1.0f, 0.0f}, {-180.0f, 180.0f}, 0.0f});
+            description.names.push_back("Przegub " + std::to_string(i));
+        }
+    }
+    description.joints.push_back({jointCount >= 6 ? BUNDLED_TOOL : BUNDLED[jointCount].pivot,
+                                  {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f}, 0.0f});
+    description.names.push_back("TCP");
+    description.UpdateLengths();
+    return description;
+}
+
+bool RobotDescription::LoadFromFile(const std::filesystem::path &configPath)
+{
+    std::ifstream file(configPath);
+    if (!file.is_open())
+        return false;
+
+    try
+    {
+        json j;
+        file >> j;
+        if (!j.contains("joints") || !j["joints"].is_array() || j["joints"].empty())
+            return false;
+
+        std::vector<JointDesc> loaded;
+        std::vector<std::string> loadedNames;
+        for (const auto &joint : j["joints"])
+        {
+            JointDesc desc{};
+            desc.pivot = ReadVector(joint.value("pivot", json::object()), {0.0f, 0.0f, 0.0f});
+            desc.axis = Vector3Normalize(ReadVector(joint.value("axis", json::object()), {0.0f, 1.0f, 0.0f}));
+
+            const json limits = joint.value("limits", json::object());
+            desc.limit.min = limits.value("min", -180.0f);
+            desc.limit.max = limits.value("max", 180.0f);
+            desc.limit.maxVelocity = limits.value("maxVelocity", desc.limit.maxVelocity);
+            desc.limit.maxAcceleration = limits.value("maxAcceleration", desc.limit.maxAcceleration);
+
+            // Niepoprawne limity zastępowane domyślnymi - zerowa prędkość lub przyspieszenie
+            // to dzielenie przez zero w parametryzacji czasowej, min > max psuje losowanie RRT
+            const JointLimit defaults{-180.0f, 180.0f};
+            const int index = (int)loaded.size();
+            if (!(desc.limit.min <= desc.limit.max))
+            {
+                TraceLog(LOG_WARNING, "Opis robota: przegub %d ma min %.1f > max %.1f - użyto [%.0f, %.0f]",
+                         index, desc.limit.min, desc.limit.max, defaults.min, defaults.max);
+                desc.limit.min = defaults.min;
+                desc.limit.max = defaults.max;
+            }
+            if (!(desc.limit.maxVelocity > 0.0f))
+            {
+                TraceLog(LOG_WARNING, "Opis robota: przegub %d ma maxVelocity %.1f - użyto %.1f",
+                         index, desc.limit.maxVelocity, defaults.maxVelocity);
+                desc.limit.maxVelocity = defaults.maxVelocity;
+            }
+            if (!(desc.limit.maxAcceleration > 0.0f))
+            {
+                TraceLog(LOG_WARNING, "Opis robota: przegub %d ma maxAcceleration %.1f - użyto %.1f",
+                         index, desc.limit.maxAcceleration, defaults.maxAcceleration);
+                desc.limit.maxAcceleration = defaults.maxAcceleration;
+            }
+
+            loaded.push_back(desc);
+            loadedNames.push_back(joint.value("name", std::string("Przegub ") + std::to_string(index)));
+        }
+
+        // Punkt narzędzia; bez sekcji "tool" TCP pokrywa się z ostatnim pivotem
+        JointDesc tool{};
+        tool.pivot = loaded.back().pivot;
+        if (j.contains("tool"))
+            tool.pivot = ReadVector(j["tool"].value("pivot", json::object()), tool.pivot);
+        loaded.push_back(tool);
+        loadedNames.push_back(j.contains("tool") ? j["tool"].value("name", std::string("TCP")) : std::string("TCP"));
+
+        joints.swap(loaded);
+        names.swap(loadedNames);
+        UpdateLengths();
+
+        // armLengths to pozostałość starego formatu - długości wynikają tylko z pivotów,
+        // a niezgodne wartości są jedynie zgłaszane
+        if (j.contains("armLengths") && j["armLengths"].is_array())
+        {
+            const auto &lengths = j["armLengths"];
+            for (int i = 0; i < GetJointCount() && i < (int)lengths.size(); i++)
+            {
+                float legacy = lengths[i].get<float>();
+                if (fabsf(legacy - joints[i].length) > 1e-3f * std::max(1.0f, joints[i].length))
+                    TraceLog(LOG_WARNING, "Opis robota: armLengths[%d] = %.2f różni się od odległości pivotów %.2f - pominięto",
+                             i, legacy, joints[i].length);
+            }
+        }
+    }
+    catch (const json::exception &e)
+    {
+        TraceLog(LOG_ERROR, "Błąd wczytywania opisu robota: %s", e.what());
+        return false;
+    }
+    return true;
+}
+
+std::vector<JointLimit> RobotDescription::GetLimits() const
+{
+    std::vector<JointLimit> limits;
+    for (int i = 0; i < GetJointCount(); i++)
+        limits.push_back(joints[i].limit);
+    return limits;
+}
+
+void RobotDescription::UpdateLengths()
+{
+    for (int i = 0; i < GetJointCount(); i++)
+        joints[i].length = Vector3Distance(joints[i].pivot, joints[i + 1].pivot);
+    if (!joints.empty())
+        joints.back().length = 0.0f;
+}
@@ -1,13 +1,175 @@
 #include "robotKinematics.h"
+#include "reachabilityMap.h"
+#include "ikSeedDatabase.h"
+#include "threadPool.h"
+#include "kinematicChain.h"
 
-RobotKinematics::RobotKinematics(Vector3* pivotPoints, float* armLengths, 
-                                ArmRotation* meshRotations, int meshCount, float scale)
-    : pivotPoints(pivotPoints), armLengths(armLengths), meshRotations(meshRotations),
-      meshCount(meshCount), scale(scale), interpolationType(InterpolationType::LINEAR)
+// Rozwiązuje A x = b dla symetrycznej, dodatnio określonej macierzy n x n
+// (rozkład Cholesky'ego w miejscu). Wynik trafia do b.
+static bool SolveSymmetric(float* A, float* b, int n) {
+    for (int j = 0; j < n; j++) {
+        float d = A[j * n + j];
+        for (int k = 0; k < j; k++) d -= A[j * n + k] * A[j * n + k];
+        if (d <= 0.0f) return false;
+        d = sqrtf(d);
+        A[j * n + j] = d;
+        for (int i = j + 1; i < n; i++) {
+            float v = A[i * n + j];
+            for (int k = 0; k < j; k++) v -= A[i * n + k] * A[j * n + k];
+            A[i * n + j] = v / d;
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        float v = b[i];
+        for (int k = 0; k < i; k++) v -= A[i * n + k] * b[k];
+        b[i] = v / A[i * n + i];
+    }
+    for (int i = n - 1; i >= 0; i--) {
+        float v = b[i];
+        for (int k = i + 1; k < n; k++) v -= A[k * n + i] * b[k];
+        b[i] = v / A[i * n + i];
+    }
+    return true;
+}
+
+RobotKinematics::RobotKinematics(RobotDescription* description, ArmRotation* meshRotations, float scale)
+    : description(description), meshRotations(meshRotations),
+      meshCount(description->GetJointCount()), scale(scale), interpolationType(InterpolationType::LINEAR),
+      solverType(IKSolverType::CCD), jointTransforms(meshCount, MatrixIdentity()), cachedRotations(meshCount),
+      cachedPivots(meshCount), dirtyFrom(0), chainSpec(nullptr), useSpecializedChain(true)
 {
     isTargetReachable = true;
     lastValidTarget = Vector3Zero();
     targetPosition = Vector3Zero();
+    targetOrientation = Vector3Zero();
+    targetRotation = MatrixIdentity();
+    useTargetOrientation = false;
+    reachabilityMap = nullptr;
+    seedDatabase = nullptr;
+    useSeedDatabase = true;
+
+}
+
+RobotKinematics::RobotKinematics(const RobotKinematics& settings, ArmRotation* scratchRotations)
+    : RobotKinematics(settings.description, scratchRotations, settings.scale)
+{
+    interpolationType = settings.interpolationType;
+    solverType = settings.solverType;
+    targetOrientation = settings.targetOrientation;
+    targetRotation = settings.targetRotation;
+    useTargetOrientation = settings.useTargetOrientation;
+    reachabilityMap = settings.reachabilityMap;
+    seedDatabase = settings.seedDatabase;
+    useSeedDatabase = settings.useSeedDatabase;
+    useSpecializedChain = settings.useSpecializedChain;
+}
+
+void RobotKinematics::SetTargetOrientation(const Vector3& eulerDegrees) {
+    targetOrientation = eulerDegrees;
+    targetRotation = MatrixIdentity();
+    targetRotation = MatrixMultiply(targetRotation, MatrixRotateX(eulerDegrees.x * DEG2RAD));
+    targetRotation = MatrixMultiply(targetRotation, MatrixRotateY(eulerDegrees.y * DEG2RAD));
+    targetRotation = MatrixMultiply(targetRotation, MatrixRotateZ(eulerDegrees.z * DEG2RAD));
+}
+
+float RobotKinematics::OrientationError(const Matrix& current, Vector3& errorAxis) const {
+    // Błąd orientacji jako 0.5 * suma iloczynów wektorowych kolumn macierzy obrotu
+    Vector3 c[3] = {{current.m0, current.m1, current.m2},
+                    {current.m4, current.m5, current.m6},
+                    {current.m8, current.m9, current.m10}};
+    Vector3 t[3] = {{targetRotation.m0, targetRotation.m1, targetRotation.m2},
+                    {targetRotation.m4, targetRotation.m5, targetRotation.m6},
+                    {targetRotation.m8, targetRotation.m9, targetRotation.m10}};
+    errorAxis = Vector3Zero();
+    float trace = 0.0f;
+    for (int k = 0; k < 3; k++) {
+        errorAxis = Vector3Add(errorAxis, Vector3Scale(Vector3CrossProduct(c[k], t[k]), 0.5f));
+        trace += Vector3DotProduct(c[k], t[k]);
+    }
+    return acosf(Clamp((trace - 1.0f) * 0.5f, -1.0f, 1.0f));
+}
+
+void RobotKinematics::SyncJointState() {
+    // Wykryj zmiany wprowadzone z zewnątrz (suwaki ImGui, Lua, edycja pivotów).
+    // Przeguby za dirtyFrom i tak zostaną przeliczone.
+    for (int i = 0; i < dirtyFrom; i++) {
+        const ArmRotation& current = meshRotations[i];
+        const ArmRotation& cached = cachedRotations[i];
+        if (current.angle != cached.angle ||
+            current.axis.x != cached.axis.x || current.axis.y != cached.axis.y || current.axis.z != cached.axis.z ||
+            Pivot(i).x != cachedPivots[i].x || Pivot(i).y != cachedPivots[i].y || Pivot(i).z != cachedPivots[i].z) {
+            dirtyFrom = i;
+            return;
+        }
+    }
+}
+
+void RobotKinematics::InvalidateFrom(int jointIndex) {
+    if (jointIndex < dirtyFrom) dirtyFrom = jointIndex < 0 ? 0 : jointIndex;
+}
+
+void RobotKinematics::UpdateTransformCache() {
+    // Zmiana osi przegubu może zmienić dostępną specjalizację łańcucha
+    for (int i = dirtyFrom; i < meshCount; i++) {
+        const Vector3& axis = meshRotations[i].axis;
+        const Vector3& cachedAxis = cachedRotations[i].axis;
+        if (axis.x != cachedAxis.x || axis.y != cachedAxis.y || axis.z != cachedAxis.z) {
+            chainSpec = SelectKinematicChain(meshRotations, meshCount);
+            break;
+        }
+    }
+
+    // Przelicz łańcuch tylko od pierwszego zmienionego przegubu
+    ComputeJointTransforms(meshRotations, dirtyFrom, jointTransforms.data());
+    for (int i = dirtyFrom; i < meshCount; i++) {
+        cachedRotations[i] = meshRotations[i];
+        cachedPivots[i] = Pivot(i);
+    }
+    dirtyFrom = meshCount;
+}
+
+void RobotKinematics::ComputeJointTransforms(const ArmRotation* rotations, int first, Matrix* frames) const {
+    if (chainSpec && useSpecializedChain) {
+        chainSpec->forward(description->joints.data(), rotations, first, frames);
+        return;
+    }
+
+    for (int i = first; i < meshCount; i++) {
+        Matrix transform = (i == 0) ? MatrixIdentity() : frames[i - 1];
+        Vector3 globalPivotPos = Vector3Transform(Pivot(i), transform);
+        transform = MatrixMultiply(transform, MatrixTranslate(-globalPivotPos.x, -globalPivotPos.y, -globalPivotPos.z));
+
+        Vector3 newAxis = TransformAxis(rotations[i].axis, transform);
+        transform = MatrixMultiply(transform, MatrixRotate(newAxis, rotations[i].angle * DEG2RAD));
+        transform = MatrixMultiply(transform, MatrixTranslate(globalPivotPos.x, globalPivotPos.y, globalPivotPos.z));
+
+        frames[i] = transform;
+    }
+}
+
+const Matrix& RobotKinematics::CachedTransform(int meshIndex) {
+    if (dirtyFrom <= meshIndex) UpdateTransformCache();
+    return jointTransforms[meshIndex];
+}
+
+Vector3 RobotKinematics::CachedEndEffectorPosition() {
+    Vector3 endEffector = Vector3Transform(Pivot(meshCount), CachedTransform(meshCount - 1));
+    return Vector3Scale(endEffector, scale);
+}
+
+Matrix RobotKinematics::GetJointTransform(int meshIndex) {
+    if (meshIndex < 0) return MatrixIdentity();
+    SyncJointState();
+    return CachedTransform(meshIndex);
+}
+
+BatchKinematics RobotKinematics::CreateBatchKinematics() const {
+    return BatchKinematics(*description, meshRotations, scale);
+}
+
+Vector3 RobotKinematics::GetJointPosition(int pivotIndex) {
+    Matrix parentTransform = GetJointTransform(pivotIndex - 1);
+    return Vector3Scale(Vector3Transform(Pivot(pivotIndex), parentTransform), scale);
 }
 
 float RobotKinematics::ClampAngle(float angle, float min, float max) {
@@ -16,33 +178,108 @@ float RobotKinematics::ClampAngle(float angle, float min, float max) {
     return fmaxf(min, fminf(max, angle));
 }
 
-bool RobotKinematics::IsPositionReachable(const Vector3& position) {
+float RobotKinematics::GetTotalLength() const {
     float totalLength = 0.0f;
     for (int i = 0; i < meshCount; i++) {
-        totalLength += armLengths[i];
+        totalLength += Length(i);
     }
-    totalLength *= scale;
+    return totalLength;
+}
 
-    Vector3 basePos = Vector3Scale(pivotPoints[0], scale);
-    float targetDistance = Vector3Distance(basePos, position);
+uint64_t RobotKinematics::GetConfigHash() const {
+    // FNV-1a po geometrii i ograniczeniach - zmiana dowolnego parametru unieważnia dane offline
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; i++) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+    };
+    mix(&meshCount, sizeof(meshCount));
+    for (int i = 0; i <= meshCount; i++) mix(&Pivot(i), sizeof(Vector3));
+    for (int i = 0; i < meshCount; i++) {
+        mix(&meshRotations[i].axis, sizeof(Vector3));
+        mix(&Limit(i).min, sizeof(float));
+        mix(&Limit(i).max, sizeof(float));
+        mix(&description->joints[i].length, sizeof(float));
+    }
+    return hash;
+}
+
+bool RobotKinematics::HasValidReachabilityMap() const {
+    return reachabilityMap && reachabilityMap->IsLoaded() &&
+           reachabilityMap->GetConfigHash() == GetConfigHash();
+}
+
+int RobotKinematics::GetReachabilityQuality(const Vector3& position) const {
+    if (!HasValidReachabilityMap() || scale <= 0.0f) return -1;
+    return reachabilityMap->GetQuality(Vector3Scale(position, 1.0f / scale));
+}
+
+bool RobotKinematics::HasValidSeedDatabase() const {
+    return seedDatabase && seedDatabase->IsLoaded() &&
+           seedDatabase->GetConfigHash() == GetConfigHash();
+}
+
+float RobotKinematics::SeedCost() {
+    // Odległość końcówki od celu, z błędem orientacji przeliczonym na jednostki świata
+    float cost = Vector3Distance(CachedEndEffectorPosition(), targetPosition);
+    if (useTargetOrientation) {
+        Vector3 axis;
+        cost += OrientationError(CachedTransform(meshCount - 1), axis) * 100.0f * scale;
+    }
+    return cost;
+}
 
-    if (targetDistance > totalLength) {
+bool RobotKinematics::ApplySeed() {
+    if (!HasValidSeedDatabase() || scale <= 0.0f) return false;
+
+    std::vector<float> seed(meshCount);
+    const Matrix* rotation = useTargetOrientation ? &targetRotation : nullptr;
+    if (!seedDatabase->FindSeed(Vector3Scale(targetPosition, 1.0f / scale), rotation, seed.data())) {
         return false;
     }
 
+    std::vector<float> current(meshCount);
+    for (int i = 0; i < meshCount; i++) current[i] = meshRotations[i].angle;
+    float currentCost = SeedCost();
+
+    for (int i = 0; i < meshCount; i++) meshRotations[i].angle = seed[i];
+    SyncJointState();
+    if (SeedCost() < currentCost) return true;
+
+    for (int i = 0; i < meshCount; i++) meshRotations[i].angle = current[i];
+    SyncJointState();
+    return false;
+}
+
+bool RobotKinematics::IsPositionReachable(const Vector3& position) {
     if (position.y < 0) {
         return false;
     }
 
+    // Mapa wokselowa zna rzeczywistą przestrzeń roboczą (z ograniczeniami przegubów)
+    if (HasValidReachabilityMap()) {
+        return reachabilityMap->IsReachable(Vector3Scale(position, 1.0f / scale));
+    }
+
+    Vector3 basePos = Vector3Scale(Pivot(0), scale);
+    float targetDistance = Vector3Distance(basePos, position);
+
+    if (targetDistance > GetTotalLength() * scale) {
+        return false;
+    }
+
     return true;
 }
 
-Matrix RobotKinematics::GetHierarchicalTransform(int meshIndex, ArmRotation* rotations, Vector3* pivots) {
+Matrix RobotKinematics::GetHierarchicalTransform(int meshIndex, ArmRotation* rotations, const JointDesc* joints) {
     // Przeniesiona implementacja z RobotArm
     if (meshIndex < 0) return MatrixIdentity();
     
-    Matrix transform = GetHierarchicalTransform(meshIndex - 1, rotations, pivots);
-    Vector3 globalPivotPos = Vector3Transform(pivots[meshIndex], transform);
+    Matrix transform = GetHierarchicalTransform(meshIndex - 1, rotations, joints);
+    Vector3 globalPivotPos = Vector3Transform(joints[meshIndex].pivot, transform);
     transform = MatrixMultiply(transform, MatrixTranslate(-globalPivotPos.x, -globalPivotPos.y, -globalPivotPos.z));
     
     Vector3 newAxis = TransformAxis(rotations[meshIndex].axis, transform);
@@ -53,44 +290,98 @@ Matrix RobotKinematics::GetHierarchicalTransform(int meshIndex, ArmRotation* rot
 }
 
 void RobotKinematics::SolveIK() {
- const float TOLERANCE = 0.001f;
-    const int MAX_ITERATIONS = 10;
-    const float DAMPING = 0.1f; // Współczynnik tłumienia dla stabilności
-    
-    Vector3 basePos = Vector3Scale(pivotPoints[0], scale);
-    Vector3 currentEndEffector = CalculateEndEffectorPosition();
-    
-    // Ograniczenia kątowe dla każdego przegubu (min, max)
-    const float jointLimits[6][2] = {
-        {-180.0f, 180.0f}, // Baza
-        {-90.0f, 90.0f},   // Ramię 1
-        {-120.0f, 120.0f}, // Ramię 2
-        {-120.0f, 120.0f}, // Ramię 3
-        {-180.0f, 180.0f}, // Ramię 4
-        {-90.0f, 90.0f}    // Chwytak
-    };
+    SyncJointState();
+
+    // Z mapą osiągalności nie iteruj na celach poza przestrzenią roboczą
+    if (HasValidReachabilityMap()) {
+        isTargetReachable = IsPositionReachable(targetPosition);
+        if (!isTargetReachable) {
+            lastIKResult = IKResult{};
+            lastIKResult.reachable = false;
+            lastIKResult.positionError = Vector3Distance(CachedEndEffectorPosition(), targetPosition);
+            return;
+        }
+        lastValidTarget = targetPosition;
+    }
 
     // Sprawdź osiągalność celu
+    Vector3 basePos = Vector3Scale(Pivot(0), scale);
     float totalLength = 0.0f;
     for(int i = 0; i < meshCount; i++) {
-        totalLength += armLengths[i] * scale;
+        totalLength += Length(i) * scale;
     }
     
     float targetDistance = Vector3Distance(basePos, targetPosition);
+    bool reachable = targetDistance <= totalLength;
     if(targetDistance > totalLength) {
         Vector3 direction = Vector3Normalize(Vector3Subtract(targetPosition, basePos));
         targetPosition = Vector3Add(basePos, Vector3Scale(direction, totalLength));
     }
 
-    for(int iter = 0; iter < MAX_ITERATIONS; iter++) {
-        Vector3 prevEndEffector = CalculateEndEffectorPosition();
+    // Solwery iteracyjne startują z najbliższej próbki z bazy, jeśli jest lepsza od bieżącej pozy
+    if (useSeedDatabase && solverType != IKSolverType::ANALYTICAL) {
+        ApplySeed();
+    }
+
+    switch(solverType) {
+        case IKSolverType::CCD:
+            SolveCCD();
+            break;
+        case IKSolverType::JACOBIAN_DLS:
+            SolveDLS();
+            break;
+        case IKSolverType::ANALYTICAL:
+            // Dla robotów o innej geometrii (lub celu poza zasięgiem) użyj solvera iteracyjnego
+            if (!SolveAnalytical()) SolveDLS();
+            break;
+    }
+    lastIKResult.reachable = reachable;
+}
+
+void RobotKinematics::SolveIKBatch(const std::vector<IKTarget>& targets, std::vector<float>& outAngles,
+                                   std::vector<IKResult>& outResults) const {
+    const int count = (int)targets.size();
+    outAngles.resize((size_t)count * meshCount);
+    outResults.resize(count);
+
+    // Poza startowa skopiowana raz - wątki nie czytają współdzielonego meshRotations
+    std::vector<ArmRotation> startPose(meshRotations, meshRotations + meshCount);
+
+    ThreadPool::GetInstance().ParallelFor(count, [&](int begin, int end) {
+        std::vector<ArmRotation> scratch(startPose);
+        RobotKinematics solver(*this, scratch.data());
+
+        for (int t = begin; t < end; t++) {
+            for (int i = 0; i < meshCount; i++) scratch[i].angle = startPose[i].angle;
+
+            const IKTarget& target = targets[t];
+            solver.SetUseTargetOrientation(target.useOrientation);
+            if (target.useOrientation) solver.SetTargetOrientation(target.orientation);
+            solver.SetTargetPosition(target.position);
+            solver.SolveIK();
+
+            outResults[t] = solver.GetLastIKResult();
+            for (int i = 0; i < meshCount; i++) outAngles[(size_t)t * meshCount + i] = scratch[i].angle;
+        }
+    }, 4);
+}
+
+void RobotKinematics::SolveCCD() {
+    const float TOLERANCE = 0.001f;
+    const int MAX_ITERATIONS = 10;
+    const float DAMPING = 0.1f; // Współczynnik tłumienia dla stabilności
+
+    lastIKResult = IKResult{};
+    int iter = 0;
+    for(; iter < MAX_ITERATIONS; iter++) {
+        Vector3 prevEndEffector = CachedEndEffectorPosition();
         
         for(int i = 0; i < meshCount - 1; i++) {
-            Matrix currentTransform = GetHierarchicalTransform(i, meshRotations, pivotPoints);
-            Vector3 jointPos = Vector3Transform(pivotPoints[i], currentTransform);
+            Matrix currentTransform = CachedTransform(i);
+            Vector3 jointPos = Vector3Transform(Pivot(i), currentTransform);
             jointPos = Vector3Scale(jointPos, scale);
             
-            Vector3 currentEndEffector = CalculateEndEffectorPosition();
+            Vector3 currentEndEffector = CachedEndEffectorPosition();
             
             // Wektory do obliczeń
             Vector3 toEndEffector = Vector3Normalize(Vector3Subtract(currentEndEffector, jointPos));
@@ -121,21 +412,353 @@ void RobotKinematics::SolveIK() {
                 }
                 
                 // Ogranicz kąt do dozwolonego zakresu
-                newAngle = ClampAngle(newAngle, jointLimits[i][0], jointLimits[i][1]);
+                newAngle = ClampAngle(newAngle, Limit(i).min, Limit(i).max);
                 meshRotations[i].angle = newAngle;
+                InvalidateFrom(i);
             }
         }
         
         // Sprawdź postęp
-        Vector3 newEndEffector = CalculateEndEffectorPosition();
+        Vector3 newEndEffector = CachedEndEffectorPosition();
         float improvement = Vector3Distance(prevEndEffector, targetPosition) - 
                           Vector3Distance(newEndEffector, targetPosition);
         
         if(improvement < TOLERANCE || 
            Vector3Distance(newEndEffector, targetPosition) < TOLERANCE) {
+            iter++;
+            break;
+        }
+    }
+
+    lastIKResult.iterations = iter;
+    lastIKResult.positionError = Vector3Distance(CachedEndEffectorPosition(), targetPosition);
+    Vector3 axis;
+    lastIKResult.orientationError = OrientationError(CachedTransform(meshCount - 1), axis);
+    lastIKResult.converged = lastIKResult.positionError < TOLERANCE;
+}
+
+void RobotKinematics::SolveDLS() {
+    const float POSITION_TOLERANCE = 0.001f;
+    const float ORIENTATION_TOLERANCE = 0.001f;
+    const int MAX_ITERATIONS = 100;
+    const float MAX_STEP = 10.0f * DEG2RAD;  // Maksymalny krok przegubu na iterację
+    const float NULLSPACE_GAIN = 0.05f;      // Wzmocnienie unikania ograniczeń przegubów
+    const float MIN_LAMBDA = 0.001f;
+    const float MAX_LAMBDA = 10.0f;
+    float lambda = 0.05f; // Współczynnik tłumienia (Levenberg–Marquardt)
+
+    const int n = meshCount;
+    const int rows = useTargetOrientation ? 6 : 3;
+    std::vector<float> J(rows * n);
+    std::vector<float> delta(n);
+    std::vector<float> previous(n);
+    float A[36];
+    float error[6];
+    float y[6];
+
+    // Wektor błędu (pozycja + orientacja), zwraca jego kwadrat normy
+    auto evaluate = [&](float* err, float& posError, float& rotError) {
+        Vector3 dp = Vector3Subtract(targetPosition, CachedEndEffectorPosition());
+        err[0] = dp.x; err[1] = dp.y; err[2] = dp.z;
+        posError = Vector3Length(dp);
+        Vector3 axis;
+        rotError = OrientationError(CachedTransform(n - 1), axis);
+        float cost = posError * posError;
+        if (useTargetOrientation) {
+            err[3] = axis.x; err[4] = axis.y; err[5] = axis.z;
+            cost += Vector3LengthSqr(axis);
+        }
+        return cost;
+    };
+
+    lastIKResult = IKResult{};
+    float posError, rotError;
+    float cost = evaluate(error, posError, rotError);
+
+    int iter = 0;
+    for (; iter < MAX_ITERATIONS; iter++) {
+        if (posError < POSITION_TOLERANCE && (!useTargetOrientation || rotError < ORIENTATION_TOLERANCE)) {
             break;
         }
+
+        // Jakobian: dla przegubu obrotowego Jv = a x (e - p), Jw = a
+        Vector3 endEffector = CachedEndEffectorPosition();
+        for (int i = 0; i < n; i++) {
+            const Matrix& transform = CachedTransform(i);
+            Vector3 axis = TransformAxis(meshRotations[i].axis, transform);
+            Vector3 jointPos = Vector3Scale(Vector3Transform(Pivot(i), transform), scale);
+            Vector3 linear = Vector3CrossProduct(axis, Vector3Subtract(endEffector, jointPos));
+            J[0 * n + i] = linear.x;
+            J[1 * n + i] = linear.y;
+            J[2 * n + i] = linear.z;
+            if (useTargetOrientation) {
+                J[3 * n + i] = axis.x;
+                J[4 * n + i] = axis.y;
+                J[5 * n + i] = axis.z;
+            }
+        }
+
+        // A = J J^T + lambda^2 I
+        auto buildA = [&]() {
+            for (int r = 0; r < rows; r++) {
+                for (int c = 0; c < rows; c++) {
+                    float v = 0.0f;
+                    for (int i = 0; i < n; i++) v += J[r * n + i] * J[c * n + i];
+                    A[r * rows + c] = v + (r == c ? lambda * lambda : 0.0f);
+                }
+            }
+        };
+
+        // delta = J^T (J J^T + lambda^2 I)^-1 e
+        buildA();
+        for (int r = 0; r < rows; r++) y[r] = error[r];
+        if (!SolveSymmetric(A, y, rows)) break;
+        for (int i = 0; i < n; i++) {
+            float v = 0.0f;
+            for (int r = 0; r < rows; r++) v += J[r * n + i] * y[r];
+            delta[i] = v;
+        }
+
+        // Rzut gradientu odległości od środka zakresu na przestrzeń zerową: (I - J+ J) z
+        std::vector<float> z(n, 0.0f);
+        for (int i = 0; i < n; i++) {
+            float halfRange = (Limit(i).max - Limit(i).min) * 0.5f;
+            if (halfRange >= 180.0f) continue;
+            float mid = (Limit(i).max + Limit(i).min) * 0.5f;
+            z[i] = -NULLSPACE_GAIN * (meshRotations[i].angle - mid) / halfRange;
+        }
+        for (int r = 0; r < rows; r++) {
+            float v = 0.0f;
+            for (int i = 0; i < n; i++) v += J[r * n + i] * z[i];
+            y[r] = v;
+        }
+        buildA();
+        if (SolveSymmetric(A, y, rows)) {
+            for (int i = 0; i < n; i++) {
+                float v = 0.0f;
+                for (int r = 0; r < rows; r++) v += J[r * n + i] * y[r];
+                delta[i] += z[i] - v;
+            }
+        }
+
+        // Ogranicz długość kroku
+        float maxDelta = 0.0f;
+        for (int i = 0; i < n; i++) maxDelta = fmaxf(maxDelta, fabsf(delta[i]));
+        float stepScale = maxDelta > MAX_STEP ? MAX_STEP / maxDelta : 1.0f;
+
+        for (int i = 0; i < n; i++) {
+            previous[i] = meshRotations[i].angle;
+            float newAngle = meshRotations[i].angle + delta[i] * stepScale * RAD2DEG;
+            meshRotations[i].angle = ClampAngle(newAngle, Limit(i).min, Limit(i).max);
+        }
+        InvalidateFrom(0);
+
+        float newError[6];
+        float newPosError, newRotError;
+        float newCost = evaluate(newError, newPosError, newRotError);
+        if (newCost > cost) {
+            // Krok pogorszył wynik - cofnij i zwiększ tłumienie
+            for (int i = 0; i < n; i++) meshRotations[i].angle = previous[i];
+            InvalidateFrom(0);
+            lambda = fminf(lambda * 2.0f, MAX_LAMBDA);
+            if (lambda >= MAX_LAMBDA) {
+                iter++;
+                break;
+            }
+        } else {
+            lambda = fmaxf(lambda * 0.5f, MIN_LAMBDA);
+            cost = newCost;
+            posError = newPosError;
+            rotError = newRotError;
+            for (int r = 0; r < rows; r++) error[r] = newError[r];
+        }
+    }
+
+    lastIKResult.iterations = iter;
+    lastIKResult.positionError = posError;
+    lastIKResult.orientationError = rotError;
+    lastIKResult.converged = posError < POSITION_TOLERANCE &&
+                             (!useTargetOrientation || rotError < ORIENTATION_TOLERANCE);
+}
+
+static bool AxisEquals(Vector3 axis, Vector3 expected) {
+    return Vector3Distance(Vector3Normalize(axis), expected) < 1e-4f;
+}
+
+static float WrapAngle(float angle) {
+    angle = fmodf(angle + 180.0f, 360.0f);
+    if (angle < 0.0f) angle += 360.0f;
+    return angle - 180.0f;
+}
+
+// Obrót punktu wokół osi przechodzącej przez pivot (w układzie lokalnym modelu)
+static Vector3 RotateAbout(Vector3 point, Vector3 pivot, Vector3 axis, float angleDeg) {
+    Vector3 local = Vector3Transform(Vector3Subtract(point, pivot), MatrixRotate(axis, angleDeg * DEG2RAD));
+    return Vector3Add(local, pivot);
+}
+
+bool RobotKinematics::IsAnalyticalGeometry() const {
+    // Baza Y, ramię Y, dwa przeguby Z w płaszczyźnie ramienia, nadgarstek X (roll) + Z (pitch),
+    // z punktem narzędzia leżącym na osi roll - jak w assets/robots/.robot/config.json
+    if (meshCount != 6) return false;
+    const Vector3 X = {1.0f, 0.0f, 0.0f}, Y = {0.0f, 1.0f, 0.0f}, Z = {0.0f, 0.0f, 1.0f};
+    if (!AxisEquals(meshRotations[0].axis, Y) || !AxisEquals(meshRotations[1].axis, Y) ||
+        !AxisEquals(meshRotations[2].axis, Z) || !AxisEquals(meshRotations[3].axis, Z) ||
+        !AxisEquals(meshRotations[4].axis, X) || !AxisEquals(meshRotations[5].axis, Z)) {
+        return false;
+    }
+    const float EPS = 1e-3f;
+    for (int i = 0; i < 2; i++) {
+        if (fabsf(Pivot(i).x) > EPS || fabsf(Pivot(i).z) > EPS) return false;
+    }
+    for (int i = 2; i <= 6; i++) {
+        if (fabsf(Pivot(i).z) > EPS) return false;
+    }
+    return fabsf(Pivot(5).y - Pivot(4).y) < EPS &&
+           fabsf(Pivot(6).y - Pivot(4).y) < EPS;
+}
+
+bool RobotKinematics::SolveAnalytical() {
+    if (!IsAnalyticalGeometry() || scale <= 0.0f) return false;
+
+    const float POSITION_TOLERANCE = 0.001f;
+    const Vector3 S = Pivot(2);  // bark
+    const Vector3 E = Pivot(3);  // łokieć
+    const Vector3 W2 = Pivot(5); // pitch nadgarstka
+    const Vector3 TCP = Pivot(6);
+    const Vector3 target = Vector3Scale(targetPosition, 1.0f / scale);
+
+    float current[6];
+    for (int i = 0; i < 6; i++) current[i] = meshRotations[i].angle;
+
+    // Punkt, który rozwiązujemy pozycyjnie, i jego wektor od łokcia w układzie ramienia 3
+    Vector3 point, u;
+    Vector3 toolAxis = Vector3Zero();
+    if (useTargetOrientation) {
+        // Oś narzędzia (lokalne X) celu; środek nadgarstka leży na niej w odległości narzędzia
+        toolAxis = Vector3Normalize(TransformAxis(Vector3{1.0f, 0.0f, 0.0f}, targetRotation));
+        Vector3 tool = TransformAxis(Vector3Subtract(TCP, W2), targetRotation);
+        point = Vector3Subtract(target, Vector3Scale(tool, Vector3Distance(TCP, W2)));
+        u = Vector3Subtract(W2, E);
+    } else {
+        // Bez orientacji zachowaj bieżący nadgarstek - reszta łańcucha jest sztywna
+        Vector3 tail = RotateAbout(TCP, W2, meshRotations[5].axis, current[5]);
+        tail = RotateAbout(tail, Pivot(4), meshRotations[4].axis, current[4]);
+        point = target;
+        u = Vector3Subtract(tail, E);
+    }
+
+    const float r2 = point.x * point.x + point.z * point.z;
+    const float d = u.z;
+    if (r2 < d * d) return false;
+
+    const Vector3 L1 = Vector3Subtract(E, S);
+    const float a = sqrtf(L1.x * L1.x + L1.y * L1.y);
+    const float b = sqrtf(u.x * u.x + u.y * u.y);
+    if (a < 1e-6f || b < 1e-6f) return false;
+
+    float best[6];
+    float bestCost = -1.0f;
+
+    auto fitLimits = [&](float* q) {
+        for (int i = 0; i < 6; i++) {
+            float angle = WrapAngle(q[i]);
+            // Przesuń o pełny obrót, jeśli mieści się wtedy w zakresie
+            if (angle > Limit(i).max) angle -= 360.0f;
+            if (angle < Limit(i).min) angle += 360.0f;
+            if (angle < Limit(i).min - 1e-3f || angle > Limit(i).max + 1e-3f) return false;
+            q[i] = angle;
+        }
+        return true;
+    };
+
+    auto consider = [&](float* q, float rotationError) {
+        if (!fitLimits(q)) return;
+        // Dla celu z orientacją rozstrzyga błąd obrotu wokół osi narzędzia
+        float cost = rotationError * 1e6f;
+        for (int i = 0; i < 6; i++) {
+            float diff = WrapAngle(q[i] - current[i]);
+            cost += diff * diff;
+        }
+        if (bestCost < 0.0f || cost < bestCost) {
+            bestCost = cost;
+            for (int i = 0; i < 6; i++) best[i] = q[i];
+        }
+    };
+
+    // Gałęzie barku (przód/tył) x łokcia (góra/dół) x nadgarstka (flip)
+    for (int shoulder = 0; shoulder < 2; shoulder++) {
+        float qx = (shoulder == 0 ? 1.0f : -1.0f) * sqrtf(r2 - d * d);
+        float psi = (atan2f(d, qx) - atan2f(point.z, point.x)) * RAD2DEG;
+
+        float Dx = qx - S.x;
+        float Dy = point.y - S.y;
+        float cosPhi = (Dx * Dx + Dy * Dy - a * a - b * b) / (2.0f * a * b);
+        if (cosPhi < -1.0f || cosPhi > 1.0f) continue;
+
+        for (int elbow = 0; elbow < 2; elbow++) {
+            float phi = (elbow == 0 ? 1.0f : -1.0f) * acosf(cosPhi);
+            float q3 = phi + atan2f(L1.y, L1.x) - atan2f(u.y, u.x);
+            float vx = L1.x + cosf(q3) * u.x - sinf(q3) * u.y;
+            float vy = L1.y + sinf(q3) * u.x + cosf(q3) * u.y;
+            float q2 = atan2f(Dy, Dx) - atan2f(vy, vx);
+
+            float q[6];
+            q[1] = current[1];
+            q[0] = psi - q[1];
+            q[2] = q2 * RAD2DEG;
+            q[3] = q3 * RAD2DEG;
+
+            if (!useTargetOrientation) {
+                q[4] = current[4];
+                q[5] = current[5];
+                consider(q, 0.0f);
+                continue;
+            }
+
+            // Oś narzędzia w układzie ramienia 3: R03^T * toolAxis, R03 = Ry(psi) Rz(q2 + q3)
+            Matrix r03 = MatrixMultiply(MatrixRotateZ((q2 + q3)), MatrixRotateY(psi * DEG2RAD));
+            Vector3 v = Vector3Transform(toolAxis, MatrixTranspose(r03));
+            // Rx(q4) Rz(q5) e_x = (cos q5, cos q4 sin q5, sin q4 sin q5)
+            float c5 = Clamp(v.x, -1.0f, 1.0f);
+            float s5 = sqrtf(fmaxf(0.0f, 1.0f - c5 * c5));
+            for (int wrist = 0; wrist < 2; wrist++) {
+                float sign = wrist == 0 ? 1.0f : -1.0f;
+                if (s5 < 1e-4f) {
+                    // Osobliwość nadgarstka - roll dowolny, zostaw bieżący
+                    q[4] = current[4];
+                    q[5] = c5 > 0.0f ? 0.0f : 180.0f;
+                } else {
+                    q[5] = atan2f(sign * s5, c5) * RAD2DEG;
+                    q[4] = atan2f(sign * v.z, sign * v.y) * RAD2DEG;
+                }
+                Matrix wristRotation = MatrixMultiply(MatrixRotateZ(q[5] * DEG2RAD), MatrixRotateX(q[4] * DEG2RAD));
+                Vector3 axis;
+                float rotationError = OrientationError(MatrixMultiply(wristRotation, r03), axis);
+
+                float candidate[6];
+                for (int i = 0; i < 6; i++) candidate[i] = q[i];
+                consider(candidate, rotationError);
+            }
+        }
     }
+
+    if (bestCost < 0.0f) return false;
+
+    for (int i = 0; i < 6; i++) meshRotations[i].angle = best[i];
+    InvalidateFrom(0);
+
+    lastIKResult = IKResult{};
+    lastIKResult.positionError = Vector3Distance(CachedEndEffectorPosition(), targetPosition);
+    Vector3 axis;
+    lastIKResult.orientationError = OrientationError(CachedTransform(meshCount - 1), axis);
+    lastIKResult.converged = lastIKResult.positionError < POSITION_TOLERANCE;
+    if (!lastIKResult.converged) {
+        for (int i = 0; i < 6; i++) meshRotations[i].angle = current[i];
+        InvalidateFrom(0);
+        return false;
+    }
+    return true;
 }
 
 Vector3 RobotKinematics::TransformAxis(Vector3 axis, Matrix transform) {
@@ -147,9 +770,8 @@ Vector3 RobotKinematics::TransformAxis(Vector3 axis, Matrix transform) {
 }
 
 Vector3 RobotKinematics::CalculateEndEffectorPosition() {
-    Matrix transform = GetHierarchicalTransform(meshCount - 1, meshRotations, pivotPoints);
-    Vector3 endEffector = Vector3Transform(pivotPoints[meshCount], transform);
-    return Vector3Scale(endEffector, scale);
+    SyncJointState();
+    return CachedEndEffectorPosition();
 }
 
 void RobotKinematics::CalculateTrajectory() {
@@ -180,8 +802,7 @@ void RobotKinematics::CalculateTrajectory() {
             float heightOffset = pathLength * 0.5f;
             float maxHeight = 0;
             for(int i = 0; i <= meshCount; i++) {
-                Vector3 point = Vector3Transform(pivotPoints[i], 
-                    GetHierarchicalTransform(i-1, meshRotations, pivotPoints));
+                Vector3 point = Vector3Transform(Pivot(i), GetJointTransform(i - 1));
                 maxHeight = fmaxf(maxHeight, point.y);
             }
             
@@ -247,4 +868,55 @@ void RobotKinematics::CalculateTrajectory() {
             break;
         }
     }
-}
\ No newline at end of file
+}
+
+bool RobotKinematics::BuildTimedTrajectory(const std::vector<float>& waypoints) {
+    return timedTrajectory.BuildFromPath(waypoints, meshCount, description->GetLimits());
+}
+
+int RobotKinematics::PlanTimedTrajectory(MotionProfile profile) {
+    return PlanTimedTrajectory(profile, timedTrajectory);
+}
+
+int RobotKinematics::PlanTimedTrajectory(MotionProfile profile, TimedTrajectory& out) {
+    SyncJointState();
+
+    std::vector<float> startAngles(meshCount);
+    for (int i = 0; i < meshCount; i++) {
+        startAngles[i] = meshRotations[i].angle;
+    }
+
+    Vector3 savedTarget = targetPosition;
+    int failures = 0;
+
+    auto solveTo = [&](const Vector3& point, std::vector<float>& out) {
+        targetPosition = point;
+        SolveIK();
+        if (!lastIKResult.converged) failures++;
+        for (int i = 0; i < meshCount; i++) {
+            out.push_back(meshRotations[i].angle);
+        }
+    };
+
+    std::vector<float> waypoints(startAngles);
+    if (profile == MotionProfile::PTP || trajectoryPoints.size() < 2) {
+        solveTo(savedTarget, waypoints);
+        out.BuildPointToPoint(&waypoints[0], &waypoints[meshCount], meshCount, description->GetLimits());
+    } else {
+        // Kolejne punkty rozwiązywane z ciepłym startem z poprzedniego; baza punktów
+        // startowych tylko dla pierwszego, żeby nie przeskakiwać między gałęziami IK
+        bool seeds = useSeedDatabase;
+        for (size_t p = 1; p < trajectoryPoints.size(); p++) {
+            solveTo(trajectoryPoints[p], waypoints);
+            useSeedDatabase = false;
+        }
+        useSeedDatabase = seeds;
+        out.BuildFromPath(waypoints, meshCount, description->GetLimits());
+    }
+
+    for (int i = 0; i < meshCount; i++) {
+        meshRotations[i].angle = startAngles[i];
+    }
+    targetPosition = savedTarget;
+    return failures;
+}
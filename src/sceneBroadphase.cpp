@@ -0,0 +1,363 @@
+#include "sceneBroadphase.h"
+#include "object3D.h"
+#include <algorithm>
+
+namespace
+{
+    BoundingBox Union(const BoundingBox &a, const BoundingBox &b)
+    {
+        return {Vector3Min(a.min, b.min), Vector3Max(a.max, b.max)};
+    }
+
+    float Area(const BoundingBox &box)
+    {
+        Vector3 e = Vector3Subtract(box.max, box.min);
+        return 2.0f * (e.x * e.y + e.y * e.z + e.z * e.x);
+    }
+
+    bool Contains(const BoundingBox &outer, const BoundingBox &inner)
+    {
+        return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && outer.min.z <= inner.min.z &&
+               outer.max.x >= inner.max.x && outer.max.y >= inner.max.y && outer.max.z >= inner.max.z;
+    }
+
+    bool RayHitsBox(Vector3 origin, Vector3 invDir, const BoundingBox &box, float maxDistance)
+    {
+        float tx1 = (box.min.x - origin.x) * invDir.x, tx2 = (box.max.x - origin.x) * invDir.x;
+        float ty1 = (box.min.y - origin.y) * invDir.y, ty2 = (box.max.y - origin.y) * invDir.y;
+        float tz1 = (box.min.z - origin.z) * invDir.z, tz2 = (box.max.z - origin.z) * invDir.z;
+        float tNear = fmaxf(fmaxf(fminf(tx1, tx2), fminf(ty1, ty2)), fminf(tz1, tz2));
+        float tFar = fminf(fminf(fmaxf(tx1, tx2), fmaxf(ty1, ty2)), fmaxf(tz1, tz2));
+        return tNear <= tFar && tFar >= 0.0f && tNear <= maxDistance;
+    }
+}
+
+BoundingBox SceneBroadphase::Fatten(const BoundingBox &aabb, float factor)
+{
+    Vector3 extent = Vector3Subtract(aabb.max, aabb.min);
+    float margin = factor * std::max({extent.x, extent.y, extent.z, 1e-3f});
+    Vector3 r = {margin, margin, margin};
+    return {Vector3Subtract(aabb.min, r), Vector3Add(aabb.max, r)};
+}
+
+int SceneBroadphase::AllocateNode()
+{
+    if (freeList < 0)
+    {
+        nodes.push_back(TreeNode{});
+        return (int)nodes.size() - 1;
+    }
+    int index = freeList;
+    freeList = nodes[index].parent;
+    nodes[index] = TreeNode{};
+    return index;
+}
+
+void SceneBroadphase::FreeNode(int index)
+{
+    nodes[index] = TreeNode{};
+    nodes[index].parent = freeList;
+    freeList = index;
+}
+
+int SceneBroadphase::CreateProxy(const BoundingBox &aabb, Object3D *object)
+{
+    int proxyId = AllocateNode();
+    nodes[proxyId].aabb = Fatten(aabb, FAT_MARGIN);
+    nodes[proxyId].object = object;
+    nodes[proxyId].height = 0;
+    InsertLeaf(proxyId);
+    proxyCount++;
+    return proxyId;
+}
+
+void SceneBroadphase::DestroyProxy(int proxyId)
+{
+    RemoveLeaf(proxyId);
+    FreeNode(proxyId);
+    proxyCount--;
+}
+
+bool SceneBroadphase::MoveProxy(int proxyId, const BoundingBox &aabb, Vector3 displacement)
+{
+    // Zostaw liść, jeśli nadal mieści się w grubym AABB, który nie urósł zbyt mocno
+    const BoundingBox &fat = nodes[proxyId].aabb;
+    if (Contains(fat, aabb) && Contains(Fatten(aabb, 4.0f * FAT_MARGIN), fat))
+        return false;
+
+    RemoveLeaf(proxyId);
+
+    BoundingBox fatAABB = Fatten(aabb, FAT_MARGIN);
+    Vector3 d = Vector3Scale(displacement, DISPLACEMENT_FACTOR);
+    fatAABB.min = Vector3Add(fatAABB.min, Vector3Min(d, Vector3Zero()));
+    fatAABB.max = Vector3Add(fatAABB.max, Vector3Max(d, Vector3Zero()));
+    nodes[proxyId].aabb = fatAABB;
+
+    InsertLeaf(proxyId);
+    return true;
+}
+
+void SceneBroadphase::InsertLeaf(int leaf)
+{
+    if (root < 0)
+    {
+        root = leaf;
+        nodes[leaf].parent = -1;
+        return;
+    }
+
+    // Zejście do rodzeństwa o najmniejszym przyroście pola powierzchni (heurystyka SAH)
+    BoundingBox leafAABB = nodes[leaf].aabb;
+    int index = root;
+    while (!nodes[index].IsLeaf())
+    {
+        const TreeNode &node = nodes[index];
+        float area = Area(node.aabb);
+        float combinedArea = Area(Union(node.aabb, leafAABB));
+        float cost = 2.0f * combinedArea;
+        float inheritanceCost = 2.0f * (combinedArea - area);
+
+        float childCost[2];
+        int children[2] = {node.child1, node.child2};
+        for (int c = 0; c < 2; c++)
+        {
+            const TreeNode &child = nodes[children[c]];
+            float unionArea = Area(Union(leafAABB, child.aabb));
+            childCost[c] = (child.IsLeaf() ? unionArea : unionArea - Area(child.aabb)) + inheritanceCost;
+        }
+
+        if (cost < childCost[0] && cost < childCost[1])
+            break;
+        index = childCost[0] < childCost[1] ? children[0] : children[1];
+    }
+    int sibling = index;
+
+    int oldParent = nodes[sibling].parent;
+    int newParent = AllocateNode();
+    nodes[newParent].parent = oldParent;
+    nodes[newParent].aabb = Union(leafAABB, nodes[sibling].aabb);
+    nodes[newParent].height = nodes[sibling].height + 1;
+    nodes[newParent].child1 = sibling;
+    nodes[newParent].child2 = leaf;
+    nodes[sibling].parent = newParent;
+    nodes[leaf].parent = newParent;
+
+    if (oldParent >= 0)
+    {
+        if (nodes[oldParent].child1 == sibling)
+            nodes[oldParent].child1 = newParent;
+        else
+            nodes[oldParent].child2 = newParent;
+    }
+    else
+    {
+        root = newParent;
+    }
+
+    Refit(nodes[leaf].parent);
+}
+
+void SceneBroadphase::RemoveLeaf(int leaf)
+{
+    if (leaf == root)
+    {
+        root = -1;
+        return;
+    }
+
+    int parent = nodes[leaf].parent;
+    int grandParent = nodes[parent].parent;
+    int sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+    if (grandParent >= 0)
+    {
+        if (nodes[grandParent].child1 == parent)
+            nodes[grandParent].child1 = sibling;
+        else
+            nodes[grandParent].child2 = sibling;
+        nodes[sibling].parent = grandParent;
+        FreeNode(parent);
+        Refit(grandParent);
+    }
+    else
+    {
+        root = sibling;
+        nodes[sibling].parent = -1;
+        FreeNode(parent);
+    }
+}
+
+void SceneBroadphase::Refit(int index)
+{
+    // Od węzła do korzenia: rotacje wyważające, potem wysokość i AABB z dzieci
+    while (index >= 0)
+    {
+        index = Balance(index);
+        TreeNode &node = nodes[index];
+        node.height = 1 + std::max(nodes[node.child1].height, nodes[node.child2].height);
+        node.aabb = Union(nodes[node.child1].aabb, nodes[node.child2].aabb);
+        index = node.parent;
+    }
+}
+
+int SceneBroadphase::Balance(int iA)
+{
+    TreeNode &A = nodes[iA];
+    if (A.IsLeaf() || A.height < 2)
+        return iA;
+
+    int iB = A.child1;
+    int iC = A.child2;
+    TreeNode &B = nodes[iB];
+    TreeNode &C = nodes[iC];
+    int balance = C.height - B.height;
+
+    // Obrót w lewo: C idzie w górę
+    if (balance > 1)
+    {
+        int iF = C.child1;
+        int iG = C.child2;
+        TreeNode &F = nodes[iF];
+        TreeNode &G = nodes[iG];
+
+        C.child1 = iA;
+        C.parent = A.parent;
+        A.parent = iC;
+        if (C.parent >= 0)
+        {
+            if (nodes[C.parent].child1 == iA)
+                nodes[C.parent].child1 = iC;
+            else
+                nodes[C.parent].child2 = iC;
+        }
+        else
+        {
+            root = iC;
+        }
+
+        if (F.height > G.height)
+        {
+            C.child2 = iF;
+            A.child2 = iG;
+            G.parent = iA;
+            A.aabb = Union(B.aabb, G.aabb);
+            C.aabb = Union(A.aabb, F.aabb);
+            A.height = 1 + std::max(B.height, G.height);
+            C.height = 1 + std::max(A.height, F.height);
+        }
+        else
+        {
+            C.child2 = iG;
+            A.child2 = iF;
+            F.parent = iA;
+            A.aabb = Union(B.aabb, F.aabb);
+            C.aabb = Union(A.aabb, G.aabb);
+            A.height = 1 + std::max(B.height, F.height);
+            C.height = 1 + std::max(A.height, G.height);
+        }
+        return iC;
+    }
+
+    // Obrót w prawo: B idzie w górę
+    if (balance < -1)
+    {
+        int iD = B.child1;
+        int iE = B.child2;
+        TreeNode &D = nodes[iD];
+        TreeNode &E = nodes[iE];
+
+        B.child1 = iA;
+        B.parent = A.parent;
+        A.parent = iB;
+        if (B.parent >= 0)
+        {
+            if (nodes[B.parent].child1 == iA)
+                nodes[B.parent].child1 = iB;
+            else
+                nodes[B.parent].child2 = iB;
+        }
+        else
+        {
+            root = iB;
+        }
+
+        if (D.height > E.height)
+        {
+            B.child2 = iD;
+            A.child1 = iE;
+            E.parent = iA;
+            A.aabb = Union(C.aabb, E.aabb);
+            B.aabb = Union(A.aabb, D.aabb);
+            A.height = 1 + std::max(C.height, E.height);
+            B.height = 1 + std::max(A.height, D.height);
+        }
+        else
+        {
+            B.child2 = iE;
+            A.child1 = iD;
+            D.parent = iA;
+            A.aabb = Union(C.aabb, D.aabb);
+            B.aabb = Union(A.aabb, E.aabb);
+            A.height = 1 + std::max(C.height, D.height);
+            B.height = 1 + std::max(A.height, E.height);
+        }
+        return iB;
+    }
+
+    return iA;
+}
+
+void SceneBroadphase::QuerySphere(Vector3 center, float radius, std::vector<Object3D *> &out) const
+{
+    out.clear();
+    Vector3 r = {radius, radius, radius};
+    Query({Vector3Subtract(center, r), Vector3Add(center, r)}, [&](Object3D *object)
+          {
+              if (!object->markedForDeletion && CheckCollisionBoxSphere(object->GetWorldBounds(), center, radius))
+                  out.push_back(object);
+              return true; });
+}
+
+Object3D *SceneBroadphase::Raycast(Ray ray, float maxDistance, RayCollision *hit) const
+{
+    if (root < 0)
+        return nullptr;
+
+    Vector3 direction = Vector3Normalize(ray.direction);
+    Vector3 invDir = {1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z};
+    Object3D *closest = nullptr;
+    RayCollision best = {0};
+
+    std::vector<int> stack;
+    stack.reserve(64);
+    stack.push_back(root);
+    while (!stack.empty())
+    {
+        const TreeNode &node = nodes[stack.back()];
+        stack.pop_back();
+        if (!RayHitsBox(ray.position, invDir, node.aabb, maxDistance))
+            continue;
+
+        if (!node.IsLeaf())
+        {
+            stack.push_back(node.child1);
+            stack.push_back(node.child2);
+            continue;
+        }
+
+        // Zasięg skraca się do najbliższego trafienia - dalsze poddrzewa odpadają na AABB
+        if (node.object->markedForDeletion)
+            continue;
+        RayCollision collision = node.object->Raycast(ray, maxDistance);
+        if (collision.hit && collision.distance < maxDistance)
+        {
+            maxDistance = collision.distance;
+            best = collision;
+            closest = node.object;
+        }
+    }
+
+    if (hit)
+        *hit = best;
+    return closest;
+}
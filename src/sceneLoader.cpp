@@ -103,7 +103,11 @@ bool SceneLoader::SaveScene(const std::string& filename, const std::vector<Objec
 }
 
 bool SceneLoader::LoadScene(const std::string& filename, std::vector<Object3D*>& objects, Shader& shader) {
-    if (!LoadSceneFile(filename)) {
+    return LoadSceneFromPath(scenesPath + "/" + filename + ".scn", objects, shader);
+}
+
+bool SceneLoader::LoadSceneFromPath(const std::string& filepath, std::vector<Object3D*>& objects, Shader& shader) {
+    if (!LoadSceneFile(filepath)) {
         return false;
     }
     
@@ -111,8 +115,7 @@ bool SceneLoader::LoadScene(const std::string& filename, std::vector<Object3D*>&
     return true;
 }
 
-bool SceneLoader::LoadSceneFile(const std::string& filename) {
-    std::string filepath = scenesPath + "/" + filename + ".scn";
+bool SceneLoader::LoadSceneFile(const std::string& filepath) {
     std::ifstream file(filepath);
     
     if (!file.is_open()) {
@@ -150,10 +153,10 @@ bool SceneLoader::LoadSceneFile(const std::string& filename) {
 }
 
 void SceneLoader::UpdateObjects(std::vector<Object3D*>& objects, Shader& shader) {
-    for (auto* obj : objects) {
-        delete obj;
-    }
-    objects.clear();
+    // Nowe obiekty powstają przed usunięciem starych, żeby modele wspólne
+    // dla obu scen zostały w ModelCache zamiast być zwalniane i wczytywane ponownie
+    std::vector<Object3D*> previous;
+    previous.swap(objects);
     
     for (const auto& objData : currentScene.objects) {
         Object3D* obj = Object3D::Create(objData.modelPath.c_str(), shader);
@@ -162,6 +165,10 @@ void SceneLoader::UpdateObjects(std::vector<Object3D*>& objects, Shader& shader)
         obj->SetScale(objData.scale);
         objects.push_back(obj);
     }
+
+    for (auto* obj : previous) {
+        delete obj;
+    }
 }
 
 void SceneLoader::DeleteScene(const std::string& filename) {
@@ -0,0 +1,55 @@
+#include "simulationClock.h"
+#include <algorithm>
+#include <cmath>
+
+SimulationClock::SimulationClock(float stepRate)
+{
+    SetStepRate(stepRate);
+}
+
+void SimulationClock::SetStepRate(float rate)
+{
+    step = 1.0f / std::max(rate, 1.0f);
+    accumulator = 0.0;
+}
+
+int SimulationClock::Advance(float frameTime)
+{
+    if (frameTime > MAX_FRAME_TIME)
+    {
+        droppedTime += frameTime - MAX_FRAME_TIME;
+        frameTime = MAX_FRAME_TIME;
+    }
+    accumulator += std::max(frameTime, 0.0f);
+
+    int steps = (int)(accumulator / step);
+    accumulator -= steps * (double)step;
+    simTime += steps * (double)step;
+    stepCount += steps;
+    lastFrameSteps = steps;
+    return steps;
+}
+
+void SimulationClock::DrawImGuiControls()
+{
+    if (ImGui::CollapsingHeader("Zegar symulacji"))
+    {
+        static const float RATES[] = {100.0f, 250.0f, 500.0f, 1000.0f, 2000.0f};
+        static const char *RATE_NAMES[] = {"100 Hz", "250 Hz", "500 Hz", "1 kHz", "2 kHz"};
+        int current = 0;
+        for (int i = 0; i < IM_ARRAYSIZE(RATES); i++)
+        {
+            if (fabsf(RATES[i] - GetStepRate()) < 0.5f)
+                current = i;
+        }
+        if (ImGui::Combo("Częstotliwość kroku", &current, RATE_NAMES, IM_ARRAYSIZE(RATE_NAMES)))
+        {
+            SetStepRate(RATES[current]);
+        }
+        ImGui::Checkbox("Interpolacja renderowania", &interpolate);
+
+        ImGui::Text("Czas symulacji: %.3f s (%lld kroków)", simTime, stepCount);
+        ImGui::Text("Kroki w ostatniej klatce: %d", lastFrameSteps);
+        ImGui::Text("Pominięty czas (zbyt długie klatki): %.3f s", droppedTime);
+    }
+}
@@ -0,0 +1,118 @@
+#include "skinnedModel.h"
+#include "modelCache.h"
+#include "modelLoader.h"
+#include "rlgl.h"
+#include <algorithm>
+#include <cstring>
+
+static constexpr int MAX_BATCH_VERTICES = 65535; // indeksy Mesh są 16-bitowe
+
+// Ogniwa [first, last) poziomu level w jednej siatce z indeksem ogniwa na wierzchołek
+static SkinnedModel::Batch MergeLinks(const ModelAsset &asset, int level, int first, int last, int location)
+{
+    int vertexCount = 0, triangleCount = 0;
+    for (int link = first; link < last; link++)
+    {
+        const Mesh &source = asset.lod.GetMesh(asset.model, level, link);
+        vertexCount += source.vertexCount;
+        triangleCount += source.triangleCount;
+    }
+
+    SkinnedModel::Batch batch;
+    Mesh &mesh = batch.mesh;
+    mesh.vertexCount = vertexCount;
+    mesh.triangleCount = triangleCount;
+    mesh.vertices = (float *)MemAlloc(vertexCount * 3 * sizeof(float));
+    mesh.normals = (float *)MemAlloc(vertexCount * 3 * sizeof(float));
+    mesh.indices = (unsigned short *)MemAlloc(triangleCount * 3 * sizeof(unsigned short));
+    std::vector<float> links(vertexCount);
+
+    int vertexOffset = 0, indexOffset = 0;
+    for (int link = first; link < last; link++)
+    {
+        const Mesh &source = asset.lod.GetMesh(asset.model, level, link);
+        memcpy(&mesh.vertices[vertexOffset * 3], source.vertices, source.vertexCount * 3 * sizeof(float));
+        if (source.normals)
+            memcpy(&mesh.normals[vertexOffset * 3], source.normals, source.vertexCount * 3 * sizeof(float));
+        for (int i = 0; i < source.triangleCount * 3; i++)
+        {
+            int index = source.indices ? source.indices[i] : i;
+            mesh.indices[indexOffset + i] = (unsigned short)(index + vertexOffset);
+        }
+        std::fill(links.begin() + vertexOffset, links.begin() + vertexOffset + source.vertexCount, (float)link);
+        vertexOffset += source.vertexCount;
+        indexOffset += source.triangleCount * 3;
+    }
+
+    // Bufor indeksów ogniw dopięty na stałe do VAO scalonej siatki
+    UploadMesh(&mesh, false);
+    rlEnableVertexArray(mesh.vaoId);
+    batch.linkVboId = rlLoadVertexBuffer(links.data(), vertexCount * (int)sizeof(float), false);
+    rlSetVertexAttribute(location, 1, RL_FLOAT, false, 0, 0);
+    rlEnableVertexAttribute(location);
+    rlDisableVertexArray();
+    return batch;
+}
+
+bool SkinnedModel::Build(const ModelAsset &asset, Shader shader)
+{
+    Unload();
+    const Model &model = asset.model;
+    // Bez kontekstu GL nie wolno pytać shadera o atrybuty
+    if (ModelLoader::IsHeadless() || model.meshCount == 0 || model.meshCount > MAX_LINKS)
+        return false;
+    int location = GetShaderLocationAttrib(shader, "vertexLink");
+    if (location < 0)
+        return false;
+
+    for (int level = 0; level < asset.lod.GetLevelCount(); level++)
+    {
+        levels.emplace_back();
+        int first = 0;
+        while (first < model.meshCount)
+        {
+            // Kolejne ogniwa, dopóki wierzchołki mieszczą się w 16-bitowych indeksach
+            int last = first, vertexCount = 0;
+            while (last < model.meshCount)
+            {
+                int count = asset.lod.GetMesh(model, level, last).vertexCount;
+                if (vertexCount + count > MAX_BATCH_VERTICES)
+                    break;
+                vertexCount += count;
+                last++;
+            }
+            if (last == first)
+            {
+                TraceLog(LOG_WARNING, "SKINNING: Ogniwo %d ma za dużo wierzchołków - rysowanie ogniwami", first);
+                Unload();
+                return false;
+            }
+            levels.back().push_back(MergeLinks(asset, level, first, last, location));
+            first = last;
+        }
+    }
+
+    TraceLog(LOG_INFO, "SKINNING: %d ogniw, %d poziomów, %d paczek na poziomie 0", model.meshCount,
+             (int)levels.size(), (int)levels.front().size());
+    return true;
+}
+
+void SkinnedModel::Unload()
+{
+    for (auto &batches : levels)
+    {
+        for (Batch &batch : batches)
+        {
+            rlUnloadVertexBuffer(batch.linkVboId);
+            UnloadMesh(batch.mesh);
+        }
+    }
+    levels.clear();
+}
+
+void SkinnedModel::PackLinkMatrix(Matrix transform, Vector4 *rows)
+{
+    rows[0] = {transform.m0, transform.m4, transform.m8, transform.m12};
+    rows[1] = {transform.m1, transform.m5, transform.m9, transform.m13};
+    rows[2] = {transform.m2, transform.m6, transform.m10, transform.m14};
+}
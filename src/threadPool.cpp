@@ -0,0 +1,101 @@
+#include "threadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+ThreadPool::ThreadPool()
+{
+    // Jeden rdzeń zostaje dla wątku głównego, który też bierze udział w ParallelFor
+    int count = std::max(1, (int)std::thread::hardware_concurrency() - 1);
+    for (int i = 0; i < count; i++)
+    {
+        workers.emplace_back(&ThreadPool::WorkerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    condition.notify_all();
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+}
+
+void ThreadPool::WorkerLoop()
+{
+    while (true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this] { return stopping || !tasks.empty(); });
+            if (stopping && tasks.empty())
+                return;
+            task = std::move(tasks.front());
+            tasks.pop();
+        }
+        task();
+    }
+}
+
+void ThreadPool::ParallelFor(int count, const std::function<void(int begin, int end)> &body, int minChunk)
+{
+    if (count <= 0)
+        return;
+
+    // Kilka porcji na wątek wyrównuje obciążenie przy nierównym koszcie zadań
+    int threads = (int)workers.size() + 1;
+    int chunk = std::max(minChunk, (count + threads * 4 - 1) / (threads * 4));
+    int chunkCount = (count + chunk - 1) / chunk;
+    if (chunkCount == 1)
+    {
+        body(0, count);
+        return;
+    }
+
+    // Stan współdzielony przez shared_ptr: zadanie pomocnicze, które wystartuje
+    // po zakończeniu pętli, nie znajdzie już porcji i nie dotknie body
+    struct State
+    {
+        std::atomic<int> next{0};
+        std::atomic<int> remaining{0};
+        std::mutex mutex;
+        std::condition_variable done;
+    };
+    auto state = std::make_shared<State>();
+    state->remaining = chunkCount;
+    const auto *bodyPtr = &body;
+
+    auto runChunks = [state, bodyPtr, chunk, chunkCount, count]()
+    {
+        int index;
+        while ((index = state->next.fetch_add(1)) < chunkCount)
+        {
+            int begin = index * chunk;
+            (*bodyPtr)(begin, std::min(count, begin + chunk));
+            if (state->remaining.fetch_sub(1) == 1)
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->done.notify_one();
+            }
+        }
+    };
+
+    int helpers = std::min((int)workers.size(), chunkCount - 1);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (int i = 0; i < helpers; i++)
+            tasks.push(runChunks);
+    }
+    condition.notify_all();
+
+    runChunks();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->done.wait(lock, [&] { return state->remaining.load() == 0; });
+}
@@ -0,0 +1,292 @@
+#include "timedTrajectory.h"
+#include "robotKinematics.h"
+#include <algorithm>
+#include <cmath>
+
+void TimedTrajectory::Clear()
+{
+    jointCount = 0;
+    duration = 0.0f;
+    lut.clear();
+}
+
+void TimedTrajectory::ResizeLUT(float newDuration, int joints)
+{
+    jointCount = joints;
+    duration = newDuration;
+    int samples = std::max(2, (int)ceilf(duration * SAMPLE_RATE) + 1);
+    lut.assign(samples * jointCount, 0.0f);
+}
+
+void TimedTrajectory::Sample(float time, float *outAngles) const
+{
+    if (lut.empty())
+        return;
+
+    const int samples = (int)lut.size() / jointCount;
+    float f = Clamp(time, 0.0f, duration) * SAMPLE_RATE;
+    int i = (int)f;
+    if (i >= samples - 1)
+    {
+        std::copy(lut.end() - jointCount, lut.end(), outAngles);
+        return;
+    }
+
+    f -= i;
+    const float *a = &lut[i * jointCount];
+    const float *b = a + jointCount;
+    for (int j = 0; j < jointCount; j++)
+        outAngles[j] = a[j] + (b[j] - a[j]) * f;
+}
+
+void TimedTrajectory::GetPeakVelocities(float from, float to, float *outVelocities) const
+{
+    std::fill(outVelocities, outVelocities + jointCount, 0.0f);
+    if (lut.empty())
+        return;
+
+    const int samples = (int)lut.size() / jointCount;
+    int first = std::max(0, (int)(Clamp(from, 0.0f, duration) * SAMPLE_RATE));
+    int last = std::min(samples - 1, (int)ceilf(Clamp(to, 0.0f, duration) * SAMPLE_RATE));
+    for (int i = first; i < last; i++)
+    {
+        const float *a = &lut[i * jointCount];
+        const float *b = a + jointCount;
+        for (int j = 0; j < jointCount; j++)
+            outVelocities[j] = std::max(outVelocities[j], fabsf(b[j] - a[j]) * SAMPLE_RATE);
+    }
+}
+
+void TimedTrajectory::BuildPointToPoint(const float *start, const float *goal, int joints,
+                                        const std::vector<JointLimit> &limits)
+{
+    // Najkrótszy czas ruchu wyznacza najwolniejszy przegub
+    float totalTime = 0.0f;
+    for (int j = 0; j < joints; j++)
+    {
+        float distance = fabsf(goal[j] - start[j]);
+        float v = limits[j].maxVelocity;
+        float a = limits[j].maxAcceleration;
+        float jointTime = (distance >= v * v / a) ? distance / v + v / a : 2.0f * sqrtf(distance / a);
+        totalTime = std::max(totalTime, jointTime);
+    }
+
+    ResizeLUT(totalTime, joints);
+    const int samples = (int)lut.size() / jointCount;
+
+    for (int j = 0; j < joints; j++)
+    {
+        float delta = goal[j] - start[j];
+        float distance = fabsf(delta);
+        float sign = delta < 0.0f ? -1.0f : 1.0f;
+        float a = limits[j].maxAcceleration;
+
+        // Trapez o zadanym czasie trwania i pełnym przyspieszeniu:
+        // v = (aT - sqrt(a^2 T^2 - 4 a d)) / 2, zawsze v <= maxVelocity dla T >= T_j
+        float disc = std::max(0.0f, a * a * totalTime * totalTime - 4.0f * a * distance);
+        float v = (a * totalTime - sqrtf(disc)) * 0.5f;
+        float accelTime = (a > 0.0f) ? v / a : 0.0f;
+
+        for (int n = 0; n < samples; n++)
+        {
+            float t = std::min(n / SAMPLE_RATE, totalTime);
+            float s;
+            if (distance <= 0.0f)
+                s = 0.0f;
+            else if (t < accelTime)
+                s = 0.5f * a * t * t;
+            else if (t < totalTime - accelTime)
+                s = 0.5f * a * accelTime * accelTime + v * (t - accelTime);
+            else
+                s = distance - 0.5f * a * (totalTime - t) * (totalTime - t);
+
+            lut[n * jointCount + j] = start[j] + sign * Clamp(s, 0.0f, distance);
+        }
+    }
+}
+
+namespace
+{
+    // Zawęża zakres dopuszczalnego przyspieszenia ścieżkowego u = s'' przy x = s'^2
+    // do |(q'_j + stepFactor q''_j) u + q''_j x| <= maxAcceleration_j dla każdego przegubu.
+    // stepFactor = 2h sprawdza ograniczenie na końcu komórki, gdzie x' = x + 2hu.
+    bool IntersectAccelerationRange(const float *dq, const float *ddq, float stepFactor, int joints,
+                                    const std::vector<JointLimit> &limits, float x,
+                                    float &lo, float &hi)
+    {
+        for (int j = 0; j < joints; j++)
+        {
+            float amax = limits[j].maxAcceleration;
+            float a = dq[j] + stepFactor * ddq[j];
+            float b = ddq[j] * x;
+            if (fabsf(a) > 1e-6f)
+            {
+                float u1 = (-amax - b) / a;
+                float u2 = (amax - b) / a;
+                lo = std::max(lo, std::min(u1, u2));
+                hi = std::min(hi, std::max(u1, u2));
+            }
+            else if (fabsf(b) > amax)
+            {
+                return false;
+            }
+        }
+        return lo <= hi;
+    }
+}
+
+bool TimedTrajectory::BuildFromPath(const std::vector<float> &waypoints, int joints,
+                                    const std::vector<JointLimit> &limits)
+{
+    const int N = (int)waypoints.size() / joints;
+    if (N < 2)
+        return false;
+
+    auto q = [&](int k, int j) { return waypoints[std::clamp(k, 0, N - 1) * joints + j]; };
+
+    // Ścieżka q(s) to splajn Catmulla-Roma przez waypointy, s w [0, N - 1].
+    // Zwraca q, dq/ds i d2q/ds2 dla przegubu j w segmencie k (domyślnie zawierającym s).
+    // Splajn jest tylko klasy C1 - d2q/ds2 w waypoincie zależy od segmentu.
+    auto evaluateSegment = [&](float s, int k, int j, float &value, float &d1, float &d2)
+    {
+        float f = s - k;
+        float p0 = q(k - 1, j), p1 = q(k, j), p2 = q(k + 1, j), p3 = q(k + 2, j);
+        float c1 = p2 - p0;
+        float c2 = 2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3;
+        float c3 = 3.0f * p1 - p0 - 3.0f * p2 + p3;
+        value = 0.5f * (2.0f * p1 + c1 * f + c2 * f * f + c3 * f * f * f);
+        d1 = 0.5f * (c1 + 2.0f * c2 * f + 3.0f * c3 * f * f);
+        d2 = 0.5f * (2.0f * c2 + 6.0f * c3 * f);
+    };
+    auto evaluate = [&](float s, int j, float &value, float &d1, float &d2)
+    {
+        evaluateSegment(s, std::min((int)s, N - 2), j, value, d1, d2);
+    };
+
+    // Siatka TOPP gęstsza niż waypointy, by ograniczenia między nimi też były pilnowane
+    const int SUBDIVISIONS = 16;
+    const int M = (N - 1) * SUBDIVISIONS + 1;
+    const float h = 1.0f / SUBDIVISIONS;
+
+    // dq, ddq - pochodne na początku komórki i; dqEnd, ddqEnd - na końcu komórki i,
+    // liczone z jej segmentu (przy waypoincie różne od ddq[i + 1] z następnego segmentu)
+    std::vector<float> dq(M * joints), ddq(M * joints), dqEnd(M * joints), ddqEnd(M * joints);
+    float maxDerivative = 0.0f;
+    for (int i = 0; i < M; i++)
+    {
+        int segment = std::min(i / SUBDIVISIONS, N - 2);
+        for (int j = 0; j < joints; j++)
+        {
+            float value;
+            evaluate(i * h, j, value, dq[i * joints + j], ddq[i * joints + j]);
+            evaluateSegment((i + 1) * h, segment, j, value, dqEnd[i * joints + j], ddqEnd[i * joints + j]);
+            maxDerivative = std::max(maxDerivative, fabsf(dq[i * joints + j]));
+        }
+    }
+
+    if (maxDerivative < 1e-6f)
+    {
+        // Ścieżka bez ruchu
+        ResizeLUT(0.0f, joints);
+        for (size_t n = 0; n < lut.size(); n += joints)
+            std::copy(waypoints.begin(), waypoints.begin() + joints, lut.begin() + n);
+        return true;
+    }
+
+    // Górne ograniczenie x = s'^2 z limitów prędkości przegubów
+    std::vector<float> velocityLimit(M, INFINITY);
+    for (int i = 0; i < M; i++)
+    {
+        for (int j = 0; j < joints; j++)
+        {
+            float d = fabsf(dq[i * joints + j]);
+            if (d > 1e-6f)
+            {
+                float v = limits[j].maxVelocity / d;
+                velocityLimit[i] = std::min(velocityLimit[i], v * v);
+            }
+        }
+    }
+
+    // Przyspieszenie u jest stałe w komórce [s_i, s_i+1]; limity muszą być spełnione na obu jej końcach
+    auto CellAccelerationRange = [&](int i, float x, float &lo, float &hi)
+    {
+        lo = -INFINITY;
+        hi = INFINITY;
+        return IntersectAccelerationRange(&dq[i * joints], &ddq[i * joints], 0.0f, joints, limits, x, lo, hi) &&
+               IntersectAccelerationRange(&dqEnd[i * joints], &ddqEnd[i * joints], 2.0f * h, joints, limits, x, lo, hi);
+    };
+
+    // Przebieg wsteczny: największe x_i, z którego da się jeszcze wyhamować do końca ścieżki
+    std::vector<float> controllable(M, 0.0f);
+    for (int i = M - 2; i >= 0; i--)
+    {
+        auto feasible = [&](float x)
+        {
+            float lo, hi;
+            if (!CellAccelerationRange(i, x, lo, hi))
+                return false;
+            return x + 2.0f * h * lo <= controllable[i + 1] && x + 2.0f * h * hi >= 0.0f;
+        };
+
+        float upper = std::min(velocityLimit[i], 1e8f);
+        if (feasible(upper))
+        {
+            controllable[i] = upper;
+            continue;
+        }
+        float lower = 0.0f;
+        for (int it = 0; it < 40; it++)
+        {
+            float mid = 0.5f * (lower + upper);
+            (feasible(mid) ? lower : upper) = mid;
+        }
+        controllable[i] = lower;
+    }
+
+    // Przebieg w przód: maksymalne przyspieszenie, które nie opuszcza zbioru sterowalnego
+    std::vector<float> x(M, 0.0f), times(M, 0.0f);
+    for (int i = 0; i < M - 1; i++)
+    {
+        float lo, hi;
+        float u = (controllable[i + 1] - x[i]) / (2.0f * h);
+        // x[i] <= controllable[i], więc zakres jest niepusty i sięga zbioru sterowalnego;
+        // margines pokrywa tylko błąd bisekcji w przebiegu wstecznym
+        float tolerance = 1e-4f * std::max(1.0f, fabsf(u));
+        if (!CellAccelerationRange(i, x[i], lo, hi) || lo > u + tolerance)
+        {
+            Clear();
+            return false;
+        }
+        u = Clamp(u, lo, hi);
+        x[i + 1] = std::max(0.0f, x[i] + 2.0f * h * u);
+
+        float speedSum = sqrtf(x[i]) + sqrtf(x[i + 1]);
+        times[i + 1] = times[i] + 2.0f * h / std::max(speedSum, 1e-3f);
+    }
+
+    ResizeLUT(times[M - 1], joints);
+    const int samples = (int)lut.size() / jointCount;
+
+    int i = 0;
+    for (int n = 0; n < samples; n++)
+    {
+        float t = std::min(n / SAMPLE_RATE, duration);
+        while (i < M - 2 && times[i + 1] <= t)
+            i++;
+
+        // W komórce siatki u jest stałe: s = s_i + s'_i tau + u tau^2 / 2
+        float tau = t - times[i];
+        float u = (x[i + 1] - x[i]) / (2.0f * h);
+        float s = i * h + Clamp(sqrtf(x[i]) * tau + 0.5f * u * tau * tau, 0.0f, h);
+        if (n == samples - 1)
+            s = (float)(N - 1);
+
+        for (int j = 0; j < joints; j++)
+        {
+            float d1, d2;
+            evaluate(s, j, lut[n * jointCount + j], d1, d2);
+        }
+    }
+    return true;
+}
@@ -0,0 +1,163 @@
+#include "trajectoryValidation.h"
+#include "robotKinematics.h"
+#include "threadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <chrono>
+
+static constexpr float SEGMENT_DURATION = 0.1f;    // [s] porcja trajektorii na zadanie puli
+static constexpr float QUERY_MARGIN = 0.25f;       // [jednostki świata] zasięg zapytań odległości
+static constexpr float CONTACT_TOLERANCE = 0.002f; // odstęp uznawany za kontakt
+
+// reach[link * n + joint]: górne ograniczenie odległości punktów kapsuł ogniwa
+// od pivota przegubu joint <= link, niezależne od pozy - suma odcinków między
+// kolejnymi pivotami (stałych, bo ramki są sztywne) i zasięgu kapsuł od pivota ogniwa
+static std::vector<float> ComputeLinkReach(const RobotDescription &description, const LinkCollisionModel &collision)
+{
+    const int n = description.GetJointCount();
+    std::vector<float> extent(n, 0.0f);
+    for (const Capsule &capsule : collision.GetLocalCapsules())
+    {
+        Vector3 pivot = description.joints[capsule.link].pivot;
+        float farthest = fmaxf(Vector3Distance(capsule.a, pivot), Vector3Distance(capsule.b, pivot));
+        extent[capsule.link] = fmaxf(extent[capsule.link], farthest + capsule.radius);
+    }
+
+    std::vector<float> reach(n * n, 0.0f);
+    for (int link = 0; link < n; link++)
+    {
+        float r = extent[link];
+        for (int joint = link; joint >= 0; joint--)
+        {
+            reach[link * n + joint] = r;
+            if (joint > 0)
+                r += Vector3Distance(description.joints[joint - 1].pivot, description.joints[joint].pivot);
+        }
+    }
+    return reach;
+}
+
+namespace
+{
+struct SegmentResult
+{
+    bool hit = false;
+    float time = 0.0f;
+    LinkContact contact{};
+    int steps = 0;
+};
+}
+
+TrajectoryValidation ValidateTrajectory(const RobotKinematics &kinematics, const LinkCollisionModel &collision,
+                                        const TimedTrajectory &trajectory, const Object3D *attached)
+{
+    TrajectoryValidation result;
+    if (trajectory.IsEmpty())
+        return result;
+
+    auto start = std::chrono::steady_clock::now();
+    const RobotDescription &description = kinematics.GetDescription();
+    const int n = std::min(kinematics.GetMeshCount(), trajectory.GetJointCount());
+    const float scale = kinematics.GetScale();
+    const float duration = trajectory.GetDuration();
+    const std::vector<float> reach = ComputeLinkReach(description, collision);
+
+    const int segmentCount = std::max(1, (int)ceilf(duration / SEGMENT_DURATION));
+    std::vector<SegmentResult> segments(segmentCount);
+    std::atomic<int> firstHit{segmentCount};
+
+    ThreadPool::GetInstance().ParallelFor(segmentCount, [&](int begin, int end)
+    {
+        // Własne kapsuły świata i bufory par dla wątku
+        LinkCollisionModel probe = collision;
+        std::vector<float> angles(trajectory.GetJointCount()), velocities(trajectory.GetJointCount()), linkSpeed(n);
+        std::vector<ArmRotation> rotations(kinematics.GetMeshCount());
+        std::vector<Matrix> frames(kinematics.GetMeshCount(), MatrixIdentity());
+        std::vector<LinkContact> contacts;
+        for (int i = 0; i < (int)rotations.size(); i++)
+            rotations[i] = {0.0f, description.joints[i].axis};
+
+        // Porcje za najwcześniejszym znalezionym kontaktem nie zmienią wyniku
+        for (int s = begin; s < end && s < firstHit.load(std::memory_order_relaxed); s++)
+        {
+            float t = s * SEGMENT_DURATION;
+            float segmentEnd = fminf(duration, t + SEGMENT_DURATION);
+
+            // Prędkość punktów ogniwa <= suma po przegubach poprzedzających: omega * zasięg
+            trajectory.GetPeakVelocities(t, segmentEnd, velocities.data());
+            float maxSpeed = 0.0f;
+            for (int link = 0; link < n; link++)
+            {
+                float speed = 0.0f;
+                for (int joint = 0; joint <= link; joint++)
+                    speed += velocities[joint] * DEG2RAD * reach[link * n + joint];
+                linkSpeed[link] = fmaxf(speed * scale, 1e-6f);
+                maxSpeed = fmaxf(maxSpeed, linkSpeed[link]);
+            }
+
+            SegmentResult &out = segments[s];
+            while (true)
+            {
+                trajectory.Sample(t, angles.data());
+                for (int i = 0; i < n; i++)
+                    rotations[i].angle = angles[i];
+                kinematics.ComputeJointTransforms(rotations.data(), 0, frames.data());
+                probe.UpdatePose(frames.data(), scale);
+
+                contacts.clear();
+                probe.CheckSelf(QUERY_MARGIN, contacts);
+                probe.CheckScene(QUERY_MARGIN, attached, -1, contacts);
+                out.steps++;
+
+                // Poza marginesem przeszkoda jest co najmniej QUERY_MARGIN dalej,
+                // a drugie ogniwo może poruszać się z prędkością maxSpeed
+                float step = FLT_MAX;
+                for (int link = 0; link < n; link++)
+                    step = fminf(step, QUERY_MARGIN / (linkSpeed[link] + maxSpeed));
+
+                const LinkContact *closest = nullptr;
+                for (const LinkContact &contact : contacts)
+                {
+                    if (contact.distance <= CONTACT_TOLERANCE)
+                    {
+                        if (!closest || contact.distance < closest->distance)
+                            closest = &contact;
+                        continue;
+                    }
+                    float speed = linkSpeed[contact.link];
+                    if (contact.type != LinkContactType::SCENE)
+                        speed += linkSpeed[contact.otherLink];
+                    step = fminf(step, contact.distance / speed);
+                }
+
+                if (closest)
+                {
+                    out.hit = true;
+                    out.time = t;
+                    out.contact = *closest;
+                    int expected = firstHit.load();
+                    while (s < expected && !firstHit.compare_exchange_weak(expected, s))
+                    {
+                    }
+                    break;
+                }
+                if (t >= segmentEnd)
+                    break;
+                t = fminf(t + step, segmentEnd);
+            }
+        }
+    });
+
+    for (const SegmentResult &segment : segments)
+        result.steps += segment.steps;
+    if (firstHit.load() < segmentCount)
+    {
+        const SegmentResult &segment = segments[firstHit.load()];
+        result.collisionFree = false;
+        result.contactTime = segment.time;
+        result.contact = segment.contact;
+    }
+    result.elapsedMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
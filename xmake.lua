@@ -3,12 +3,20 @@ add_requires("raylib", "nlohmann_json", "lua")
 add_requires("imgui docking", {configs = {glfw = true, opengl3 = true, docking = true}})
 add_rules("plugin.compile_commands.autoupdate", {outputdir = ".vscode"})
 set_languages("c++20")
+option("avx")
+    set_default(false)
+    set_showmenu(true)
+    set_description("Enable AVX (8-lane) batch kinematics kernels")
+option_end()
 target("robolab")
     set_policy("run.autobuild", true)
     set_kind("binary")
     add_files("src/*.cpp")
     add_includedirs("include")
     add_packages("raylib","imgui docking", "imgui", "nlohmann_json", "lua")
+    if has_config("avx") then
+        add_vectorexts("avx")
+    end
     after_build(function (target)
         local targetdir = target:targetdir()
         os.cp("$(projectdir)/assets",targetdir)